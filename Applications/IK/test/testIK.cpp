@@ -75,9 +75,11 @@ int main()
     }
 
     Storage  standard("std_subject01_walk1_ik.mot");
+    std::string sequentialMotionFile;
     try {
         InverseKinematicsTool ik1("subject01_Setup_InverseKinematics.xml");
         ik1.run();
+        sequentialMotionFile = ik1.getOutputMotionFileName();
         Storage result1(ik1.getOutputMotionFileName());
         CHECK_STORAGE_AGAINST_STANDARD(result1, standard, 
             std::vector<double>(24, 0.2), __FILE__, __LINE__, 
@@ -89,6 +91,35 @@ int main()
         failures.push_back("testInverseKinematicsGait2354");
     }
 
+    try {
+        // Solve the frames in chunks on multiple threads.
+        InverseKinematicsTool ikParallel(
+                "subject01_Setup_InverseKinematics.xml");
+        ikParallel.setNumThreads(4);
+        ikParallel.setOutputMotionFileName(
+                "subject01_walk1_ik_parallel.mot");
+        ikParallel.run();
+        Storage resultParallel(ikParallel.getOutputMotionFileName());
+        CHECK_STORAGE_AGAINST_STANDARD(resultParallel, standard,
+            std::vector<double>(24, 0.2), __FILE__, __LINE__,
+            "testInverseKinematicsGait2354 in parallel failed");
+        // Only the first frame of each chunk is solved without a warm start,
+        // so the coordinates must match those of the sequential solve to
+        // within the accuracy of the solver.
+        Storage resultSequential(sequentialMotionFile);
+        CHECK_STORAGE_AGAINST_STANDARD(resultParallel, resultSequential,
+            std::vector<double>(
+                    resultParallel.getColumnLabels().getSize(), 1e-2),
+            __FILE__, __LINE__,
+            "testInverseKinematicsGait2354 in parallel differs from the "
+            "sequential solve");
+        cout << "testInverseKinematicsGait2354 in parallel passed" << endl;
+    }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testInverseKinematicsGait2354_parallel");
+    }
+
     try {
         InverseKinematicsTool ik2("subject01_Setup_InverseKinematics_NoModel.xml");
         Model mdl("subject01_simbody.osim");
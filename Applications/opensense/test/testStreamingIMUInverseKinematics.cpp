@@ -0,0 +1,118 @@
+/* -------------------------------------------------------------------------- *
+ *              OpenSim:  testStreamingIMUInverseKinematics.cpp               *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// INCLUDES
+#include <OpenSim/Common/STOFileAdapter.h>
+#include <OpenSim/Simulation/OpenSense/OpenSenseUtilities.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Tools/IMUInverseKinematicsTool.h>
+#include <OpenSim/Tools/StreamingIMUInverseKinematics.h>
+#include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+
+using namespace OpenSim;
+using namespace std;
+
+const std::string orientationsFile =
+        "MT_012005D6_009-quaternions_RHJCSwinger.sto";
+const SimTK::Vec3 sensorToOpenSim(-SimTK::Pi / 2, 0, 0);
+
+TimeSeriesTable_<SimTK::Rotation> loadOrientations(
+        double startTime, double endTime) {
+    TimeSeriesTable_<SimTK::Quaternion> quatTable(orientationsFile);
+    quatTable.trim(startTime, endTime);
+    return OpenSenseUtilities::convertQuaternionsToRotations(quatTable);
+}
+
+// Streaming the orientations of a file must give the same result as
+// IMUInverseKinematicsTool.
+void testStreamingMatchesTool(const std::string& modelFile) {
+    Model toolModel(modelFile);
+    IMUInverseKinematicsTool ikTool;
+    ikTool.setModel(toolModel);
+    ikTool.set_orientations_file(orientationsFile);
+    ikTool.set_sensor_to_opensim_rotations(sensorToOpenSim);
+    ikTool.setStartTime(417);
+    ikTool.setEndTime(418);
+    ikTool.set_results_directory("streaming_ik");
+    ikTool.set_output_motion_file("tool_ik.mot");
+    ikTool.run(false);
+    const TimeSeriesTable standard("streaming_ik/tool_ik.mot");
+
+    Model model(modelFile);
+    StreamingIMUInverseKinematics streamingIK(model);
+    streamingIK.setSensorToOpenSimRotations(sensorToOpenSim);
+    TableOrientationsSource source(loadOrientations(417, 418));
+    TableCoordinatesSink sink;
+    const auto stats = streamingIK.run(source, sink);
+
+    TimeSeriesTable result = sink.getTable();
+    ASSERT(stats.numFrames == (int)result.getNumRows());
+    ASSERT(result.getNumRows() == standard.getNumRows());
+    ASSERT_EQUAL(result.getIndependentColumn().back(),
+            standard.getIndependentColumn().back(), 1e-12);
+    ASSERT(stats.medianLatency <= stats.p99Latency);
+    ASSERT(stats.p99Latency <= stats.maxLatency);
+
+    model.initSystem();
+    model.getSimbodyEngine().convertRadiansToDegrees(result);
+    const size_t nt = result.getNumRows();
+    for (const auto& label : result.getColumnLabels()) {
+        const auto error = result.getDependentColumn(label) -
+                           standard.getDependentColumn(label);
+        const double rmse = sqrt(error.normSqr() / nt);
+        cout << "Column '" << label << "' has RMSE = " << rmse << " degrees"
+             << endl;
+        SimTK_ASSERT1_ALWAYS(rmse < 0.1,
+                "Column '%s' FAILED to meet accuracy of 0.1 degree RMS.",
+                label.c_str());
+    }
+}
+
+// Replay in real time, and stop early.
+void testRealTimeReplay(const std::string& modelFile) {
+    StreamingIMUInverseKinematics streamingIK(Model(modelFile));
+    streamingIK.setSensorToOpenSimRotations(sensorToOpenSim);
+    streamingIK.setLatencyBudget(0.01);
+    // 0.25 s of data at 100 Hz, replayed at twice the speed.
+    TableOrientationsSource source(loadOrientations(417, 417.245), true, 2.0);
+    TableCoordinatesSink sink;
+    const auto stats = streamingIK.run(source, sink, 10);
+    ASSERT(stats.numFrames == 10);
+    ASSERT(sink.getTable().getNumRows() == 10);
+    ASSERT(stats.numLateFrames <= stats.numFrames);
+    cout << "Real-time replay latency: median " << stats.medianLatency
+         << " s, 99th percentile " << stats.p99Latency << " s, max "
+         << stats.maxLatency << " s, " << stats.numLateFrames
+         << " late frames." << endl;
+
+    // The source is exhausted after the remaining frames.
+    const auto rest = streamingIK.run(source, sink);
+    ASSERT(rest.numFrames == 15);
+}
+
+int main() {
+    testStreamingMatchesTool("std_calibrated_subject07.osim");
+    testRealTimeReplay("std_calibrated_subject07.osim");
+    cout << "Done. All testStreamingIMUInverseKinematics cases passed."
+         << endl;
+    return 0;
+}
@@ -21,8 +21,10 @@
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
 
+#include "opensim-cmd_convert-table.h"
 #include "opensim-cmd_info.h"
 #include "opensim-cmd_print-xml.h"
+#include "opensim-cmd_run-batch.h"
 #include "opensim-cmd_run-tool.h"
 #include "opensim-cmd_update-file.h"
 #include "opensim-cmd_viz.h"
@@ -53,9 +55,11 @@ Options:
 
 Available commands:
   run-tool     Run a tool (e.g., Inverse Kinematics) from an XML setup file.
+  run-batch    Run tools from many XML setup files in parallel.
   print-xml    Print a template XML file for a Tool or class.
   info         Show description of properties in an OpenSim class.
   update-file  Update an .xml file (.osim or setup) to this version's format.
+  convert-table  Convert a table between .sto, .mot, .csv, and .stb files.
   viz          Show a model, motion, or data with the Simbody Visualizer.
 
   Pass -h or --help to any of these commands to learn how to use them.
@@ -73,6 +77,7 @@ Description of options:
 
 Examples:
   opensim-cmd run-tool InverseDynamics_Setup.xml
+  opensim-cmd run-batch --jobs=8 subject*/Setup_IK.xml
   opensim-cmd print-xml cmc
   opensim-cmd info PathActuator
   opensim-cmd update-file lowerlimb_v3.3.osim lowerlimb_updated.osim
@@ -94,8 +99,10 @@ int main(int argc, const char** argv) {
 
     commands["print-xml"] = print_xml;
     commands["run-tool"] = run_tool;
+    commands["run-batch"] = run_batch;
     commands["info"] = info;
     commands["update-file"] = update_file;
+    commands["convert-table"] = convert_table;
     commands["viz"] = viz;
 
     // If no arguments are provided; just print the help text.
@@ -0,0 +1,73 @@
+#ifndef OPENSIM_CMD_CONVERT_TABLE_H_
+#define OPENSIM_CMD_CONVERT_TABLE_H_
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  opensim-cmd_convert-table.h                  *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <iostream>
+
+#include <docopt.h>
+#include "parse_arguments.h"
+
+static const char HELP_CONVERT_TABLE[] =
+R"(Convert a table of doubles between the .sto, .mot, .csv, and .stb formats.
+
+Usage:
+  opensim-cmd [options]... convert-table <input-file> <output-file>
+  opensim-cmd convert-table -h | --help
+
+Options:
+  -L <path>, --library <path>  Load a plugin.
+  -o <level>, --log <level>  Logging level.
+
+Description:
+  The formats are determined from the file extensions. The .stb format is a
+  binary, columnar format that is much faster to read and write than the text
+  formats and stores numbers exactly (see STBFileAdapter).
+
+Examples:
+  opensim-cmd convert-table subject01_walk1_ik.mot subject01_walk1_ik.stb
+  opensim-cmd convert-table states.stb states.sto
+)";
+
+int convert_table(int argc, const char** argv) {
+
+    using namespace OpenSim;
+
+    std::map<std::string, docopt::value> args = OpenSim::parse_arguments(
+            HELP_CONVERT_TABLE, { argv + 1, argv + argc },
+            true); // show help if requested
+
+    const std::string inputFile = args["<input-file>"].asString();
+    const std::string outputFile = args["<output-file>"].asString();
+
+    log_info("Loading input file '{}'.", inputFile);
+    TimeSeriesTable table(inputFile);
+
+    log_info("Writing {} rows and {} columns to '{}'.", table.getNumRows(),
+            table.getNumColumns(), outputFile);
+    DataAdapter::InputTables tables{};
+    tables.emplace("table", &table);
+    FileAdapter::writeFile(tables, outputFile);
+    return EXIT_SUCCESS;
+}
+
+#endif // OPENSIM_CMD_CONVERT_TABLE_H_
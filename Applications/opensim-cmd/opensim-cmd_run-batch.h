@@ -0,0 +1,250 @@
+#ifndef OPENSIM_CMD_RUN_BATCH_H_
+#define OPENSIM_CMD_RUN_BATCH_H_
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  opensim-cmd_run-batch.h                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+    #include <sys/wait.h>
+#endif
+
+#include <docopt.h>
+#include "parse_arguments.h"
+
+static const char HELP_RUN_BATCH[] =
+R"(Run many tools (e.g., one per trial) from XML setup files, in parallel.
+
+Usage:
+  opensim-cmd [options]... run-batch <setup-xml-file>...
+  opensim-cmd [options]... run-batch --manifest=<file>
+  opensim-cmd run-batch -h | --help
+
+Options:
+  -L <path>, --library <path>  Load a plugin.
+  -o <level>, --log <level>  Logging level.
+  -m <file>, --manifest <file>  File listing the setup files to run.
+  -j <n>, --jobs <n>  Number of tools to run at a time [default: 0].
+  --log-dir <dir>  Directory for the log of each run [default: run-batch-logs].
+  --summary <file>  Write the status and duration of each run to a CSV file.
+
+Description:
+  Each setup file is run as with `opensim-cmd run-tool <setup-xml-file>`, in
+  its own opensim-cmd process, so that a failure (or crash) in one run does
+  not affect the others. Up to --jobs runs execute at a time; the default (0)
+  is the number of hardware threads. Plugins and the logging level are passed
+  on to each run.
+
+  The console output of each run is written to its own log file in --log-dir,
+  named after the position of the setup file in the batch and the setup
+  file's name (e.g., 0003_subject02_Setup_IK.log). When all runs have
+  finished, a summary of their durations and failures is printed. The
+  command fails if any run fails.
+
+  A manifest lists one setup file per line. Blank lines and lines starting
+  with '#' are ignored, and relative paths are relative to the directory
+  containing the manifest.
+
+Examples:
+  opensim-cmd run-batch --jobs=8 subject*/Setup_IK.xml
+  opensim-cmd run-batch --manifest=trials.txt --summary=timings.csv
+  opensim-cmd -L libosimMyPlugin.so run-batch -j 4 trial1.xml trial2.xml
+)";
+
+namespace OpenSim {
+namespace run_batch_detail {
+
+struct Run {
+    std::string setupFile;
+    std::string logFile;
+    int exitStatus = -1;
+    double duration = 0;
+};
+
+inline bool isAbsolutePath(const std::string& path) {
+    return (!path.empty() && (path[0] == '/' || path[0] == '\\')) ||
+           (path.size() > 1 && path[1] == ':');
+}
+
+inline std::vector<std::string> readManifest(const std::string& manifest) {
+    std::ifstream in(manifest);
+    OPENSIM_THROW_IF(!in.good(), FileDoesNotExist, manifest);
+    const std::string directory = IO::getParentDirectory(manifest);
+    std::vector<std::string> setupFiles;
+    std::string line;
+    while (std::getline(in, line)) {
+        IO::TrimWhitespace(line);
+        if (line.empty() || line[0] == '#') continue;
+        setupFiles.push_back(isAbsolutePath(line) ? line : directory + line);
+    }
+    return setupFiles;
+}
+
+/// Quote the argument for the shell that runCommand() uses.
+inline std::string quote(const std::string& arg) {
+#ifdef _WIN32
+    return "\"" + arg + "\"";
+#else
+    // Nothing is special within single quotes in sh, except the single quote
+    // itself, which ends the quotes, is escaped, and starts new quotes.
+    std::string quoted = "'";
+    for (const char c : arg) {
+        if (c == '\'') quoted += "'\\''";
+        else quoted += c;
+    }
+    return quoted + "'";
+#endif
+}
+
+/// Run a command in a shell and return its exit status.
+inline int runCommand(const std::string& command) {
+#ifdef _WIN32
+    // cmd.exe strips the outermost quotes of the command line.
+    return std::system(("\"" + command + "\"").c_str());
+#else
+    const int status = std::system(command.c_str());
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+#endif
+}
+
+} // namespace run_batch_detail
+} // namespace OpenSim
+
+int run_batch(int argc, const char** argv) {
+
+    using namespace OpenSim;
+    using namespace OpenSim::run_batch_detail;
+
+    std::map<std::string, docopt::value> args = OpenSim::parse_arguments(
+            HELP_RUN_BATCH, { argv + 1, argv + argc },
+            true); // show help if requested
+
+    std::vector<std::string> setupFiles;
+    if (args["--manifest"]) {
+        setupFiles = readManifest(args["--manifest"].asString());
+    } else {
+        setupFiles = args["<setup-xml-file>"].asStringList();
+    }
+    if (setupFiles.empty()) {
+        log_warn("No setup files to run.");
+        return EXIT_SUCCESS;
+    }
+
+    int numJobs = (int)args["--jobs"].asLong();
+    if (numJobs < 1) {
+        numJobs = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+    numJobs = std::min(numJobs, (int)setupFiles.size());
+
+    const std::string logDir = args["--log-dir"].asString();
+    IO::makeDir(logDir);
+
+    // Each run uses this executable, with the same plugins and logging level.
+    std::string commandPrefix = quote(argv[0]);
+    if (args["--library"]) {
+        for (const auto& plugin : args["--library"].asStringList()) {
+            commandPrefix += " --library=" + quote(plugin);
+        }
+    }
+    if (args["--log"]) {
+        commandPrefix += " --log=" + quote(args["--log"].asString());
+    }
+    commandPrefix += " run-tool ";
+
+    std::vector<Run> runs(setupFiles.size());
+    for (int i = 0; i < (int)runs.size(); ++i) {
+        runs[i].setupFile = setupFiles[i];
+        std::string name = IO::GetFileNameFromURI(setupFiles[i]);
+        const auto extSep = name.rfind('.');
+        if (extSep != std::string::npos) name = name.substr(0, extSep);
+        runs[i].logFile = logDir + "/" + fmt::format("{:04d}_{}.log", i, name);
+    }
+
+    log_info("Running {} setup file(s) with {} job(s); logs are in '{}'.",
+            runs.size(), numJobs, logDir);
+
+    // Each worker takes the next run that has not been started.
+    Stopwatch batchWatch;
+    std::atomic<int> nextRun(0);
+    auto worker = [&]() {
+        int i;
+        while ((i = nextRun++) < (int)runs.size()) {
+            Run& run = runs[i];
+            Stopwatch watch;
+            run.exitStatus = runCommand(commandPrefix + quote(run.setupFile) +
+                    " > " + quote(run.logFile) + " 2>&1");
+            run.duration = watch.getElapsedTime();
+            if (run.exitStatus == EXIT_SUCCESS) {
+                log_info("[{}/{}] Finished '{}' in {:.2f} s.", i + 1,
+                        runs.size(), run.setupFile, run.duration);
+            } else {
+                log_error("[{}/{}] '{}' failed with exit status {}; see "
+                          "'{}'.", i + 1, runs.size(), run.setupFile,
+                        run.exitStatus, run.logFile);
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int t = 1; t < numJobs; ++t) threads.emplace_back(worker);
+    worker();
+    for (auto& thread : threads) thread.join();
+
+    // Summary.
+    // --------
+    int numFailed = 0;
+    double totalDuration = 0;
+    for (const auto& run : runs) {
+        if (run.exitStatus != EXIT_SUCCESS) ++numFailed;
+        totalDuration += run.duration;
+    }
+    log_cout("Completed {} run(s) in {} ({:.2f} s of run time in total); "
+             "{} failed.", runs.size(), batchWatch.getElapsedTimeFormatted(),
+            totalDuration, numFailed);
+    for (const auto& run : runs) {
+        if (run.exitStatus != EXIT_SUCCESS) {
+            log_cout("  FAILED: {} (log: {})", run.setupFile, run.logFile);
+        }
+    }
+
+    if (args["--summary"]) {
+        const std::string summaryFile = args["--summary"].asString();
+        std::ofstream out(summaryFile);
+        OPENSIM_THROW_IF(!out.good(), Exception,
+                "Could not open '{}' for writing.", summaryFile);
+        out << "setup_file,exit_status,duration_s,log_file\n";
+        for (const auto& run : runs) {
+            out << run.setupFile << "," << run.exitStatus << ","
+                << run.duration << "," << run.logFile << "\n";
+        }
+    }
+
+    return numFailed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#endif // OPENSIM_CMD_RUN_BATCH_H_
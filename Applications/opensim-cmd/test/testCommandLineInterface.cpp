@@ -23,6 +23,7 @@
 
 #include <SimTKcommon/Testing.h>
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <regex>
@@ -490,12 +491,81 @@ void testUpdateFile() {
     testLoadPluginLibraries("update-file");
 }
 
+void testRunBatch() {
+    // Help.
+    // =====
+    {
+        auto output = ContainsSubstring("Run many tools");
+        testCommand("run-batch -h", EXIT_SUCCESS, output);
+        testCommand("run-batch --help", EXIT_SUCCESS, output);
+    }
+
+    // Error messages.
+    // ===============
+    testCommand("run-batch", EXIT_FAILURE,
+            ContainsSubstring("Arguments did not match expected patterns"));
+    testCommand("run-batch --manifest=nonexistent_manifest.txt", EXIT_FAILURE,
+            ContainsSubstring("nonexistent_manifest.txt"));
+
+    // A run that fails does not stop the others, but the batch fails.
+    testCommand("run-batch --jobs=2 --log-dir=testrunbatch_logs "
+                "nonexistent_setup1.xml nonexistent_setup2.xml",
+            EXIT_FAILURE,
+            std::regex(RE_ANY + "(Completed 2 run\\(s\\) in )" + RE_ANY +
+                       "(2 failed.)" + RE_ANY +
+                       "(FAILED: nonexistent_setup1.xml)" + RE_ANY));
+
+    // An empty manifest.
+    {
+        std::ofstream out("testrunbatch_manifest.txt");
+        out << "# No setup files.\n\n";
+    }
+    testCommand("run-batch --manifest=testrunbatch_manifest.txt",
+            EXIT_SUCCESS, ContainsSubstring("No setup files to run."));
+}
+
+void testConvertTable() {
+    // Help.
+    // =====
+    {
+        auto output = ContainsSubstring("Convert a table of doubles");
+        testCommand("convert-table -h", EXIT_SUCCESS, output);
+        testCommand("convert-table --help", EXIT_SUCCESS, output);
+    }
+
+    // Error messages.
+    // ===============
+    testCommand("convert-table", EXIT_FAILURE,
+            ContainsSubstring("Arguments did not match expected patterns"));
+    testCommand("convert-table x.sto", EXIT_FAILURE,
+            ContainsSubstring("Arguments did not match expected patterns"));
+    testCommand("convert-table x.sto y.stb", EXIT_FAILURE,
+            ContainsSubstring("Loading input file 'x.sto'"));
+
+    // Successful input.
+    // =================
+    {
+        std::ofstream out("testconverttable.sto");
+        out << "version=1\nnRows=2\nnColumns=3\ninDegrees=no\nendheader\n"
+               "time\ta\tb\n0\t1\t2\n0.1\t3\t4\n";
+    }
+    testCommand("convert-table testconverttable.sto testconverttable.stb",
+            EXIT_SUCCESS,
+            ContainsSubstring("Writing 2 rows and 2 columns to "
+                              "'testconverttable.stb'."));
+    testCommand("convert-table testconverttable.stb "
+                "testconverttable_roundtrip.csv", EXIT_SUCCESS,
+            ContainsSubstring("Loading input file 'testconverttable.stb'."));
+}
+
 int main() {
     SimTK_START_TEST("testCommandLineInterface");
         SimTK_SUBTEST(testNoCommand);
         SimTK_SUBTEST(testRunTool);
+        SimTK_SUBTEST(testRunBatch);
         SimTK_SUBTEST(testPrintXML);
         SimTK_SUBTEST(testInfo);
         SimTK_SUBTEST(testUpdateFile);
+        SimTK_SUBTEST(testConvertTable);
     SimTK_END_TEST();
 }
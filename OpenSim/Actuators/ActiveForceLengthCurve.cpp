@@ -80,12 +80,16 @@ void ActiveForceLengthCurve::constructProperties()
     constructProperty_max_norm_active_fiber_length(1.8123);
     constructProperty_shallow_ascending_slope(0.8616);
     constructProperty_minimum_value(0.1);
+    constructProperty_tabulation_tolerance();
 }
 
 void ActiveForceLengthCurve::buildCurve()
 {
     SimTK::Function* f = createSimTKFunction();
     m_curve = *(static_cast<SmoothSegmentedFunction*>(f));
+    if(!getProperty_tabulation_tolerance().empty()) {
+        m_curve.tabulate(get_tabulation_tolerance());
+    }
     delete f;
     setObjectIsUpToDateWithProperties();
 }
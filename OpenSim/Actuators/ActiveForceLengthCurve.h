@@ -127,6 +127,8 @@ public:
         "Slope of the shallow ascending limb");
     OpenSim_DECLARE_PROPERTY(minimum_value, double,
         "Minimum value of the active-force-length curve");
+    OpenSim_DECLARE_OPTIONAL_PROPERTY(tabulation_tolerance, double,
+        "If specified, the curve and its first two derivatives are evaluated from a precomputed table with this (relative) tolerance, which is faster than evaluating the curve itself (see SmoothSegmentedFunction::tabulate())");
 
 //==============================================================================
 // PUBLIC METHODS
@@ -207,7 +209,7 @@ public:
 
     /** Evaluates the active-force-length curve at a normalized fiber length of
     'normFiberLength'. */
-    double calcValue(double normFiberLength) const;
+    double calcValue(double normFiberLength) const override;
 
 
     /** Calculates the derivative of the active-force-length multiplier with
@@ -220,7 +222,7 @@ public:
         The derivative of the active-force-length curve with respect to the
         normalized fiber length.
     */
-    double calcDerivative(double normFiberLength, int order) const;
+    double calcDerivative(double normFiberLength, int order) const override;
     
     /// If possible, use the simpler overload above.
     double calcDerivative(const std::vector<int>& derivComponents,
@@ -471,6 +471,197 @@ void DeGrooteFregly2016Muscle::calcMusclePotentialEnergyInfoHelper(
             mpei.fiberPotentialEnergy + mpei.tendonPotentialEnergy;
 }
 
+DeGrooteFregly2016Muscle::Partials DeGrooteFregly2016Muscle::calcPartials(
+        const SimTK::Real& muscleTendonLength,
+        const SimTK::Real& muscleTendonVelocity,
+        const SimTK::Real& activation, const SimTK::Real& normTendonForce,
+        const SimTK::Real& normTendonForceDerivative) const {
+    using SimTK::square;
+
+    // Notation: "AT" means "along the tendon", and dy_dx is the partial
+    // derivative of y with respect to x. The partial derivatives are taken
+    // through the fiber length and velocity along the tendon, whose partial
+    // derivatives with respect to muscle-tendon length and velocity are 1.
+    const bool ignoreTendonCompliance = get_ignore_tendon_compliance();
+    MuscleLengthInfo mli;
+    calcMuscleLengthInfoHelper(
+            muscleTendonLength, ignoreTendonCompliance, mli, normTendonForce);
+
+    const SimTK::Real& maxIsometricForce = get_max_isometric_force();
+    const SimTK::Real& tendonSlackLength = get_tendon_slack_length();
+    const SimTK::Real& vMax = m_maxContractionVelocityInMetersPerSecond;
+    const SimTK::Real& cosPenn = mli.cosPennationAngle;
+    const SimTK::Real& activeFL = mli.fiberActiveForceLengthMultiplier;
+    const SimTK::Real& passiveFL = mli.fiberPassiveForceLengthMultiplier;
+    const SimTK::Real activeFLDeriv =
+            calcActiveForceLengthMultiplierDerivative(mli.normFiberLength);
+    const SimTK::Real passiveFLDeriv =
+            calcPassiveForceMultiplierDerivative(mli.normFiberLength);
+    // fiberLength = sqrt(fiberLengthAT^2 + fiberWidth^2)
+    // cosPennationAngle = fiberLengthAT / fiberLength
+    const SimTK::Real dNormFiberLength_dFiberLengthAT =
+            cosPenn / get_optimal_fiber_length();
+    const SimTK::Real dCosPenn_dFiberLengthAT =
+            square(mli.sinPennationAngle) / mli.fiberLength;
+
+    // Partial derivatives of the normalized fiber force along the tendon, as
+    // computed in implicit mode (or with a rigid tendon) from the fiber
+    // velocity along the tendon.
+    SimTK::Real dNormFiberForceAT_dActivation;
+    SimTK::Real dNormFiberForceAT_dFiberLengthAT;
+    SimTK::Real dNormFiberForceAT_dFiberVelocityAT;
+    const auto calcNormFiberForceATPartials =
+            [&](const SimTK::Real& fiberVelocityAT) {
+                const SimTK::Real normFiberVelocity =
+                        fiberVelocityAT * cosPenn / vMax;
+                const SimTK::Real forceVelocityMult =
+                        calcForceVelocityMultiplier(normFiberVelocity);
+                const SimTK::Real normFiberForce =
+                        activation * activeFL * forceVelocityMult + passiveFL +
+                        get_fiber_damping() * normFiberVelocity;
+                const SimTK::Real dNormFiberForce_dNormFiberLength =
+                        activation * activeFLDeriv * forceVelocityMult +
+                        passiveFLDeriv;
+                const SimTK::Real dNormFiberForce_dNormFiberVelocity =
+                        activation * activeFL *
+                                calcForceVelocityMultiplierDerivative(
+                                        normFiberVelocity) +
+                        get_fiber_damping();
+                // Normalized fiber velocity depends on the fiber length along
+                // the tendon through the pennation angle.
+                const SimTK::Real dNormFiberForce_dFiberLengthAT =
+                        dNormFiberForce_dNormFiberLength *
+                                dNormFiberLength_dFiberLengthAT +
+                        dNormFiberForce_dNormFiberVelocity * fiberVelocityAT *
+                                dCosPenn_dFiberLengthAT / vMax;
+
+                dNormFiberForceAT_dActivation =
+                        activeFL * forceVelocityMult * cosPenn;
+                dNormFiberForceAT_dFiberLengthAT =
+                        dNormFiberForce_dFiberLengthAT * cosPenn +
+                        normFiberForce * dCosPenn_dFiberLengthAT;
+                dNormFiberForceAT_dFiberVelocityAT =
+                        dNormFiberForce_dNormFiberVelocity * square(cosPenn) /
+                        vMax;
+            };
+
+    Partials partials;
+    if (ignoreTendonCompliance) {
+        // tendonForce = maxIsometricForce * normFiberForceAT
+        calcNormFiberForceATPartials(muscleTendonVelocity);
+        partials.partialTendonForcePartialActivation =
+                maxIsometricForce * dNormFiberForceAT_dActivation;
+        partials.partialTendonForcePartialMuscleTendonLength =
+                maxIsometricForce * dNormFiberForceAT_dFiberLengthAT;
+        partials.partialTendonForcePartialMuscleTendonVelocity =
+                maxIsometricForce * dNormFiberForceAT_dFiberVelocityAT;
+        return partials;
+    }
+
+    // tendonForce = maxIsometricForce * normTendonForce
+    partials.partialTendonForcePartialNormTendonForce = maxIsometricForce;
+
+    // The slope of the tendon force-length curve is
+    // kT * (normTendonForce + c3), and the inverse curve has slope
+    // 1 / tendonFLDeriv.
+    const SimTK::Real tendonFLDeriv =
+            calcTendonForceMultiplierDerivative(mli.normTendonLength);
+    const SimTK::Real dTendonFLDeriv_dNormTendonForce = m_kT;
+    const SimTK::Real dFiberLengthAT_dNormTendonForce =
+            -tendonSlackLength / tendonFLDeriv;
+
+    // Equilibrium residual (implicit mode).
+    // -------------------------------------
+    // residual = normTendonForce - normFiberForceAT
+    // fiberVelocityAT = muscleTendonVelocity -
+    //         tendonSlackLength * normTendonForceDerivative / tendonFLDeriv
+    {
+        const SimTK::Real fiberVelocityAT =
+                muscleTendonVelocity -
+                tendonSlackLength * normTendonForceDerivative / tendonFLDeriv;
+        const SimTK::Real dFiberVelocityAT_dNormTendonForce =
+                tendonSlackLength * normTendonForceDerivative *
+                dTendonFLDeriv_dNormTendonForce / square(tendonFLDeriv);
+        const SimTK::Real dFiberVelocityAT_dNormTendonForceDeriv =
+                -tendonSlackLength / tendonFLDeriv;
+        calcNormFiberForceATPartials(fiberVelocityAT);
+
+        partials.partialEquilibriumResidualPartialActivation =
+                -dNormFiberForceAT_dActivation;
+        partials.partialEquilibriumResidualPartialMuscleTendonLength =
+                -dNormFiberForceAT_dFiberLengthAT;
+        partials.partialEquilibriumResidualPartialMuscleTendonVelocity =
+                -dNormFiberForceAT_dFiberVelocityAT;
+        partials.partialEquilibriumResidualPartialNormTendonForce =
+                1.0 -
+                dNormFiberForceAT_dFiberLengthAT *
+                        dFiberLengthAT_dNormTendonForce -
+                dNormFiberForceAT_dFiberVelocityAT *
+                        dFiberVelocityAT_dNormTendonForce;
+        partials.partialEquilibriumResidualPartialNormTendonForceDerivative =
+                -dNormFiberForceAT_dFiberVelocityAT *
+                dFiberVelocityAT_dNormTendonForceDeriv;
+    }
+
+    // Normalized tendon force derivative (explicit mode).
+    // ---------------------------------------------------
+    // See calcFiberVelocityInfoHelper() and computeStateVariableDerivatives():
+    // forceVelocityMult =
+    //         (normTendonForce / cosPenn - passiveFL) / (activation * activeFL)
+    // fiberVelocityAT =
+    //         vMax * forceVelocityInverseCurve(forceVelocityMult) / cosPenn
+    // normTendonForceDerivative = tendonFLDeriv *
+    //         (muscleTendonVelocity - fiberVelocityAT) / tendonSlackLength
+    {
+        const SimTK::Real activeForce = activation * activeFL;
+        const SimTK::Real forceVelocityMult =
+                (normTendonForce / cosPenn - passiveFL) / activeForce;
+        const SimTK::Real fiberVelocityAT =
+                vMax * calcForceVelocityInverseCurve(forceVelocityMult) /
+                cosPenn;
+
+        const SimTK::Real dForceVelocityMult_dActivation =
+                -forceVelocityMult / activation;
+        const SimTK::Real dForceVelocityMult_dNormTendonForce =
+                1.0 / (cosPenn * activeForce);
+        const SimTK::Real dForceVelocityMult_dFiberLengthAT =
+                (-normTendonForce / square(cosPenn) * dCosPenn_dFiberLengthAT -
+                        passiveFLDeriv * dNormFiberLength_dFiberLengthAT) /
+                        activeForce -
+                forceVelocityMult * activeFLDeriv *
+                        dNormFiberLength_dFiberLengthAT / activeFL;
+
+        const SimTK::Real dFiberVelocityAT_dForceVelocityMult =
+                vMax *
+                calcForceVelocityInverseCurveDerivative(forceVelocityMult) /
+                cosPenn;
+        const SimTK::Real dFiberVelocityAT_dFiberLengthAT =
+                dFiberVelocityAT_dForceVelocityMult *
+                        dForceVelocityMult_dFiberLengthAT -
+                fiberVelocityAT * dCosPenn_dFiberLengthAT / cosPenn;
+        const SimTK::Real dFiberVelocityAT_dNormTendonForce =
+                dFiberVelocityAT_dForceVelocityMult *
+                        dForceVelocityMult_dNormTendonForce +
+                dFiberVelocityAT_dFiberLengthAT *
+                        dFiberLengthAT_dNormTendonForce;
+
+        const SimTK::Real scale = tendonFLDeriv / tendonSlackLength;
+        partials.partialNormTendonForceDerivativePartialActivation =
+                -scale * dFiberVelocityAT_dForceVelocityMult *
+                dForceVelocityMult_dActivation;
+        partials.partialNormTendonForceDerivativePartialMuscleTendonLength =
+                -scale * dFiberVelocityAT_dFiberLengthAT;
+        partials.partialNormTendonForceDerivativePartialMuscleTendonVelocity =
+                scale;
+        partials.partialNormTendonForceDerivativePartialNormTendonForce =
+                dTendonFLDeriv_dNormTendonForce *
+                        (muscleTendonVelocity - fiberVelocityAT) /
+                        tendonSlackLength -
+                scale * dFiberVelocityAT_dNormTendonForce;
+    }
+    return partials;
+}
+
 void DeGrooteFregly2016Muscle::calcMuscleLengthInfo(
         const SimTK::State& s, MuscleLengthInfo& mli) const {
 
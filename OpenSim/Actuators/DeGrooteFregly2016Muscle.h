@@ -430,6 +430,22 @@ public:
         return (sinh(1.0 / d1 * (forceVelocityMult - d4)) - d3) / d2;
     }
 
+    /// The derivative of the force-velocity multiplier curve with respect to
+    /// normalized fiber velocity.
+    static SimTK::Real calcForceVelocityMultiplierDerivative(
+            const SimTK::Real& normFiberVelocity) {
+        using SimTK::square;
+        const SimTK::Real tempV = d2 * normFiberVelocity + d3;
+        return d1 * d2 / sqrt(square(tempV) + 1.0);
+    }
+
+    /// The derivative of the force-velocity inverse curve with respect to the
+    /// force-velocity multiplier.
+    static SimTK::Real calcForceVelocityInverseCurveDerivative(
+            const SimTK::Real& forceVelocityMult) {
+        return cosh(1.0 / d1 * (forceVelocityMult - d4)) / (d1 * d2);
+    }
+
     /// This is the passive force-length curve. The curve becomes negative below
     /// the minNormFiberLength.
     ///
@@ -753,6 +769,47 @@ public:
                mdi.tendonStiffness *
                        (muscleTendonVelocity - fvi.fiberVelocityAlongTendon);
     }
+
+    /// Partial derivatives computed by calcPartials(). "Activation" is
+    /// excitation if ignore_activation_dynamics is true.
+    struct Partials {
+        /// Tendon force (N).
+        SimTK::Real partialTendonForcePartialActivation = 0;
+        SimTK::Real partialTendonForcePartialNormTendonForce = 0;
+        SimTK::Real partialTendonForcePartialMuscleTendonLength = 0;
+        SimTK::Real partialTendonForcePartialMuscleTendonVelocity = 0;
+        /// The muscle-tendon equilibrium residual (see
+        /// calcEquilibriumResidual()), used with implicit tendon compliance
+        /// dynamics.
+        SimTK::Real partialEquilibriumResidualPartialActivation = 0;
+        SimTK::Real partialEquilibriumResidualPartialNormTendonForce = 0;
+        SimTK::Real partialEquilibriumResidualPartialMuscleTendonLength = 0;
+        SimTK::Real partialEquilibriumResidualPartialMuscleTendonVelocity = 0;
+        SimTK::Real
+                partialEquilibriumResidualPartialNormTendonForceDerivative = 0;
+        /// The time derivative of normalized tendon force computed with
+        /// explicit tendon compliance dynamics.
+        SimTK::Real partialNormTendonForceDerivativePartialActivation = 0;
+        SimTK::Real partialNormTendonForceDerivativePartialNormTendonForce = 0;
+        SimTK::Real
+                partialNormTendonForceDerivativePartialMuscleTendonLength = 0;
+        SimTK::Real
+                partialNormTendonForceDerivativePartialMuscleTendonVelocity = 0;
+    };
+
+    /// Compute the partial derivatives of tendon force, the muscle-tendon
+    /// equilibrium residual, and the explicit time derivative of normalized
+    /// tendon force with respect to activation, normalized tendon force,
+    /// muscle-tendon length and muscle-tendon velocity (and, for the residual,
+    /// the time derivative of normalized tendon force) from the closed-form
+    /// muscle curves. The arguments are the same as for
+    /// calcEquilibriumResidual(); `normTendonForce` and
+    /// `normTendonForceDerivative` are ignored if ignore_tendon_compliance is
+    /// true, in which case only the tendon force partials are nonzero.
+    Partials calcPartials(const SimTK::Real& muscleTendonLength,
+            const SimTK::Real& muscleTendonVelocity,
+            const SimTK::Real& activation, const SimTK::Real& normTendonForce,
+            const SimTK::Real& normTendonForceDerivative) const;
     /// @}
 
     /// @name Utilities
@@ -82,6 +82,7 @@ void FiberCompressiveForceCosPennationCurve::constructProperties()
     constructProperty_engagement_angle_in_degrees(85);
     constructProperty_stiffness_at_perpendicular();
     constructProperty_curviness();
+    constructProperty_tabulation_tolerance();
 
 }
 
@@ -97,6 +98,9 @@ void FiberCompressiveForceCosPennationCurve::buildCurve( bool computeIntegral )
                 getName());       
 
     m_curve = *f; 
+    if(!getProperty_tabulation_tolerance().empty()) {
+        m_curve.tabulate(get_tabulation_tolerance());
+    }
     
     delete f;  
        
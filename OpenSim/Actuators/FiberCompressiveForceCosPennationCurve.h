@@ -83,6 +83,8 @@ public:
         "Stiffness of the curve at pennation angle of 90 degrees");
     OpenSim_DECLARE_OPTIONAL_PROPERTY(curviness, double, 
         "Fiber curve bend, from linear to maximum bend (0-1)");
+    OpenSim_DECLARE_OPTIONAL_PROPERTY(tabulation_tolerance, double,
+        "If specified, the curve and its first two derivatives are evaluated from a precomputed table with this (relative) tolerance, which is faster than evaluating the curve itself (see SmoothSegmentedFunction::tabulate())");
 
 //==============================================================================
 // PUBLIC METHODS
@@ -292,7 +294,7 @@ public:
     \endverbatim
 
     */
-    double calcValue(double cosPennationAngle) const;
+    double calcValue(double cosPennationAngle) const override;
 
 
     /** Implement the generic OpenSim::Function interface **/
@@ -321,7 +323,7 @@ public:
     \endverbatim
 
     */
-    double calcDerivative(double cosPennationAngle, int order) const;
+    double calcDerivative(double cosPennationAngle, int order) const override;
 
     /// If possible, use the simpler overload above.
     double calcDerivative(const std::vector<int>& derivComponents,
@@ -72,6 +72,7 @@ void FiberCompressiveForceLengthCurve::constructProperties()
     constructProperty_norm_length_at_zero_force(0.5);
     constructProperty_stiffness_at_zero_length();
     constructProperty_curviness();
+    constructProperty_tabulation_tolerance();
 }
 
 
@@ -86,6 +87,9 @@ void FiberCompressiveForceLengthCurve::buildCurve( bool computeIntegral )
                 getName());            
     
     m_curve = *f;  
+    if(!getProperty_tabulation_tolerance().empty()) {
+        m_curve.tabulate(get_tabulation_tolerance());
+    }
 
     delete f; 
 
@@ -70,6 +70,8 @@ public:
         "Fiber stiffness at zero length");
     OpenSim_DECLARE_OPTIONAL_PROPERTY(curviness, double, 
         "Fiber curve bend, from linear to maximum bend (0-1)");
+    OpenSim_DECLARE_OPTIONAL_PROPERTY(tabulation_tolerance, double,
+        "If specified, the curve and its first two derivatives are evaluated from a precomputed table with this (relative) tolerance, which is faster than evaluating the curve itself (see SmoothSegmentedFunction::tabulate())");
 
 //==============================================================================
 // PUBLIC METHODS
@@ -229,7 +231,7 @@ public:
     \endverbatim
 
     */
-    double calcValue(double aNormLength) const;
+    double calcValue(double aNormLength) const override;
 
  
     /** Implement the generic OpenSim::Function interface **/
@@ -262,7 +264,7 @@ public:
     \endverbatim
 
     */
-    double calcDerivative(double aNormLength, int order) const;
+    double calcDerivative(double aNormLength, int order) const override;
 
     /// If possible, use the simpler overload above.
     double calcDerivative(const std::vector<int>& derivComponents,
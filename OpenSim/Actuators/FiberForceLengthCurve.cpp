@@ -77,6 +77,7 @@ void FiberForceLengthCurve::constructProperties()
     constructProperty_stiffness_at_low_force();
     constructProperty_stiffness_at_one_norm_force();
     constructProperty_curviness();
+    constructProperty_tabulation_tolerance();
 }
 
 void FiberForceLengthCurve::buildCurve(bool computeIntegral)
@@ -92,6 +93,9 @@ void FiberForceLengthCurve::buildCurve(bool computeIntegral)
             getName());
 
     m_curve = *f;
+    if(!getProperty_tabulation_tolerance().empty()) {
+        m_curve.tabulate(get_tabulation_tolerance());
+    }
     delete f;
 
     setObjectIsUpToDateWithProperties();
@@ -172,6 +172,8 @@ public:
         "Fiber stiffness at a tension of 1 normalized force");
     OpenSim_DECLARE_OPTIONAL_PROPERTY(curviness, double,
         "Fiber curve bend, from linear (0) to maximum bend (1)");
+    OpenSim_DECLARE_OPTIONAL_PROPERTY(tabulation_tolerance, double,
+        "If specified, the curve and its first two derivatives are evaluated from a precomputed table with this (relative) tolerance, which is faster than evaluating the curve itself (see SmoothSegmentedFunction::tabulate())");
 
 //==============================================================================
 // PUBLIC METHODS
@@ -277,7 +279,7 @@ public:
 
     /** Evaluates the fiber-force-length curve at a normalized fiber length of
     'normFiberLength'. */
-    double calcValue(double normFiberLength) const;
+    double calcValue(double normFiberLength) const override;
 
     /** Calculates the derivative of the fiber-force-length multiplier with
     respect to the normalized fiber length.
@@ -289,7 +291,7 @@ public:
         The derivative of the fiber-force-length curve with respect to the
         normalized fiber length.
     */
-    double calcDerivative(double normFiberLength, int order) const;
+    double calcDerivative(double normFiberLength, int order) const override;
     
 
     /// If possible, use the simpler overload above.
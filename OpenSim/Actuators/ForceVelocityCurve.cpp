@@ -82,12 +82,16 @@ void ForceVelocityCurve::constructProperties()
     constructProperty_max_eccentric_velocity_force_multiplier(1.4);
     constructProperty_concentric_curviness(0.6);
     constructProperty_eccentric_curviness(0.9);
+    constructProperty_tabulation_tolerance();
 }
 
 void ForceVelocityCurve::buildCurve()
 {
     SimTK::Function* f = createSimTKFunction();
     m_curve = *(static_cast<SmoothSegmentedFunction*>(f));
+    if(!getProperty_tabulation_tolerance().empty()) {
+        m_curve.tabulate(get_tabulation_tolerance());
+    }
     delete f;
     setObjectIsUpToDateWithProperties();
 }
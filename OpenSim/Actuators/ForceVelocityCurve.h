@@ -158,6 +158,8 @@ public:
         "Concentric curve shape, from linear (0) to maximal curve (1)");
     OpenSim_DECLARE_PROPERTY(eccentric_curviness, double,
         "Eccentric curve shape, from linear (0) to maximal curve (1)");
+    OpenSim_DECLARE_OPTIONAL_PROPERTY(tabulation_tolerance, double,
+        "If specified, the curve and its first two derivatives are evaluated from a precomputed table with this (relative) tolerance, which is faster than evaluating the curve itself (see SmoothSegmentedFunction::tabulate())");
 
 //==============================================================================
 // PUBLIC METHODS
@@ -303,7 +305,7 @@ public:
 
     /** Evaluates the force-velocity curve at a normalized fiber velocity of
     'normFiberVelocity'. */
-    double calcValue(double normFiberVelocity) const;
+    double calcValue(double normFiberVelocity) const override;
 
     /** Calculates the derivative of the force-velocity multiplier with respect
     to the normalized fiber velocity.
@@ -315,7 +317,7 @@ public:
         The derivative of the force-velocity curve with respect to the
         normalized fiber velocity.
     */
-    double calcDerivative(double normFiberVelocity, int order) const;
+    double calcDerivative(double normFiberVelocity, int order) const override;
     
 
     /// If possible, use the simpler overload above.
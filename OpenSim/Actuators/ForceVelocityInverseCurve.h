@@ -126,6 +126,8 @@ public:
         "Shape of concentric branch of force-velocity curve, from linear (0) to maximal curve (1)");
     OpenSim_DECLARE_PROPERTY(eccentric_curviness, double,
         "Shape of eccentric branch of force-velocity curve, from linear (0) to maximal curve (1)");
+    OpenSim_DECLARE_OPTIONAL_PROPERTY(tabulation_tolerance, double,
+        "If specified, the curve and its first two derivatives are evaluated from a precomputed table with this (relative) tolerance, which is faster than evaluating the curve itself (see SmoothSegmentedFunction::tabulate())");
 
 //==============================================================================
 // PUBLIC METHODS
@@ -271,7 +273,7 @@ public:
 
     /** Evaluates the inverse force-velocity curve at a force-velocity
     multiplier value of 'aForceVelocityMultiplier'. */
-    double calcValue(double aForceVelocityMultiplier) const;
+    double calcValue(double aForceVelocityMultiplier) const override;
 
     /** Calculates the derivative of the inverse force-velocity curve with
     respect to the force-velocity multiplier.
@@ -283,7 +285,7 @@ public:
         The derivative of the inverse force-velocity curve with respect to the
         force-velocity multiplier.
     */
-    double calcDerivative(double aForceVelocityMultiplier, int order) const;
+    double calcDerivative(double aForceVelocityMultiplier, int order) const override;
     
     /// If possible, use the simpler overload above.
     double calcDerivative(const std::vector<int>& derivComponents,
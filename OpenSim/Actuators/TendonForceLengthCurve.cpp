@@ -88,6 +88,7 @@ void TendonForceLengthCurve::constructProperties()
     constructProperty_stiffness_at_one_norm_force();
     constructProperty_norm_force_at_toe_end();
     constructProperty_curviness();
+    constructProperty_tabulation_tolerance();
 }
 
 void TendonForceLengthCurve::buildCurve(bool computeIntegral)
@@ -100,6 +101,9 @@ void TendonForceLengthCurve::buildCurve(bool computeIntegral)
                                      computeIntegral,
                                      getName());
     m_curve = *f;
+    if(!getProperty_tabulation_tolerance().empty()) {
+        m_curve.tabulate(get_tabulation_tolerance());
+    }
     delete f;
     setObjectIsUpToDateWithProperties();
 }
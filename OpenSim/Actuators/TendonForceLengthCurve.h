@@ -158,6 +158,8 @@ public:
         "Normalized force developed at the end of the toe region");
     OpenSim_DECLARE_OPTIONAL_PROPERTY(curviness, double,
         "Tendon curve bend, from linear (0) to maximum bend (1)");
+    OpenSim_DECLARE_OPTIONAL_PROPERTY(tabulation_tolerance, double,
+        "If specified, the curve and its first two derivatives are evaluated from a precomputed table with this (relative) tolerance, which is faster than evaluating the curve itself (see SmoothSegmentedFunction::tabulate())");
 
 //==============================================================================
 // PUBLIC METHODS
@@ -261,7 +263,7 @@ public:
 
     /** Evaluates the tendon-force-length curve at a normalized tendon length of
     'aNormLength'. */
-    double calcValue(double aNormLength) const;
+    double calcValue(double aNormLength) const override;
 
     /** Calculates the derivative of the tendon-force-length multiplier with
     respect to the normalized tendon length.
@@ -273,7 +275,7 @@ public:
         The derivative of the tendon-force-length curve with respect to the
         normalized tendon length.
     */
-    double calcDerivative(double aNormLength, int order) const;
+    double calcDerivative(double aNormLength, int order) const override;
     
     /// If possible, use the simpler overload above.
     double calcDerivative(const std::vector<int>& derivComponents,
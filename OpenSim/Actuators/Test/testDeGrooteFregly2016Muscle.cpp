@@ -1085,3 +1085,122 @@ TEST_CASE("DeGrooteFregly2016Muscle basics") {
         CHECK(state.getY()[2] == Approx(0.451));
     }
 }
+
+TEST_CASE("DeGrooteFregly2016Muscle calcPartials()") {
+
+    Model model;
+    auto* body = new Body("body", 0.5, SimTK::Vec3(0), SimTK::Inertia(0));
+    model.addComponent(body);
+    auto* joint = new SliderJoint("joint", model.getGround(), *body);
+    auto& coord = joint->updCoordinate(SliderJoint::Coord::TranslationX);
+    coord.setName("x");
+    model.addComponent(joint);
+    auto* musclePtr = new DeGrooteFregly2016Muscle();
+    musclePtr->setName("muscle");
+    musclePtr->set_fiber_damping(0.01);
+    musclePtr->set_pennation_angle_at_optimal(0.12);
+    musclePtr->addNewPathPoint("origin", model.updGround(), SimTK::Vec3(0));
+    musclePtr->addNewPathPoint("insertion", *body, SimTK::Vec3(0));
+    model.addComponent(musclePtr);
+    auto& muscle = model.updComponent<DeGrooteFregly2016Muscle>("muscle");
+    model.finalizeFromProperties();
+
+    const double muscleTendonLength =
+            muscle.get_optimal_fiber_length() * cos(0.12) +
+            1.02 * muscle.get_tendon_slack_length();
+    const double muscleTendonVelocity =
+            -0.3 * muscle.get_optimal_fiber_length() *
+            muscle.get_max_contraction_velocity();
+    const double activation = 0.6;
+    const double normTendonForce = 0.7;
+    const double normTendonForceDerivative = 2.0;
+
+    // Central difference of f with respect to the argument at index.
+    const auto centralDifference =
+            [](const std::function<double(const std::vector<double>&)>& f,
+                    std::vector<double> x, int index) {
+                const double h = 1e-6;
+                x[index] += h;
+                const double forward = f(x);
+                x[index] -= 2 * h;
+                const double backward = f(x);
+                return (forward - backward) / (2 * h);
+            };
+    const auto calcWithState =
+            [&](const std::vector<double>& x,
+                    const std::function<double(const SimTK::State&)>& f) {
+                SimTK::State state = model.initSystem();
+                coord.setValue(state, x[0]);
+                coord.setSpeedValue(state, x[1]);
+                muscle.setActivation(state, x[2]);
+                if (x.size() > 3) muscle.setNormalizedTendonForce(state, x[3]);
+                model.realizeAcceleration(state);
+                return f(state);
+            };
+
+    SECTION("Equilibrium residual") {
+        muscle.set_tendon_compliance_dynamics_mode("implicit");
+        model.finalizeFromProperties();
+        const auto p = muscle.calcPartials(muscleTendonLength,
+                muscleTendonVelocity, activation, normTendonForce,
+                normTendonForceDerivative);
+        const auto residual = [&](const std::vector<double>& x) {
+            return muscle.calcEquilibriumResidual(x[0], x[1], x[2], x[3], x[4]);
+        };
+        const std::vector<double> x{muscleTendonLength, muscleTendonVelocity,
+                activation, normTendonForce, normTendonForceDerivative};
+        CHECK(p.partialEquilibriumResidualPartialMuscleTendonLength ==
+                Approx(centralDifference(residual, x, 0)).epsilon(1e-6));
+        CHECK(p.partialEquilibriumResidualPartialMuscleTendonVelocity ==
+                Approx(centralDifference(residual, x, 1)).epsilon(1e-6));
+        CHECK(p.partialEquilibriumResidualPartialActivation ==
+                Approx(centralDifference(residual, x, 2)).epsilon(1e-6));
+        CHECK(p.partialEquilibriumResidualPartialNormTendonForce ==
+                Approx(centralDifference(residual, x, 3)).epsilon(1e-6));
+        CHECK(p.partialEquilibriumResidualPartialNormTendonForceDerivative
+                == Approx(centralDifference(residual, x, 4)).epsilon(1e-6));
+        CHECK(p.partialTendonForcePartialNormTendonForce ==
+                muscle.get_max_isometric_force());
+    }
+
+    SECTION("Explicit normalized tendon force derivative") {
+        const auto p = muscle.calcPartials(muscleTendonLength,
+                muscleTendonVelocity, activation, normTendonForce, SimTK::NaN);
+        const auto derivative = [&](const std::vector<double>& x) {
+            return calcWithState(x, [&](const SimTK::State& state) {
+                return muscle.getNormalizedTendonForceDerivative(state);
+            });
+        };
+        const std::vector<double> x{muscleTendonLength, muscleTendonVelocity,
+                activation, normTendonForce};
+        CHECK(p.partialNormTendonForceDerivativePartialMuscleTendonLength
+                == Approx(centralDifference(derivative, x, 0)).epsilon(1e-6));
+        CHECK(p.partialNormTendonForceDerivativePartialMuscleTendonVelocity
+                == Approx(centralDifference(derivative, x, 1)).epsilon(1e-6));
+        CHECK(p.partialNormTendonForceDerivativePartialActivation ==
+                Approx(centralDifference(derivative, x, 2)).epsilon(1e-6));
+        CHECK(p.partialNormTendonForceDerivativePartialNormTendonForce
+                == Approx(centralDifference(derivative, x, 3)).epsilon(1e-6));
+    }
+
+    SECTION("Rigid tendon force") {
+        muscle.set_ignore_tendon_compliance(true);
+        model.finalizeFromProperties();
+        const auto p = muscle.calcPartials(muscleTendonLength,
+                muscleTendonVelocity, activation, SimTK::NaN, SimTK::NaN);
+        const auto tendonForce = [&](const std::vector<double>& x) {
+            return calcWithState(x, [&](const SimTK::State& state) {
+                return muscle.getTendonForce(state);
+            });
+        };
+        const std::vector<double> x{
+                muscleTendonLength, muscleTendonVelocity, activation};
+        CHECK(p.partialTendonForcePartialMuscleTendonLength ==
+                Approx(centralDifference(tendonForce, x, 0)).epsilon(1e-6));
+        CHECK(p.partialTendonForcePartialMuscleTendonVelocity ==
+                Approx(centralDifference(tendonForce, x, 1)).epsilon(1e-6));
+        CHECK(p.partialTendonForcePartialActivation ==
+                Approx(centralDifference(tendonForce, x, 2)).epsilon(1e-6));
+        CHECK(p.partialEquilibriumResidualPartialActivation == 0);
+    }
+}
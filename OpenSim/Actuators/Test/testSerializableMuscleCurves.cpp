@@ -255,6 +255,26 @@ void testActiveForceLengthCurve()
 
         cout << "Passed: Testing Services for connectivity" << endl;                            
 
+        cout <<"6. Testing tabulation_tolerance:" << endl;
+            ActiveForceLengthCurve falCurve5;
+            falCurve5.set_tabulation_tolerance(1e-8);
+            falCurve5.ensureCurveUpToDate();
+            for(int i = 0; i <= 100; ++i){
+                double x = 0.3 + 1.7*i/100.0;
+                SimTK_TEST_EQ_TOL(falCurve5.calcValue(x),
+                                  falCurve4.calcValue(x), 1e-7);
+                SimTK_TEST_EQ_TOL(falCurve5.calcDerivative(x,1),
+                                  falCurve4.calcDerivative(x,1), 1e-6);
+            }
+            falCurve5.print("tabulated_ActiveForceLengthCurve.xml");
+            Object* tabObj = Object::
+                    makeObjectFromFile("tabulated_ActiveForceLengthCurve.xml");
+            SimTK_TEST(dynamic_cast<ActiveForceLengthCurve*>(tabObj)
+                               ->get_tabulation_tolerance() == 1e-8);
+            delete tabObj;
+            remove("tabulated_ActiveForceLengthCurve.xml");
+        cout << "Passed: Testing tabulation_tolerance" << endl;
+
         //cout <<"**************************************************"<<endl;
         cout <<"Service correctness is tested by underlying utility class"<<endl;
         cout <<"SmoothSegmentedFunction, and SmoothSegmentedFunctionFactory"<<endl;
@@ -26,7 +26,9 @@
 //=============================================================================
 // INCLUDES
 //=============================================================================
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/IO.h>
+#include <OpenSim/Simulation/Model/FunctionBasedPath.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include "MuscleAnalysis.h"
 
@@ -142,6 +144,8 @@ void MuscleAnalysis::setNull()
     _coordinateListProp.getValueStrArray().setSize(1);
     _coordinateListProp.getValueStrArray().updElt(0) = "all";
     _computeMoments = true;
+    _numThreadsProp.setValue(1);
+    _skipUnspannedCoordinatesProp.setValue(false);
 }
 //_____________________________________________________________________________
 /**
@@ -165,6 +169,17 @@ void MuscleAnalysis::setupProperties()
     _computeMomentsProp.setName("compute_moments");
     _propertySet.append( &_computeMomentsProp );
 
+    _numThreadsProp.setComment("Number of threads used to compute moment "
+        "arms. A value less than 1 uses all available hardware threads.");
+    _numThreadsProp.setName("num_threads");
+    _propertySet.append( &_numThreadsProp );
+
+    _skipUnspannedCoordinatesProp.setComment("Flag indicating whether to "
+        "skip computing moment arms about coordinates that a muscle does not "
+        "span (these are recorded as zero).");
+    _skipUnspannedCoordinatesProp.setName("skip_unspanned_coordinates");
+    _propertySet.append( &_skipUnspannedCoordinatesProp );
+
 }
 //-----------------------------------------------------------------------------
 // DESCRIPTION
@@ -203,6 +218,8 @@ void MuscleAnalysis::allocateStorageObjects()
     _momentArmStorageArray.setSize(0);
     _muscleArray.setMemoryOwner(false);
     _muscleArray.setSize(0);
+    _spannedCoordinates.clear();
+    _momentArmsIncludeCoupling.clear();
 
     // FOR MOMENT ARMS AND MOMENTS
     if(_computeMoments) {
@@ -397,6 +414,29 @@ void MuscleAnalysis::constructColumnLabels()
 }
 
 
+//_____________________________________________________________________________
+/**
+ * Determine which coordinates each muscle spans, using the model's index of
+ * the coordinates spanned by each path.
+ */
+void MuscleAnalysis::computeSpannedCoordinates()
+{
+    const int nq = _momentArmStorageArray.getSize();
+    const int nm = _muscleArray.getSize();
+    _spannedCoordinates.assign(nq, std::vector<bool>(nm, false));
+    _momentArmsIncludeCoupling.assign(nm, true);
+    for (int j = 0; j < nm; ++j) {
+        const GeometryPath& path = _muscleArray[j]->getGeometryPath();
+        for (int i = 0; i < nq; ++i) {
+            _spannedCoordinates[i][j] = _model->getPathSpansCoordinate(path,
+                    *_momentArmStorageArray[i]->q);
+        }
+        // The moment arms of a FunctionBasedPath ignore constraints.
+        _momentArmsIncludeCoupling[j] =
+                dynamic_cast<const FunctionBasedPath*>(&path) == nullptr;
+    }
+}
+
 //=============================================================================
 // OPERATORS
 //=============================================================================
@@ -410,6 +450,8 @@ MuscleAnalysis& MuscleAnalysis::operator=(const MuscleAnalysis &aAnalysis)
     _coordinateListProp = aAnalysis._coordinateListProp;
     _computeMomentsProp = aAnalysis._computeMomentsProp;
     _computeMoments = _computeMomentsProp.getValueBool();
+    _numThreadsProp = aAnalysis._numThreadsProp;
+    _skipUnspannedCoordinatesProp = aAnalysis._skipUnspannedCoordinatesProp;
     allocateStorageObjects();
 
     return (*this);
@@ -640,28 +682,64 @@ int MuscleAnalysis::record(const SimTK::State& s)
     _musclePowerStore->append(tReal,muscPower.getSize(),&muscPower[0]);
 
     if (_computeMoments){
-        // LOOP OVER ACTIVE MOMENT ARM STORAGE OBJECTS
-        Coordinate *q = NULL;
-        Storage *maStore=NULL, *mStore=NULL;
         int nq = _momentArmStorageArray.getSize();
-        Array<double> ma(0.0,nm),m(0.0,nm);
-
-        for(int i=0; i<nq; i++) {
+        _model->getMultibodySystem().realize(s, s.getSystemStage());
+
+        // Coordinates that may be coupled to other coordinates by enabled
+        // constraints; a muscle may have a moment arm about these even if it
+        // does not span them.
+        const bool skip = getSkipUnspannedCoordinates();
+        std::vector<bool> coupled(nq, false);
+        if (skip) {
+            if ((int)_spannedCoordinates.size() != nq)
+                computeSpannedCoordinates();
+            for (const auto& coord :
+                    _model->getCoordinatesCoupledByConstraints(s)) {
+                for (int i = 0; i < nq; ++i) {
+                    if (_momentArmStorageArray[i]->q == coord.get())
+                        coupled[i] = true;
+                }
+            }
+        }
 
-            q = _momentArmStorageArray[i]->q;
-            maStore = _momentArmStorageArray[i]->momentArmStore;
-            mStore = _momentArmStorageArray[i]->momentStore;
-           
-            // bool locked = q->getLocked(s);
+        // Moment arm of each muscle (column) about each coordinate (row).
+        SimTK::Matrix momentArms(nq, nm, 0.0);
+        auto computeMomentArms = [&](const SimTK::State& state,
+                                     int begin, int end) {
+            for (int j = begin; j < end; ++j) {
+                for (int i = 0; i < nq; ++i) {
+                    if (skip && !_spannedCoordinates[i][j] &&
+                            !(coupled[i] && _momentArmsIncludeCoupling[j]))
+                        continue;
+                    momentArms(i, j) = _muscleArray[j]->computeMomentArm(
+                            state, *_momentArmStorageArray[i]->q);
+                }
+            }
+        };
+        if (getNumThreads() == 1 || nm < 2) {
+            computeMomentArms(s, 0, nm);
+        } else {
+            // Computing a moment arm can update cache entries in the state,
+            // so each thread uses its own copy of the state. Each muscle has
+            // its own MomentArmSolver, and each thread has its own muscles.
+            parallelForChunks(nm, getNumThreads(),
+                    [&](int /*threadIndex*/, int begin, int end) {
+                        const SimTK::State localState(s);
+                        computeMomentArms(localState, begin, end);
+                    });
+        }
 
-            _model->getMultibodySystem().realize(s, s.getSystemStage());
-            // LOOP OVER MUSCLES
+        // LOOP OVER ACTIVE MOMENT ARM STORAGE OBJECTS
+        Array<double> ma(0.0,nm),m(0.0,nm);
+        for(int i=0; i<nq; i++) {
             for(int j=0; j<nm; j++) {
-                ma[j] = _muscleArray[j]->computeMomentArm(s,*q);
+                ma[j] = momentArms(i, j);
                 m[j] = ma[j] * force[j];
             }
-            maStore->append(s.getTime(),nm,&ma[0]);
-            mStore->append(s.getTime(),nm,&m[0]);
+            _momentArmStorageArray[i]->momentArmStore->append(
+                    s.getTime(),nm,&ma[0]);
+            _momentArmStorageArray[i]->momentStore->append(
+                    s.getTime(),nm,&m[0]);
         }
     }
     return 0;
@@ -32,6 +32,8 @@
 #include <OpenSim/Simulation/Model/Muscle.h>
 #include "osimAnalysesDLL.h"
 
+#include <vector>
+
 
 #ifdef SWIG
     #ifdef OSIMANALYSES_API
@@ -87,6 +89,12 @@ private:
     /** Compute moments and moment arms. */
     PropertyBool _computeMomentsProp;
 
+    /** Number of threads used to compute moment arms. */
+    PropertyInt _numThreadsProp;
+
+    /** Skip moment arms about coordinates that a muscle does not span. */
+    PropertyBool _skipUnspannedCoordinatesProp;
+
     /** Pennation angle storage. */
     Storage *_pennationAngleStore;
     /** Muscle-tendon length storage. */
@@ -141,6 +149,14 @@ private:
     /** Array of active muscles. */
     ArrayPtrs<Muscle> _muscleArray;
 
+    /** Whether each active muscle (inner index) may have a nonzero moment arm
+    about each coordinate in _momentArmStorageArray (outer index), based on
+    the bodies and coordinates that the muscle's path depends on. */
+    std::vector<std::vector<bool>> _spannedCoordinates;
+    /** Whether the moment arms of each active muscle account for the coupling
+    between coordinates due to constraints. */
+    std::vector<bool> _momentArmsIncludeCoupling;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -155,6 +171,7 @@ private:
     void setupProperties();
     void constructDescription();
     void constructColumnLabels();
+    void computeSpannedCoordinates();
 
 public:
     //--------------------------------------------------------------------------
@@ -218,6 +235,27 @@ public:
     bool getComputeMoments() const {
         return _computeMoments;
     }
+    /** %Set the number of threads used to compute moment arms. Muscles are
+    divided among the threads, each of which uses its own copy of the State.
+    A value less than 1 uses all available hardware threads. The default is
+    1. */
+    void setNumThreads(int numThreads) {
+        _numThreadsProp.setValue(numThreads);
+    }
+    int getNumThreads() const {
+        return _numThreadsProp.getValueInt();
+    }
+    /** If true, moment arms (and moments) about coordinates that a muscle
+    does not span (see Model::getCoordinatesSpannedByPath()) are recorded as
+    zero without being computed. Coordinates that enabled constraints may
+    couple to other coordinates are always computed (see
+    Model::getCoordinatesCoupledByConstraints()). The default is false. */
+    void setSkipUnspannedCoordinates(bool skip) {
+        _skipUnspannedCoordinatesProp.setValue(skip);
+    }
+    bool getSkipUnspannedCoordinates() const {
+        return _skipUnspannedCoordinatesProp.getValueBool();
+    }
 #ifndef SWIG
     const ArrayPtrs<StorageCoordinatePair>& getMomentArmStorageArray() const { return _momentArmStorageArray; }
 #endif
@@ -0,0 +1,331 @@
+#ifndef OPENSIM_BOUNDED_DATA_QUEUE_H_
+#define OPENSIM_BOUNDED_DATA_QUEUE_H_
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  BoundedDataQueue.h                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "Exception.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <SimTKcommon.h>
+
+namespace OpenSim {
+
+/** A bounded queue of timestamped rows of a fixed width, for passing streamed
+data (e.g., IMU orientations) from one producer thread to one consumer thread
+without locks. The storage for all rows is allocated when the queue is
+created, so pushing and popping rows does not allocate memory.
+
+When the queue is full, the OverflowPolicy determines what happens to a new
+row: with Backpressure, push_back() waits for the consumer to pop a row and
+try_push_back() returns false; with DropOldest, the oldest row in the queue is
+discarded to make room for the new row, so the consumer always receives the
+most recent data.
+
+If the row size is 0 when the queue is created, it is set by the first row
+that is pushed, and the storage is allocated then.
+
+At most one thread may push rows and at most one (other) thread may pop rows
+at a time. The statistics (getStatistics()) may be read from any thread.
+Copying a queue is not thread-safe.
+
+@note For DropOldest, each row's slot has a flag that the consumer holds while
+copying the row, so the producer never overwrites a row that is being read. */
+template <class T>
+class BoundedDataQueue_ {
+public:
+    enum class OverflowPolicy {
+        /// The producer waits (push_back()) or fails (try_push_back()) until
+        /// the consumer makes room.
+        Backpressure,
+        /// The oldest row in the queue is discarded.
+        DropOldest
+    };
+
+    /// Counters describing the use of the queue. The latency of a row is the
+    /// time from the start of its push to the end of its pop.
+    struct Statistics {
+        std::uint64_t numPushed = 0;
+        std::uint64_t numPopped = 0;
+        /// Rows discarded by the DropOldest policy.
+        std::uint64_t numDropped = 0;
+        /// Calls to try_push_back() that failed because the queue was full.
+        std::uint64_t numRejected = 0;
+        /// Mean latency of the popped rows, in seconds.
+        double meanLatency = 0;
+        /// Maximum latency of the popped rows, in seconds.
+        double maxLatency = 0;
+    };
+
+    /// @param capacity The maximum number of rows in the queue.
+    /// @param rowSize The number of elements in each row, or 0 to use the size
+    ///     of the first row pushed.
+    /// @param policy What to do with new rows when the queue is full.
+    BoundedDataQueue_(int capacity, int rowSize,
+            OverflowPolicy policy = OverflowPolicy::Backpressure)
+            : m_capacity(capacity), m_rowSize(rowSize), m_policy(policy) {
+        OPENSIM_THROW_IF(capacity < 1, Exception,
+                "Expected capacity to be at least 1, but it is {}.",
+                capacity);
+        OPENSIM_THROW_IF(rowSize < 0, Exception,
+                "Expected rowSize to be non-negative, but it is {}.",
+                rowSize);
+        allocate();
+    }
+
+    BoundedDataQueue_(const BoundedDataQueue_& other)
+            : m_capacity(other.m_capacity), m_rowSize(other.getRowSize()),
+              m_policy(other.m_policy) {
+        allocate();
+        copyContents(other);
+    }
+
+    BoundedDataQueue_& operator=(const BoundedDataQueue_& other) {
+        if (this != &other) {
+            m_capacity = other.m_capacity;
+            m_rowSize.store(other.getRowSize());
+            m_policy = other.m_policy;
+            allocate();
+            copyContents(other);
+        }
+        return *this;
+    }
+
+    int getCapacity() const { return m_capacity; }
+    int getRowSize() const {
+        return m_rowSize.load(std::memory_order_acquire);
+    }
+    OverflowPolicy getOverflowPolicy() const { return m_policy; }
+
+    /// The number of rows in the queue (approximate if the producer or
+    /// consumer is active).
+    int getSize() const {
+        return (int)(m_head.load(std::memory_order_acquire) -
+                     m_tail.load(std::memory_order_acquire));
+    }
+    bool isEmpty() const { return getSize() == 0; }
+
+    /// Push a row to the end of the queue, waiting for the consumer to make
+    /// room if the queue is full and the policy is Backpressure.
+    /// @throws Exception if the row does not have getRowSize() elements.
+    void push_back(double time, const SimTK::RowVectorView_<T>& data) {
+        const auto start = std::chrono::steady_clock::now();
+        int numWaits = 0;
+        while (!pushImpl(time, data, start)) wait(numWaits);
+    }
+
+    /// Push a row to the end of the queue without waiting. Returns false (and
+    /// the row is not pushed) if the queue is full and the policy is
+    /// Backpressure.
+    /// @throws Exception if the row does not have getRowSize() elements.
+    bool try_push_back(double time, const SimTK::RowVectorView_<T>& data) {
+        const auto start = std::chrono::steady_clock::now();
+        while (!pushImpl(time, data, start)) {
+            if (m_policy == OverflowPolicy::Backpressure) {
+                m_numRejected.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            // The consumer is reading the oldest row and will make room.
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+    /// Pop the row at the front of the queue, waiting for the producer if the
+    /// queue is empty.
+    void pop_front(double& time, SimTK::RowVector_<T>& data) {
+        int numWaits = 0;
+        while (!try_pop_front(time, data)) wait(numWaits);
+    }
+
+    /// Pop the row at the front of the queue without waiting. Returns false
+    /// if the queue is empty.
+    bool try_pop_front(double& time, SimTK::RowVector_<T>& data) {
+        for (;;) {
+            const std::uint64_t tail = m_tail.load(std::memory_order_acquire);
+            if (tail == m_head.load(std::memory_order_acquire)) return false;
+            const int slot = int(tail % m_capacity);
+            // The producer holds the slot while it discards its row.
+            int expected = Free;
+            if (!m_slotStates[slot].compare_exchange_strong(expected, Reading,
+                        std::memory_order_acquire)) {
+                std::this_thread::yield();
+                continue;
+            }
+            // The row was discarded before we acquired the slot.
+            if (m_tail.load(std::memory_order_acquire) != tail) {
+                m_slotStates[slot].store(Free, std::memory_order_release);
+                continue;
+            }
+            // The row size was set before the first row was pushed.
+            const int rowSize = m_rowSize.load(std::memory_order_relaxed);
+            time = m_times[slot];
+            data.resize(rowSize);
+            const T* row = &m_data[std::size_t(slot) * rowSize];
+            for (int i = 0; i < rowSize; ++i) data[i] = row[i];
+            const auto pushStart = m_pushStarts[slot];
+            m_tail.store(tail + 1, std::memory_order_release);
+            m_slotStates[slot].store(Free, std::memory_order_release);
+
+            const std::int64_t latency =
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - pushStart)
+                            .count();
+            m_totalLatency.fetch_add(latency, std::memory_order_relaxed);
+            if (latency > m_maxLatency.load(std::memory_order_relaxed)) {
+                m_maxLatency.store(latency, std::memory_order_relaxed);
+            }
+            m_numPopped.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    Statistics getStatistics() const {
+        Statistics stats;
+        stats.numPushed = m_numPushed.load(std::memory_order_relaxed);
+        stats.numPopped = m_numPopped.load(std::memory_order_relaxed);
+        stats.numDropped = m_numDropped.load(std::memory_order_relaxed);
+        stats.numRejected = m_numRejected.load(std::memory_order_relaxed);
+        if (stats.numPopped > 0) {
+            stats.meanLatency =
+                    1e-9 * m_totalLatency.load(std::memory_order_relaxed) /
+                    stats.numPopped;
+        }
+        stats.maxLatency = 1e-9 * m_maxLatency.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    enum SlotState { Free = 0, Reading = 1, Discarding = 2 };
+
+    void allocate() {
+        m_data.assign(std::size_t(m_capacity) * getRowSize(), T());
+        m_times.assign(m_capacity, SimTK::NaN);
+        m_pushStarts.assign(m_capacity, std::chrono::steady_clock::now());
+        m_slotStates.reset(new std::atomic<int>[m_capacity]);
+        for (int i = 0; i < m_capacity; ++i) m_slotStates[i].store(Free);
+        m_head.store(0);
+        m_tail.store(0);
+        m_numPushed.store(0);
+        m_numPopped.store(0);
+        m_numDropped.store(0);
+        m_numRejected.store(0);
+        m_totalLatency.store(0);
+        m_maxLatency.store(0);
+    }
+
+    void copyContents(const BoundedDataQueue_& other) {
+        const std::uint64_t tail = other.m_tail.load();
+        const std::uint64_t head = other.m_head.load();
+        m_data = other.m_data;
+        m_times = other.m_times;
+        m_pushStarts = other.m_pushStarts;
+        m_head.store(head);
+        m_tail.store(tail);
+    }
+
+    bool pushImpl(double time, const SimTK::RowVectorView_<T>& data,
+            std::chrono::steady_clock::time_point start) {
+        const std::uint64_t head = m_head.load(std::memory_order_relaxed);
+        int rowSize = m_rowSize.load(std::memory_order_relaxed);
+        if (rowSize == 0 && head == 0) {
+            // Nothing has been pushed, so the consumer does not access the
+            // storage until it sees the new head.
+            rowSize = data.size();
+            m_data.assign(std::size_t(m_capacity) * rowSize, T());
+            m_rowSize.store(rowSize, std::memory_order_release);
+        }
+        OPENSIM_THROW_IF(data.size() != rowSize, Exception,
+                "Expected a row with {} elements, but it has {} elements.",
+                rowSize, data.size());
+        const int slot = int(head % m_capacity);
+        bool discarding = false;
+        if (head - m_tail.load(std::memory_order_acquire) ==
+                std::uint64_t(m_capacity)) {
+            if (m_policy == OverflowPolicy::Backpressure) return false;
+            // The oldest row occupies the slot we write to. If the consumer is
+            // reading it, the consumer is about to make room.
+            int expected = Free;
+            if (!m_slotStates[slot].compare_exchange_strong(expected,
+                        Discarding, std::memory_order_acquire)) {
+                return false;
+            }
+            // Only the holder of the slot at the tail can move the tail.
+            std::uint64_t tail = head - m_capacity;
+            if (m_tail.compare_exchange_strong(tail, tail + 1,
+                        std::memory_order_acq_rel)) {
+                m_numDropped.fetch_add(1, std::memory_order_relaxed);
+            }
+            discarding = true;
+        }
+        m_times[slot] = time;
+        T* row = &m_data[std::size_t(slot) * rowSize];
+        for (int i = 0; i < rowSize; ++i) row[i] = data[i];
+        m_pushStarts[slot] = start;
+        if (discarding) {
+            m_slotStates[slot].store(Free, std::memory_order_release);
+        }
+        m_head.store(head + 1, std::memory_order_release);
+        m_numPushed.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Spin briefly, then sleep, so that a thread waiting for a slow producer
+    // or consumer does not occupy a processor.
+    static void wait(int& numWaits) {
+        if (++numWaits < 100) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+
+    int m_capacity;
+    std::atomic<int> m_rowSize;
+    OverflowPolicy m_policy;
+
+    // Rows are stored contiguously, one after another.
+    std::vector<T> m_data;
+    std::vector<double> m_times;
+    std::vector<std::chrono::steady_clock::time_point> m_pushStarts;
+    std::unique_ptr<std::atomic<int>[]> m_slotStates;
+
+    // Total number of rows pushed (written by the producer) and popped or
+    // discarded (the tail). The row at index i is in slot i % capacity.
+    std::atomic<std::uint64_t> m_head{0};
+    std::atomic<std::uint64_t> m_tail{0};
+
+    std::atomic<std::uint64_t> m_numPushed{0};
+    std::atomic<std::uint64_t> m_numPopped{0};
+    std::atomic<std::uint64_t> m_numDropped{0};
+    std::atomic<std::uint64_t> m_numRejected{0};
+    std::atomic<std::int64_t> m_totalLatency{0};
+    std::atomic<std::int64_t> m_maxLatency{0};
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_BOUNDED_DATA_QUEUE_H_
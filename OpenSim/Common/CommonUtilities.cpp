@@ -26,11 +26,15 @@
 #include "PiecewiseLinearFunction.h"
 #include "STOFileAdapter.h"
 #include "TimeSeriesTable.h"
+#include <algorithm>
 #include <chrono>
 #include <ctime>
+#include <exception>
 #include <iomanip>
 #include <memory>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 #include <SimTKcommon/internal/Pathname.h>
 
@@ -183,3 +187,42 @@ SimTK::Real OpenSim::solveBisection(
     }
     return midpoint;
 }
+
+void OpenSim::parallelForChunks(int size, int numThreads,
+        const std::function<void(int, int, int)>& func) {
+    if (size <= 0) return;
+    if (numThreads < 1) {
+        numThreads = std::max((int)std::thread::hardware_concurrency(), 1);
+    }
+    numThreads = std::min(numThreads, size);
+
+    // Distribute the remainder one element at a time to the first chunks.
+    const int chunkSize = size / numThreads;
+    const int remainder = size % numThreads;
+    std::vector<int> begins(numThreads + 1, 0);
+    for (int ithread = 0; ithread < numThreads; ++ithread) {
+        begins[ithread + 1] = begins[ithread] + chunkSize +
+                              (ithread < remainder ? 1 : 0);
+    }
+
+    std::vector<std::exception_ptr> exceptions(numThreads);
+    auto runChunk = [&](int ithread) {
+        try {
+            func(ithread, begins[ithread], begins[ithread + 1]);
+        } catch (...) {
+            exceptions[ithread] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads - 1);
+    for (int ithread = 1; ithread < numThreads; ++ithread) {
+        threads.emplace_back(runChunk, ithread);
+    }
+    runChunk(0);
+    for (auto& thread : threads) thread.join();
+
+    for (const auto& exception : exceptions) {
+        if (exception) std::rethrow_exception(exception);
+    }
+}
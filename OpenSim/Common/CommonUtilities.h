@@ -24,11 +24,13 @@
  * -------------------------------------------------------------------------- */
 
 #include "osimCommonDLL.h"
+#include <algorithm>
 #include <functional>
 #include <iostream>
 #include <memory>
 #include <mutex>
-#include <stack>
+#include <thread>
+#include <vector>
 #include <condition_variable>
 
 #include <SimTKcommon/internal/BigMatrix.h>
@@ -124,10 +126,26 @@ SimTK::Real solveBisection(std::function<double(const double&)> calcResidual,
         double left, double right, const double& tolerance = 1e-6,
         int maxIterations = 1000);
 
+#ifndef SWIG
+/// Split the integers [0, size) into (at most) `numThreads` contiguous chunks
+/// of nearly equal length and call `func(threadIndex, begin, end)` for each
+/// chunk on its own thread; the calling thread processes the first chunk.
+/// `threadIndex` is in [0, numThreads) and can be used to select per-thread
+/// resources (e.g., a copy of a Model). If `numThreads` is less than 1, the
+/// number of hardware threads is used. If any call to `func` throws, the
+/// first exception is rethrown after all threads have finished.
+/// @ingroup commonutil
+OSIMCOMMON_API void parallelForChunks(int size, int numThreads,
+        const std::function<void(int threadIndex, int begin, int end)>& func);
+#endif
+
 /// This class lets you store objects of a single type for reuse by multiple
-/// threads, ensuring threadsafe access to each of those objects.
+/// threads, ensuring threadsafe access to each of those objects. A thread
+/// that takes an object is given, if possible, the object that it left most
+/// recently, so that each thread tends to reuse the same object and whatever
+/// that object has cached (e.g., a Model that was initialized with the
+/// parameter values that the thread used last).
 /// @ingroup commonutil
-// TODO: Find a way to always give the same thread the same object.
 template <typename T> class ThreadsafeJar {
 public:
     /// Request an object for your exclusive use on your thread. This function
@@ -140,16 +158,25 @@ public:
         // Block this thread until the condition variable is woken up
         // (by a notify_...()) and the lambda function returns true.
         m_inventoryMonitor.wait(lock, [this] { return m_entries.size() > 0; });
-        std::unique_ptr<T> top = std::move(m_entries.top());
-        m_entries.pop();
-        return top;
+        // Search from the most recently left object.
+        const auto thisThread = std::this_thread::get_id();
+        auto it = std::find_if(m_entries.rbegin(), m_entries.rend(),
+                [&thisThread](const Entry& entry) {
+                    return entry.lastThread == thisThread;
+                });
+        const auto index = it == m_entries.rend()
+                                   ? m_entries.size() - 1
+                                   : m_entries.rend() - it - 1;
+        std::unique_ptr<T> entry = std::move(m_entries[index].object);
+        m_entries.erase(m_entries.begin() + index);
+        return entry;
     }
     /// Add or return an object so that another thread can use it. You will need
     /// to std::move() the entry, ensuring that you will no longer have access
     /// to the entry in your code (the pointer will now be null).
     void leave(std::unique_ptr<T> entry) {
         std::unique_lock<std::mutex> lock(m_mutex);
-        m_entries.push(std::move(entry));
+        m_entries.push_back({std::move(entry), std::this_thread::get_id()});
         lock.unlock();
         m_inventoryMonitor.notify_one();
     }
@@ -160,7 +187,12 @@ public:
     }
 
 private:
-    std::stack<std::unique_ptr<T>> m_entries;
+    struct Entry {
+        std::unique_ptr<T> object;
+        /// The thread that left this object.
+        std::thread::id lastThread;
+    };
+    std::vector<Entry> m_entries;
     mutable std::mutex m_mutex;
     std::condition_variable m_inventoryMonitor;
 };
@@ -89,6 +89,11 @@ public:
     {
         return _value;
     }
+    double calcValue(double xUnused) const override { return _value; }
+    double calcDerivative(double xUnused, int order) const override
+    {
+        return order == 0 ? _value : 0.0;
+    }
     double getValue() const { return _value; }
     SimTK::Function* createSimTKFunction() const override;
 //=============================================================================
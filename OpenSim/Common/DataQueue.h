@@ -54,11 +54,13 @@ public:
     virtual ~DataQueueEntry_(){};
 
     double getTimeStamp() const { return _timeStamp; };
-    SimTK::RowVectorView_<U> getData() const { return _data; };
+    const SimTK::RowVector_<U>& getData() const { return _data; };
 
 private:
     double _timeStamp;
-    SimTK::RowVectorView_<U> _data;
+    // A deep copy of the data, so the entry does not refer to (or leak)
+    // storage owned by someone else.
+    SimTK::RowVector_<U> _data;
 };
 /**
  * DataQueue is a wrapper around the std::queue customized to handle data 
@@ -98,9 +100,9 @@ public:
     //--------------------------------------------------------------------------
     // push data and associated timestamp to the end of the queue
     void push_back(const double time, const SimTK::RowVectorView_<T>& data) { 
-        SimTK::RowVector_<T>* deepCopy = new SimTK::RowVector_<T>(data);
+        DataQueueEntry_<T> entry(time, data);
         std::unique_lock<std::mutex> mlock(m_mutex);
-        m_data_queue.push(DataQueueEntry_<T>(time, *deepCopy));
+        m_data_queue.push(std::move(entry));
         mlock.unlock();     // unlock before notificiation to minimize mutex con
         m_cond.notify_one(); 
     }
@@ -108,7 +110,7 @@ public:
     void pop_front(double& time, SimTK::RowVector_<T>& data) { 
         std::unique_lock<std::mutex> mlock(m_mutex);
         while (m_data_queue.empty()) { m_cond.wait(mlock); }
-        DataQueueEntry_<SimTK::Rotation> frontEntry = m_data_queue.front();
+        DataQueueEntry_<T> frontEntry = std::move(m_data_queue.front());
         m_data_queue.pop();
         mlock.unlock(); 
         time = frontEntry.getTimeStamp();
@@ -34,6 +34,7 @@ in-memory container for data access and manipulation.                         */
 #include "SimTKcommon/internal/Quaternion.h"
 #include <OpenSim/Common/IO.h>
 
+#include <algorithm>
 #include <iomanip>
 #include <numeric>
 
@@ -662,15 +663,36 @@ public:
                              static_cast<size_t>(depRow.ncol()));
         }
 
+        const int row = static_cast<int>(_indData.size());
+        if(_depData.nrow() == 0) {
+            _depData.resize(std::max(_numReservedRows, 1), depRow.size());
+        } else if(row == _depData.nrow()) {
+            // Grow geometrically so that appending N rows copies the matrix
+            // O(log N) times instead of N times. Const accessors view only
+            // the first getNumRows() rows; the spare rows are released by
+            // the mutators that need an exact matrix (see
+            // releaseSpareRows()).
+            _depData.resizeKeep(std::max(2 * row, _numReservedRows),
+                                _depData.ncol());
+        }
+        _depData.updRow(row) = depRow;
         _indData.push_back(indRow);
+    }
 
-        if(_depData.nrow() == 0) {
-            _depData.resize(1, depRow.size());
+    /** Allocate storage for (at least) the given total number of rows, so
+    that appending rows up to this number does not reallocate the underlying
+    matrix. Appended rows are stored in spare rows at the end of the
+    underlying matrix. Const accessors (e.g., getMatrix() or
+    getDependentColumn()) view only the rows of the table and do not modify
+    the storage; the spare rows are released (with one copy of the matrix) by
+    mutators that change the shape of the matrix or return writable views of
+    entire columns or the matrix (e.g., appendColumn() or updMatrix()).      */
+    void reserve(size_t numRows) {
+        _numReservedRows = std::max(_numReservedRows,
+                                    static_cast<int>(numRows));
+        if(_depData.nrow() > 0 && _depData.nrow() < _numReservedRows) {
+            _depData.resizeKeep(_numReservedRows, _depData.ncol());
         }
-        else 
-            _depData.resizeKeep(_depData.nrow() + 1, _depData.ncol());
-            
-        _depData.updRow(_depData.nrow() - 1) = depRow;
     }
 
     /** Get row at index.                                                     
@@ -789,7 +811,8 @@ public:
             for(size_t r = index; r < getNumRows() - 1; ++r)
                 _depData.updRow((int)r) = _depData.row((int)(r + 1));
         
-        _depData.resizeKeep(_depData.nrow() - 1, _depData.ncol());
+        _depData.resizeKeep(static_cast<int>(_indData.size()) - 1,
+                            _depData.ncol());
         _indData.erase(_indData.begin() + index);
     }
 
@@ -943,6 +966,7 @@ public:
                          static_cast<size_t>(getNumRows()),
                          static_cast<size_t>(depCol.nrow()));
         
+        releaseSpareRows();
         _depData.resizeKeep(_depData.nrow(), _depData.ncol() + 1);
         _depData.updCol(_depData.ncol() - 1) = depCol;
         appendColumnLabel(columnLabel);
@@ -956,6 +980,8 @@ public:
             ColumnIndexOutOfRange,
             index, 0, static_cast<unsigned>(_depData.ncol() - 1));
 
+        releaseSpareRows();
+
         // get copy of labels
         auto labels = getColumnLabels();
 
@@ -998,7 +1024,7 @@ public:
                          ColumnIndexOutOfRange, index, 0,
                          static_cast<size_t>(_depData.ncol() - 1));
 
-        return _depData.col(static_cast<int>(index));
+        return getDependentColumnView(static_cast<int>(index));
     }
 
     /** Get dependent Column which has the given column label.                
@@ -1006,7 +1032,8 @@ public:
     \throws KeyNotFound If columnLabel is not found to be label of any existing
                         column.                                               */
     VectorView getDependentColumn(const std::string& columnLabel) const {
-        return _depData.col(static_cast<int>(getColumnIndex(columnLabel)));
+        return getDependentColumnView(
+                static_cast<int>(getColumnIndex(columnLabel)));
     }
 
     /** Update dependent column at index.
@@ -1020,6 +1047,7 @@ public:
                          ColumnIndexOutOfRange, index, 0,
                          static_cast<size_t>(_depData.ncol() - 1));
 
+        releaseSpareRows();
         return _depData.updCol(static_cast<int>(index));
     }
 
@@ -1028,6 +1056,7 @@ public:
     \throws KeyNotFound If columnLabel is not found to be label of any existing
                         column.                                               */
     VectorView updDependentColumn(const std::string& columnLabel) {
+        releaseSpareRows();
         return _depData.updCol(static_cast<int>(getColumnIndex(columnLabel)));
     }
 
@@ -1056,8 +1085,9 @@ public:
     /// @{
 
     /** Get a read-only view to the underlying matrix.                        */
-    const MatrixView& getMatrix() const {
-        return _depData.getAsMatrixView();
+    MatrixView getMatrix() const {
+        return _depData.block(0, 0, static_cast<int>(_indData.size()),
+                              _depData.ncol());
     }
 
     /** Get a read-only view of a block of the underlying matrix.             
@@ -1079,11 +1109,11 @@ public:
         OPENSIM_THROW_IF(isRowIndexOutOfRange(rowStart),
                          RowIndexOutOfRange,
                          rowStart, 0, 
-                         static_cast<unsigned>(_depData.nrow() - 1));
+                         static_cast<unsigned>(_indData.size() - 1));
         OPENSIM_THROW_IF(isRowIndexOutOfRange(rowStart + numRows - 1),
                          RowIndexOutOfRange,
                          rowStart + numRows - 1, 0, 
-                         static_cast<unsigned>(_depData.nrow() - 1));
+                         static_cast<unsigned>(_indData.size() - 1));
         OPENSIM_THROW_IF(isColumnIndexOutOfRange(columnStart),
                          ColumnIndexOutOfRange,
                          columnStart, 0, 
@@ -1101,6 +1131,7 @@ public:
 
     /** Get a writable view to the underlying matrix.                         */
     MatrixView& updMatrix() {
+        releaseSpareRows();
         return _depData.updAsMatrixView();
     }
 
@@ -1123,11 +1154,11 @@ public:
         OPENSIM_THROW_IF(isRowIndexOutOfRange(rowStart),
                          RowIndexOutOfRange,
                          rowStart, 0, 
-                         static_cast<unsigned>(_depData.nrow() - 1));
+                         static_cast<unsigned>(_indData.size() - 1));
         OPENSIM_THROW_IF(isRowIndexOutOfRange(rowStart + numRows - 1),
                          RowIndexOutOfRange,
                          rowStart + numRows - 1, 0, 
-                         static_cast<unsigned>(_depData.nrow() - 1));
+                         static_cast<unsigned>(_indData.size() - 1));
         OPENSIM_THROW_IF(isColumnIndexOutOfRange(columnStart),
                          ColumnIndexOutOfRange,
                          columnStart, 0, 
@@ -1545,6 +1576,24 @@ protected:
         return getNumRows() == 0 || getNumColumns() == 0;
     }
 
+    /** Remove the spare rows that appendRow() and reserve() allocate at the
+    end of the underlying matrix, so that it has getNumRows() rows. Only
+    mutators call this; const accessors must not modify the storage, since
+    they may be called concurrently and callers may hold views into it.      */
+    void releaseSpareRows() {
+        if(_depData.nrow() != static_cast<int>(_indData.size())) {
+            _depData.resizeKeep(static_cast<int>(_indData.size()),
+                                _depData.ncol());
+        }
+    }
+
+    /** View of the first getNumRows() rows of a column of the underlying
+    matrix, which may have spare rows.                                       */
+    VectorView getDependentColumnView(int index) const {
+        return _depData.block(0, index, static_cast<int>(_indData.size()), 1)
+                .col(0);
+    }
+
     /** Check if row index is out of range.                                   */
     bool isRowIndexOutOfRange(size_t index) const {
         return index >= _indData.size();
@@ -1557,7 +1606,7 @@ protected:
 
     /** Get number of rows.                                                   */
     size_t implementGetNumRows() const override {
-        return _depData.nrow();
+        return _indData.size();
     }
 
     /** Get number of columns.                                                */
@@ -1662,7 +1711,11 @@ protected:
     }
 
     std::vector<ETX>    _indData;
+    // May have spare rows beyond the number of rows of the table (see
+    // appendRow()). Const accessors view only the first getNumRows() rows;
+    // mutators use releaseSpareRows() before changing entire columns.
     SimTK::Matrix_<ETY> _depData;
+    int                 _numReservedRows{0};
 };  // DataTable_
 
 
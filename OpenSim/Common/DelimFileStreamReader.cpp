@@ -0,0 +1,265 @@
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  DelimFileStreamReader.cpp                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "DelimFileStreamReader.h"
+
+#include "DelimFileAdapter.h"
+#include "FileAdapter.h"
+#include "IO.h"
+#include "MemoryMappedFile.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <regex>
+
+using namespace OpenSim;
+
+namespace {
+    // Size of the read buffer. The buffer grows if a single line is longer.
+    const std::size_t initialBufferSize = 1 << 20;
+}
+
+DelimFileStreamReader::DelimFileStreamReader(const std::string& fileName,
+                                             int blockSize,
+                                             bool useMemoryMapping) :
+    DelimFileStreamReader(fileName,
+            FileAdapter::findExtension(fileName) == "csv" ? "," : "\t",
+            blockSize, useMemoryMapping) {}
+
+DelimFileStreamReader::DelimFileStreamReader(const std::string& fileName,
+                                             const std::string& delimiters,
+                                             int blockSize,
+                                             bool useMemoryMapping) :
+    _fileName{fileName}, _delimiters{delimiters}, _blockSize{blockSize} {
+    OPENSIM_THROW_IF(fileName.empty(), EmptyFileName);
+    OPENSIM_THROW_IF(blockSize < 1, Exception,
+            "Expected blockSize to be positive, but got {}.", blockSize);
+    OPENSIM_THROW_IF(delimiters.empty(), Exception,
+            "Expected at least one delimiter.");
+    open(useMemoryMapping);
+    readHeader();
+}
+
+DelimFileStreamReader::~DelimFileStreamReader() = default;
+
+void DelimFileStreamReader::open(bool useMemoryMapping) {
+    if (useMemoryMapping) {
+        _mappedFile.reset(new MemoryMappedFile(_fileName, true));
+        return;
+    }
+
+    _stream.open(_fileName, std::ios::binary);
+    OPENSIM_THROW_IF(!_stream.good(), FileDoesNotExist, _fileName);
+    OPENSIM_THROW_IF(_stream.peek() == std::ifstream::traits_type::eof(),
+                     FileIsEmpty, _fileName);
+    _buffer.resize(initialBufferSize);
+}
+
+bool DelimFileStreamReader::nextLine() {
+    const char* begin = nullptr;
+    const char* end = nullptr;
+    if (_mappedFile) {
+        const char* data = _mappedFile->getData();
+        const std::size_t size = _mappedFile->getSize();
+        if (_mappedPos >= size) return false;
+        begin = data + _mappedPos;
+        const auto* newline = static_cast<const char*>(
+                std::memchr(begin, '\n', size - _mappedPos));
+        end = newline ? newline : data + size;
+        _mappedPos = (end - data) + 1;
+    } else {
+        while (true) {
+            char* data = _buffer.data();
+            begin = data + _bufferBegin;
+            const auto* newline = static_cast<const char*>(
+                    std::memchr(begin, '\n', _bufferEnd - _bufferBegin));
+            if (newline) {
+                end = newline;
+                _bufferBegin = (newline - data) + 1;
+                break;
+            }
+            if (_streamExhausted) {
+                if (_bufferBegin == _bufferEnd) return false;
+                end = data + _bufferEnd;
+                _bufferBegin = _bufferEnd;
+                break;
+            }
+            // Move the partial line to the front of the buffer, and grow the
+            // buffer if the line fills it.
+            const std::size_t partial = _bufferEnd - _bufferBegin;
+            std::memmove(data, begin, partial);
+            _bufferBegin = 0;
+            _bufferEnd = partial;
+            if (_bufferEnd == _buffer.size()) {
+                _buffer.resize(2 * _buffer.size());
+                data = _buffer.data();
+            }
+            _stream.read(data + _bufferEnd,
+                    static_cast<std::streamsize>(_buffer.size() - _bufferEnd));
+            const auto numRead = static_cast<std::size_t>(_stream.gcount());
+            _bufferEnd += numRead;
+            if (numRead == 0 || !_stream) _streamExhausted = true;
+        }
+    }
+
+    // Get rid of the extra \r if parsing a file with CRLF line endings.
+    if (end > begin && *(end - 1) == '\r') --end;
+    _line.assign(begin, end);
+    ++_lineNumber;
+    return true;
+}
+
+void DelimFileStreamReader::readHeader() {
+    // This follows DelimFileAdapter::extendRead().
+    const std::string endHeaderString = "endheader";
+    std::regex endheader{R"([ \t]*)" + endHeaderString + R"([ \t]*)"};
+    std::regex keyvalue{R"((.*)=(.*))"};
+    std::string header{};
+    while (nextLine()) {
+        if (std::regex_match(_line, endheader)) break;
+
+        std::smatch matchRes{};
+        if (std::regex_match(_line, matchRes, keyvalue)) {
+            auto key = matchRes[1].str();
+            auto value = matchRes[2].str();
+            IO::TrimWhitespace(value);
+            if (!key.empty() && !value.empty()) {
+                auto trimmedKey = key;
+                IO::TrimWhitespace(trimmedKey);
+                if (trimmedKey == "DataType") {
+                    OPENSIM_THROW_IF(value != "double", DataTypeMismatch,
+                                     "double", value);
+                } else if (trimmedKey != "version" &&
+                           trimmedKey != "OpenSimVersion") {
+                    _metadata.setValueForKey(key, value);
+                }
+                continue;
+            }
+        }
+
+        if (header.empty())
+            header = _line;
+        else
+            header += "\n" + _line;
+    }
+    _metadata.setValueForKey("header", header);
+
+    // Column labels are on the first line after the header that has any.
+    while (_columnLabels.empty() && nextLine()) {
+        _columnLabels = FileAdapter::tokenize(_line, _delimiters);
+        IO::eraseEmptyElements(_columnLabels);
+    }
+    OPENSIM_THROW_IF(_columnLabels.empty(), Exception,
+            "No column labels detected in file '{}'.", _fileName);
+    OPENSIM_THROW_IF(_columnLabels[0] != "time", UnexpectedColumnLabel,
+                     _fileName, "time", _columnLabels[0]);
+    _columnLabels.erase(_columnLabels.begin());
+}
+
+bool DelimFileStreamReader::parseRow(double& time, SimTK::RowVectorView row) {
+    const int ncol = static_cast<int>(_columnLabels.size());
+    const char* delims = _delimiters.c_str();
+    const char* cur = _line.c_str();
+
+    // Parse one field, which must contain a single number surrounded by
+    // optional whitespace. Fields are parsed in place with strtod rather
+    // than being split into strings first.
+    auto isBlank = [&](char c) {
+        return (c == ' ' || c == '\t') && !std::strchr(delims, c);
+    };
+    auto parseField = [&](double& value) {
+        while (isBlank(*cur)) ++cur;
+        char* parseEnd = nullptr;
+        // An empty field is an error, so do not let strtod skip over a
+        // whitespace delimiter to the next field.
+        const bool emptyField = *cur == '\0' || std::strchr(delims, *cur);
+        if (!emptyField) value = std::strtod(cur, &parseEnd);
+        OPENSIM_THROW_IF(emptyField || parseEnd == cur, Exception,
+                "Could not parse a number in line {} of file '{}'.",
+                _lineNumber, _fileName);
+        cur = parseEnd;
+        while (isBlank(*cur)) ++cur;
+        OPENSIM_THROW_IF(*cur != '\0' && !std::strchr(delims, *cur),
+                Exception,
+                "Could not parse a number in line {} of file '{}'.",
+                _lineNumber, _fileName);
+        if (*cur != '\0') ++cur;
+    };
+
+    // An empty line marks the end of the data, as in DelimFileAdapter.
+    std::size_t firstNonBlank = _line.find_first_not_of(" \t");
+    if (firstNonBlank == std::string::npos) return false;
+
+    parseField(time);
+    int numFields = 0;
+    while (*cur != '\0') {
+        double value;
+        parseField(value);
+        if (numFields < ncol) row[numFields] = value;
+        ++numFields;
+    }
+    OPENSIM_THROW_IF(numFields != ncol, RowLengthMismatch, _fileName,
+                     _lineNumber, static_cast<std::size_t>(ncol),
+                     static_cast<std::size_t>(numFields));
+    return true;
+}
+
+bool DelimFileStreamReader::readNextBlock(Block& block) {
+    const int ncol = static_cast<int>(_columnLabels.size());
+    block.firstRowIndex = _numRowsRead;
+    block.times.clear();
+    if (block.values.nrow() != _blockSize || block.values.ncol() != ncol) {
+        block.values.resize(_blockSize, ncol);
+    }
+
+    int numRows = 0;
+    while (numRows < _blockSize && !_endOfData) {
+        if (!nextLine()) {
+            _endOfData = true;
+            break;
+        }
+        double time;
+        if (!parseRow(time, block.values.updRow(numRows))) {
+            _endOfData = true;
+            break;
+        }
+        block.times.push_back(time);
+        ++numRows;
+    }
+    _numRowsRead += numRows;
+
+    if (numRows < _blockSize) block.values.resizeKeep(numRows, ncol);
+    return numRows > 0;
+}
+
+std::size_t DelimFileStreamReader::forEachBlock(
+        const std::function<void(const Block&)>& func) {
+    const std::size_t initialNumRowsRead = _numRowsRead;
+    Block block;
+    while (readNextBlock(block)) func(block);
+    return _numRowsRead - initialNumRowsRead;
+}
+
+TimeSeriesTable DelimFileStreamReader::createTable(const Block& block) const {
+    TimeSeriesTable table(block.times, block.values, _columnLabels);
+    table.updTableMetaData() = _metadata;
+    return table;
+}
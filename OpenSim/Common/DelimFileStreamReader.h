@@ -0,0 +1,150 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  DelimFileStreamReader.h                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#ifndef OPENSIM_DELIM_FILE_STREAM_READER_H_
+#define OPENSIM_DELIM_FILE_STREAM_READER_H_
+
+#include "osimCommonDLL.h"
+#include "TimeSeriesTable.h"
+
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+class MemoryMappedFile;
+
+/** DelimFileStreamReader reads the rows of an STO, MOT, or CSV file of
+doubles (the files that STOFileAdapter and CSVFileAdapter read into a
+TimeSeriesTable) in blocks of a fixed number of rows, so that files that are
+too large to hold in memory can be processed with constant memory.
+
+The header (metadata and column labels) is parsed when the reader is
+constructed. Rows are then read with readNextBlock() or forEachBlock():
+\code
+DelimFileStreamReader reader("long_recording.sto", 4096);
+reader.forEachBlock([&](const DelimFileStreamReader::Block& block) {
+    // block.times[i] is the time of row block.values.row(i).
+});
+\endcode
+Each block reuses the storage of the previous block. Use createTable() to
+wrap a block in a TimeSeriesTable with the file's column labels and metadata.
+
+Rows are parsed in place from a large read buffer (or, optionally, from a
+memory-mapped view of the file) without splitting them into strings, which
+is considerably faster than DelimFileAdapter. As with DelimFileAdapter, the
+data ends at the first empty line.                                            */
+class OSIMCOMMON_API DelimFileStreamReader {
+public:
+    /** A block of consecutive rows from the file.                            */
+    struct Block {
+        /** Index of the first row of this block within the file's data.     */
+        std::size_t firstRowIndex = 0;
+        /** The time column.                                                 */
+        std::vector<double> times;
+        /** The remaining columns; one row per time.                         */
+        SimTK::Matrix values;
+    };
+
+    /** Open the file and parse its header. The column delimiter is a comma
+    for files with the extension .csv and a tab otherwise, as in
+    CSVFileAdapter and STOFileAdapter.
+    @param fileName Path to the file.
+    @param blockSize Maximum number of rows in each block.
+    @param useMemoryMapping Read the file through a memory-mapped view of
+        the file rather than a read buffer. This avoids copying the file into
+        a buffer, and the operating system can page the file in and out as
+        needed.                                                              */
+    DelimFileStreamReader(const std::string& fileName,
+                          int blockSize = 1024,
+                          bool useMemoryMapping = false);
+    /** Same as above, but with the provided column delimiters.              */
+    DelimFileStreamReader(const std::string& fileName,
+                          const std::string& delimiters,
+                          int blockSize,
+                          bool useMemoryMapping);
+
+    DelimFileStreamReader(const DelimFileStreamReader&)            = delete;
+    DelimFileStreamReader& operator=(const DelimFileStreamReader&) = delete;
+    ~DelimFileStreamReader();
+
+    /** Labels of the data columns (not including the time column).          */
+    const std::vector<std::string>& getColumnLabels() const {
+        return _columnLabels;
+    }
+    /** Metadata from the header, as in the table that the file adapters
+    create (including the key "header").                                     */
+    const ValueArrayDictionary& getTableMetaData() const { return _metadata; }
+    int getBlockSize() const { return _blockSize; }
+    /** Number of data rows read so far.                                     */
+    std::size_t getNumRowsRead() const { return _numRowsRead; }
+
+    /** Read up to getBlockSize() rows into `block`. Returns false (and
+    leaves the block empty) if there are no more rows.                       */
+    bool readNextBlock(Block& block);
+
+    /** Call `func` on each of the remaining blocks of the file. Returns the
+    number of rows that were read.                                           */
+    std::size_t forEachBlock(const std::function<void(const Block&)>& func);
+
+    /** Create a TimeSeriesTable containing the rows of the block, with the
+    column labels and metadata of the file.                                  */
+    TimeSeriesTable createTable(const Block& block) const;
+
+private:
+    void open(bool useMemoryMapping);
+    void readHeader();
+    /** Find the next line (without the line ending) in the file. The line
+    is copied into _line, which is null-terminated for the number parser.   */
+    bool nextLine();
+    /** Parse _line into the provided row. Returns false for an empty line. */
+    bool parseRow(double& time, SimTK::RowVectorView row);
+
+    std::string _fileName;
+    std::string _delimiters;
+    int _blockSize;
+
+    std::vector<std::string> _columnLabels;
+    ValueArrayDictionary _metadata;
+
+    // Buffered reading.
+    std::ifstream _stream;
+    std::vector<char> _buffer;
+    std::size_t _bufferBegin = 0;
+    std::size_t _bufferEnd = 0;
+    bool _streamExhausted = false;
+
+    // Memory-mapped reading.
+    std::unique_ptr<MemoryMappedFile> _mappedFile;
+    std::size_t _mappedPos = 0;
+
+    std::string _line;
+    std::size_t _lineNumber = 0;
+    std::size_t _numRowsRead = 0;
+    bool _endOfData = false;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_DELIM_FILE_STREAM_READER_H_
@@ -173,6 +173,18 @@ double Function::calcDerivative(const std::vector<int>& derivComponents, const V
     return _function->calcDerivative(derivComponents, x);
 }
 
+double Function::calcValue(double x) const
+{
+    return calcValue(Vector(1, x));
+}
+
+double Function::calcDerivative(double x, int order) const
+{
+    if (order == 0)
+        return calcValue(x);
+    return calcDerivative(std::vector<int>(order, 0), Vector(1, x));
+}
+
 int Function::getArgumentSize() const
 {
     if (_function == NULL)
@@ -114,6 +114,30 @@ public:
      * @param x                the Vector of input arguments.  Its size must equal the value returned by getArgumentSize().
      */
     virtual double calcDerivative(const std::vector<int>& derivComponents, const SimTK::Vector& x) const;
+    /**
+     * Calculate the value of a function of one variable (getArgumentSize() is
+     * 1) without creating a SimTK::Vector for the argument. This is faster
+     * when the function is evaluated often (e.g., a function of time). The
+     * default implementation calls calcValue(const SimTK::Vector&); functions
+     * of one variable override this to avoid the temporary. Splines start the
+     * search for the interval containing x from the interval found by the
+     * previous call, so monotone sequences of arguments (e.g., the times of a
+     * simulation) are evaluated in constant time.
+     *
+     * @param x the argument.
+     */
+    virtual double calcValue(double x) const;
+    /**
+     * Calculate the derivative of a function of one variable (getArgumentSize()
+     * is 1) without creating a SimTK::Vector for the argument; see
+     * calcValue(double).
+     *
+     * @param x      the argument.
+     * @param order  the order of the derivative; 0 gives the value of the
+     *               function. It must be less than or equal to the value
+     *               returned by getMaxDerivativeOrder().
+     */
+    virtual double calcDerivative(double x, int order) const;
     /**
      * Get the number of components expected in the input vector.
      */
@@ -126,6 +126,7 @@ GCVSpline(int aDegree,int aN,const double *aX,const double *aF,
 
     // FIT THE SPLINE
     _errorVariance = aErrorVariance;
+    fitCoefficients();
 }
 //_____________________________________________________________________________
 /**
@@ -255,6 +256,23 @@ void GCVSpline::updateFromXMLNode(SimTK::Xml::Element& aNode, int versionNumber)
     // Coefficients may not have been specified in the XML file.
     if (_coefficients.getSize() < _x.getSize())
         _coefficients.setSize(_x.getSize());
+
+    fitCoefficients();
+}
+
+//_____________________________________________________________________________
+/**
+ * Fit the spline to the data points, which computes the coefficients. This is
+ * done whenever the data points change, so that evaluating the spline does not
+ * modify it.
+ */
+void GCVSpline::
+fitCoefficients()
+{
+    resetFunction();
+    if (_halfOrder > 0 && _x.getSize() >= getOrder() &&
+            _y.getSize() == _x.getSize())
+        _function = createSimTKFunction();
 }   
 
 //_____________________________________________________________________________
@@ -372,6 +390,8 @@ setDegree(int aDegree)
                 _halfOrder);
         _halfOrder = 4;
     }
+
+    fitCoefficients();
 }
 //_____________________________________________________________________________
 int GCVSpline::
@@ -472,7 +492,7 @@ setX(int aIndex, double aValue)
 {
     if (aIndex >= 0 && aIndex < _x.getSize()) {
         _x[aIndex] = aValue;
-        resetFunction();
+        fitCoefficients();
     } else {
         throw Exception("GCVSpline::setX(): index out of bounds.");
     }
@@ -483,7 +503,7 @@ setY(int aIndex, double aValue)
 {
     if (aIndex >= 0 && aIndex < _y.getSize()) {
         _y[aIndex] = aValue;
-        resetFunction();
+        fitCoefficients();
     } else {
         throw Exception("GCVSpline::setY(): index out of bounds.");
     }
@@ -520,7 +540,7 @@ deletePoint(int aIndex)
        _y.remove(aIndex);
        _weights.remove(aIndex);
        _coefficients.remove(aIndex);
-       resetFunction();
+       fitCoefficients();
        return true;
    }
 
@@ -549,7 +569,7 @@ deletePoints(const Array<int>& indices)
 
         if (pointsDeleted) {
             // Recalculate the coefficients
-            resetFunction();
+            fitCoefficients();
         }
     }
 
@@ -575,11 +595,29 @@ addPoint(double aX, double aY)
     }
 
     // Recalculate the coefficients
-    resetFunction();
+    fitCoefficients();
 
     return i;
 }
 
+double GCVSpline::calcValue(double x) const
+{
+    return calcDerivative(x, 0);
+}
+
+double GCVSpline::calcDerivative(double x, int order) const
+{
+    // The coefficients from fitting the spline (see fitCoefficients()) are
+    // evaluated by splder() in the same way as SimTK::Spline, but starting
+    // the search for the knot interval from the previous one.
+    int interval = _interval.load(std::memory_order_relaxed);
+    double work[8];
+    const double value = splder(order, _halfOrder, _x.getSize(), x, &_x[0],
+            &_coefficients[0], &interval, work);
+    _interval.store(interval, std::memory_order_relaxed);
+    return value;
+}
+
 SimTK::Function* GCVSpline::createSimTKFunction() const {
     int degree = _halfOrder*2-1;
     Vector x(_x.getSize());
@@ -26,6 +26,7 @@
 
 // INCLUDES
 #include "osimCommonDLL.h"
+#include <atomic>
 #include <string>
 #include "PropertyInt.h"
 #include "PropertyDbl.h"
@@ -108,6 +109,10 @@ protected:
     Array<double> &_y;
     /** A workspace used when calculating derivatives of the spline. */
     mutable std::vector<int> _workDeriv;
+    /** The knot interval found by the previous call to calcValue(double) or
+    calcDerivative(double, int), from which the next search starts. It is
+    only a hint, so concurrent evaluations may overwrite each other's. */
+    mutable std::atomic<int> _interval{0};
 
 //=============================================================================
 // METHODS
@@ -145,6 +150,7 @@ private:
     void setupProperties();
     void setEqual(const GCVSpline &aSpline);
     void init(Function* aFunction) override;
+    void fitCoefficients();
 
     //--------------------------------------------------------------------------
     // OPERATORS
@@ -228,6 +234,8 @@ public:
     virtual bool deletePoint(int aIndex);
     virtual bool deletePoints(const Array<int>& indices);
     virtual int addPoint(double aX, double aY);
+    double calcValue(double x) const override;
+    double calcDerivative(double x, int order) const override;
     SimTK::Function* createSimTKFunction() const override;
 
     //--------------------------------------------------------------------------
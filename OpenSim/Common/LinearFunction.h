@@ -101,6 +101,15 @@ public:
     //--------------------------------------------------------------------------
     // EVALUATION
     //--------------------------------------------------------------------------
+    double calcValue(double x) const override
+    {
+        return _coefficients[0] * x + _coefficients[1];
+    }
+    double calcDerivative(double x, int order) const override
+    {
+        if (order == 0) return calcValue(x);
+        return order == 1 ? _coefficients[0] : 0.0;
+    }
     SimTK::Function* createSimTKFunction() const override;
 
 //=============================================================================
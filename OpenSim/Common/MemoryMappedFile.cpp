@@ -0,0 +1,91 @@
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  MemoryMappedFile.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "MemoryMappedFile.h"
+
+#include "FileAdapter.h"
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+using namespace OpenSim;
+
+MemoryMappedFile::MemoryMappedFile(const std::string& fileName,
+                                   bool sequential) {
+    OPENSIM_THROW_IF(fileName.empty(), EmptyFileName);
+#ifdef _WIN32
+    HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ,
+            FILE_SHARE_READ, NULL, OPEN_EXISTING,
+            sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_ATTRIBUTE_NORMAL,
+            NULL);
+    OPENSIM_THROW_IF(file == INVALID_HANDLE_VALUE, FileDoesNotExist,
+            fileName);
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        OPENSIM_THROW(FileIsEmpty, fileName);
+    }
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    OPENSIM_THROW_IF(mapping == NULL, Exception,
+            "Could not memory-map file '{}'.", fileName);
+    // The view keeps the mapping (and the file) open.
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    OPENSIM_THROW_IF(view == NULL, Exception,
+            "Could not memory-map file '{}'.", fileName);
+    _data = static_cast<const char*>(view);
+    _size = static_cast<std::size_t>(size.QuadPart);
+#else
+    const int fd = ::open(fileName.c_str(), O_RDONLY);
+    OPENSIM_THROW_IF(fd < 0, FileDoesNotExist, fileName);
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        OPENSIM_THROW(FileIsEmpty, fileName);
+    }
+    const auto size = static_cast<std::size_t>(info.st_size);
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping keeps the file open.
+    ::close(fd);
+    OPENSIM_THROW_IF(data == MAP_FAILED, Exception,
+            "Could not memory-map file '{}'.", fileName);
+    if (sequential) madvise(data, size, MADV_SEQUENTIAL);
+    _data = static_cast<const char*>(data);
+    _size = size;
+#endif
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+#ifdef _WIN32
+    UnmapViewOfFile(_data);
+#else
+    munmap(const_cast<char*>(_data), _size);
+#endif
+}
@@ -0,0 +1,62 @@
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  MemoryMappedFile.h                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#ifndef OPENSIM_MEMORY_MAPPED_FILE_H_
+#define OPENSIM_MEMORY_MAPPED_FILE_H_
+
+#include "osimCommonDLL.h"
+
+#include <cstddef>
+#include <string>
+
+namespace OpenSim {
+
+/** A read-only view of the contents of a file, mapped into memory by the
+operating system (mmap on POSIX systems, MapViewOfFile on Windows). Pages of
+the file are read from disk as they are accessed, so this can be used for
+files larger than the available memory. The mapping is released when this
+object is destroyed.                                                          */
+class OSIMCOMMON_API MemoryMappedFile {
+public:
+    /** Map the entire file.
+    @param fileName Path to the file.
+    @param sequential Hint to the operating system that the file will be
+        read from beginning to end.
+    @throws FileDoesNotExist If the file cannot be opened.
+    @throws FileIsEmpty If the file is empty (empty files cannot be
+        mapped).                                                             */
+    explicit MemoryMappedFile(const std::string& fileName,
+                              bool sequential = false);
+    MemoryMappedFile(const MemoryMappedFile&)            = delete;
+    MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+    ~MemoryMappedFile();
+
+    const char* getData() const { return _data; }
+    std::size_t getSize() const { return _size; }
+
+private:
+    const char* _data = nullptr;
+    std::size_t _size = 0;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_MEMORY_MAPPED_FILE_H_
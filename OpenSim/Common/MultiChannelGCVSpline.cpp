@@ -0,0 +1,256 @@
+/* -------------------------------------------------------------------------- *
+ *                   OpenSim:  MultiChannelGCVSpline.cpp                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "MultiChannelGCVSpline.h"
+
+#include "Exception.h"
+#include "gcvspl.h"
+
+#include <SimTKmath.h>
+#include <algorithm>
+
+using namespace OpenSim;
+
+MultiChannelGCVSpline::MultiChannelGCVSpline(int degree, int n,
+        const double* x, const std::vector<const double*>& channels,
+        double errorVariance)
+        : m_halfOrder((degree + 1) / 2), m_numChannels((int)channels.size()),
+          m_x(x, x + n) {
+    OPENSIM_THROW_IF(degree != 1 && degree != 3 && degree != 5 && degree != 7,
+            Exception, "Expected degree to be 1, 3, 5, or 7, but got {}.",
+            degree);
+    OPENSIM_THROW_IF(n < degree + 1, Exception,
+            "Expected at least {} knots for a spline of degree {}, but got "
+            "{}.",
+            degree + 1, degree, n);
+    for (int j = 1; j < n; ++j) {
+        OPENSIM_THROW_IF(x[j] <= x[j - 1], Exception,
+                "Expected the knots to be strictly increasing, but x[{}] = {} "
+                "follows x[{}] = {}.",
+                j, x[j], j - 1, x[j - 1]);
+    }
+
+    // Fit each channel as GCVSpline::createSimTKFunction() does.
+    m_coefficients.resize((size_t)n * m_numChannels);
+    const SimTK::Vector knots(n, x);
+    for (int i = 0; i < m_numChannels; ++i) {
+        const SimTK::Vector values(n, channels[i]);
+        const SimTK::Spline spline =
+                errorVariance < 0.0
+                        ? SimTK::SplineFitter<double>::fitFromGCV(
+                                  degree, knots, values)
+                                  .getSpline()
+                        : SimTK::SplineFitter<double>::fitFromErrorVariance(
+                                  degree, knots, values, errorVariance)
+                                  .getSpline();
+        const SimTK::Vector& coefficients = spline.getControlPointValues();
+        for (int j = 0; j < n; ++j) {
+            m_coefficients[j * m_numChannels + i] = coefficients[j];
+        }
+    }
+}
+
+MultiChannelGCVSpline::MultiChannelGCVSpline(
+        const MultiChannelGCVSpline& other)
+        : m_halfOrder(other.m_halfOrder), m_numChannels(other.m_numChannels),
+          m_x(other.m_x), m_coefficients(other.m_coefficients) {}
+
+MultiChannelGCVSpline& MultiChannelGCVSpline::operator=(
+        const MultiChannelGCVSpline& other) {
+    m_halfOrder = other.m_halfOrder;
+    m_numChannels = other.m_numChannels;
+    m_x = other.m_x;
+    m_coefficients = other.m_coefficients;
+    m_interval.store(0, std::memory_order_relaxed);
+    return *this;
+}
+
+// This is splder() from gcvspl.c, with each entry of the evaluation tableau
+// replaced by a row with an entry for each of the nc channels, whose
+// coefficients start at c, with the given stride between knots. The
+// operations on each channel are the same as splder()'s, so the channels
+// evaluate to the same values as GCVSpline. The indices below follow
+// splder(). l is the knot interval, and q is a workspace of 2 m nc entries.
+static void calcDerivativesOfBlock(const double* x, int n, int m,
+        const double* c, int stride, int nc, double t, int ider, int l,
+        double* q, double* values) {
+    const int m2 = 2 * m;
+    const int k = m2 - ider;
+    // Row i of the tableau, with an entry for each channel.
+    auto row = [q, nc](int i) { return q + i * nc; };
+
+    // Initialize the first row of the B-spline coefficients tableau.
+    const int mp1 = m + 1;
+    const int npm = n + m;
+    const int m2m1 = m2 - 1;
+    const int k1 = k - 1;
+    const int nk = n - k;
+    const int lk1 = l - k + 1;
+    int jl = l + 1;
+    const int ju = l + m2;
+    int ii = n - m2;
+    int ml = -l;
+    for (int j = jl; j <= ju; ++j) {
+        double* qj = row(j + ml - 1);
+        if (j >= mp1 && j <= npm) {
+            const double* cj = c + (j - m - 1) * stride;
+            for (int ic = 0; ic < nc; ++ic) qj[ic] = cj[ic];
+        } else {
+            for (int ic = 0; ic < nc; ++ic) qj[ic] = 0.0;
+        }
+    }
+
+    // Differences of the B-spline coefficients, for derivatives.
+    if (ider > 0) {
+        jl -= m2;
+        ml += m2;
+        for (int i = 1; i <= ider; ++i) {
+            ++jl;
+            ++ii;
+            const int j1 = std::max(1, jl);
+            const int j2 = std::min(l, ii);
+            const int mi = m2 - i;
+            int j = j2 + 1;
+            for (int jin = j1; jin <= j2; ++jin) {
+                --j;
+                const int jm = ml + j;
+                const double d = x[j + mi - 1] - x[j - 1];
+                double* a = row(jm - 1);
+                const double* b = row(jm - 2);
+                for (int ic = 0; ic < nc; ++ic) a[ic] = (a[ic] - b[ic]) / d;
+            }
+            if (jl < 1) {
+                j = ml + 1;
+                for (int jin = i + 1; jin <= ml; ++jin) {
+                    --j;
+                    double* a = row(j - 1);
+                    const double* b = row(j - 2);
+                    for (int ic = 0; ic < nc; ++ic) a[ic] = -b[ic];
+                }
+            }
+        }
+        for (int j = 1; j <= k; ++j) {
+            double* a = row(j - 1);
+            const double* b = row(j + ider - 1);
+            for (int ic = 0; ic < nc; ++ic) a[ic] = b[ic];
+        }
+    }
+
+    // Compute the lower half of the evaluation tableau.
+    for (int i = 1; i <= k1; ++i) {
+        const int nki = nk + i;
+        const int ki = k - i;
+        int ir = k;
+        int jj = l;
+
+        // Right-hand B-splines.
+        for (int j = nki + 1; j <= l; ++j) {
+            const double s = t - x[jj - 1];
+            double* a = row(ir - 1);
+            const double* b = row(ir - 2);
+            for (int ic = 0; ic < nc; ++ic) a[ic] = b[ic] + s * a[ic];
+            --jj;
+            --ir;
+        }
+
+        // Middle B-splines.
+        const int lk1i = lk1 + i;
+        const int j1 = std::max(1, lk1i);
+        const int j2 = std::min(l, nki);
+        for (int j = j1; j <= j2; ++j) {
+            const double xjki = x[jj + ki - 1];
+            const double s = xjki - t;
+            const double d = xjki - x[jj - 1];
+            double* a = row(ir - 1);
+            const double* b = row(ir - 2);
+            for (int ic = 0; ic < nc; ++ic) {
+                const double z = a[ic];
+                a[ic] = z + s * (b[ic] - z) / d;
+            }
+            --ir;
+            --jj;
+        }
+
+        // Left-hand B-splines.
+        if (lk1i <= 0) {
+            jj = ki;
+            for (int j = 1; j <= 1 - lk1i; ++j) {
+                const double s = x[jj - 1] - t;
+                double* a = row(ir - 1);
+                const double* b = row(ir - 2);
+                for (int ic = 0; ic < nc; ++ic) a[ic] = a[ic] + s * b[ic];
+                --jj;
+                --ir;
+            }
+        }
+    }
+
+    // Multiply derivatives by the factorial of ider.
+    const double* z = row(k - 1);
+    for (int ic = 0; ic < nc; ++ic) {
+        double value = z[ic];
+        if (ider > 0) {
+            for (int j = k; j <= m2m1; ++j) value *= j;
+        }
+        values[ic] = value;
+    }
+}
+
+void MultiChannelGCVSpline::calcDerivatives(double t, int ider,
+        double* values, int firstChannel, int numChannels) const {
+    if (numChannels == -1) numChannels = m_numChannels - firstChannel;
+    OPENSIM_THROW_IF(firstChannel < 0 || numChannels < 0 ||
+                             firstChannel + numChannels > m_numChannels,
+            Exception,
+            "Expected {} channels starting at channel {}, but there are {} "
+            "channels.",
+            numChannels, firstChannel, m_numChannels);
+    OPENSIM_THROW_IF(ider < 0, Exception,
+            "Expected a non-negative derivative order, but got {}.", ider);
+
+    const double* x = m_x.data();
+    const int n = (int)m_x.size();
+
+    // Derivatives of order 2m or more are zero.
+    if (2 * m_halfOrder - ider < 1) {
+        std::fill(values, values + numChannels, 0.0);
+        return;
+    }
+
+    // Search for the interval, starting from the previous one. The interval
+    // is only a hint, so concurrent evaluations may overwrite each other's.
+    int l = m_interval.load(std::memory_order_relaxed);
+    search(n, const_cast<double*>(x), t, &l);
+    m_interval.store(l, std::memory_order_relaxed);
+
+    // The tableau is local, so that evaluations do not modify the spline;
+    // the channels are evaluated in blocks so that it has a fixed size.
+    double q[2 * MaxHalfOrder * MaxBlockSize];
+    for (int first = 0; first < numChannels; first += MaxBlockSize) {
+        const int nc = numChannels - first < MaxBlockSize
+                               ? numChannels - first
+                               : MaxBlockSize;
+        calcDerivativesOfBlock(x, n, m_halfOrder,
+                m_coefficients.data() + firstChannel + first, m_numChannels,
+                nc, t, ider, l, q, values + first);
+    }
+}
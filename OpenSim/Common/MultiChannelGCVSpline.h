@@ -0,0 +1,97 @@
+#ifndef OPENSIM_MULTI_CHANNEL_GCV_SPLINE_H_
+#define OPENSIM_MULTI_CHANNEL_GCV_SPLINE_H_
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  MultiChannelGCVSpline.h                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimCommonDLL.h"
+
+#include <atomic>
+#include <vector>
+
+namespace OpenSim {
+
+/** Splines through several channels of data sampled at the same knots (e.g.,
+the columns of a file of ground reaction forces), evaluated together. Each
+channel is fit as a GCVSpline of the same degree and error variance would be,
+and evaluates to the same values, but all channels share one search for the
+knot interval, and the spline arithmetic is done on all of the requested
+channels at once. The coefficients are stored knot by knot, with the channels
+contiguous, so the loops over channels can be vectorized by the compiler.
+
+As in GCVSpline, the search for the knot interval starts from the interval of
+the previous evaluation, so evaluating at increasing (or decreasing) times is
+fast. The interval is only a hint, and the evaluation workspace is local, so
+an instance may be evaluated from multiple threads at once.
+@code
+MultiChannelGCVSpline spline(3, nt, time, {fx, fy, fz});
+SimTK::Vec3 force;
+spline.calcValues(t, &force[0]);
+@endcode                                                                      */
+class OSIMCOMMON_API MultiChannelGCVSpline {
+public:
+    MultiChannelGCVSpline() = default;
+    /** @param degree Degree of the splines: 1, 3, 5 or 7.
+    @param n Number of knots; at least degree + 1.
+    @param x The knots, which must be strictly increasing.
+    @param channels For each channel, the n values at the knots.
+    @param errorVariance As in GCVSpline: negative to estimate it, 0 to
+        interpolate the data. */
+    MultiChannelGCVSpline(int degree, int n, const double* x,
+            const std::vector<const double*>& channels,
+            double errorVariance = 0.0);
+    MultiChannelGCVSpline(const MultiChannelGCVSpline& other);
+    MultiChannelGCVSpline& operator=(const MultiChannelGCVSpline& other);
+
+    int getNumChannels() const { return m_numChannels; }
+    int getDegree() const { return 2 * m_halfOrder - 1; }
+    const std::vector<double>& getX() const { return m_x; }
+
+    /** Evaluate numChannels channels, starting at firstChannel, at x. If
+    numChannels is -1, evaluate the channels from firstChannel to the last.
+    @param[out] values The value of each channel evaluated. */
+    void calcValues(double x, double* values, int firstChannel = 0,
+            int numChannels = -1) const {
+        calcDerivatives(x, 0, values, firstChannel, numChannels);
+    }
+    /** Evaluate the derivative of the given order (0 for the value) of
+    numChannels channels, starting at firstChannel, at x. */
+    void calcDerivatives(double x, int order, double* values,
+            int firstChannel = 0, int numChannels = -1) const;
+
+private:
+    // Splines are at most of degree 7.
+    static const int MaxHalfOrder = 4;
+    // The number of channels evaluated together.
+    static const int MaxBlockSize = 16;
+
+    int m_halfOrder = 0;
+    int m_numChannels = 0;
+    std::vector<double> m_x;
+    // Coefficient j of channel i is m_coefficients[j * m_numChannels + i].
+    std::vector<double> m_coefficients;
+    // The knot interval of the previous evaluation.
+    mutable std::atomic<int> m_interval{0};
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_MULTI_CHANNEL_GCV_SPLINE_H_
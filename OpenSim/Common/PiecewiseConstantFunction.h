@@ -116,6 +116,8 @@ public:
     virtual double evaluateTotalSecondDerivative(double aX,double aDxdt,double aD2xdt2) const;
     double calcValue(const SimTK::Vector& x) const override;
     double calcDerivative(const std::vector<int>& derivComponents, const SimTK::Vector& x) const override;
+    double calcValue(double x) const override;
+    double calcDerivative(double x, int order) const override;
     int getArgumentSize() const override;
     int getMaxDerivativeOrder() const override;
     SimTK::Function* createSimTKFunction() const override;
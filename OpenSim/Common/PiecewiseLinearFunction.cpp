@@ -428,9 +428,20 @@ void PiecewiseLinearFunction::calcCoefficients()
 }
 
 double PiecewiseLinearFunction::calcValue(const Vector& x) const
+{
+    return calcValue(x[0]);
+}
+
+double PiecewiseLinearFunction::calcDerivative(const std::vector<int>& derivComponents, const Vector& x) const
+{
+    if (derivComponents.size() == 0)
+        return SimTK::NaN;
+    return calcDerivative(x[0], (int)derivComponents.size());
+}
+
+double PiecewiseLinearFunction::calcValue(double aX) const
 {
     int n = _x.getSize();
-    double aX = x[0];
 
     if (aX < _x[0])
         return _y[0] + (aX - _x[0]) * _b[0];
@@ -446,32 +457,18 @@ double PiecewiseLinearFunction::calcValue(const Vector& x) const
     else if (EQUAL_WITHIN_ERROR(aX,_x[n-1]))
         return _y[n-1];
 
-    // Do a binary search to find which two points the abscissa is between.
-    int k, i = 0;
-    int j = n;
-    while (1)
-    {
-        k = (i+j)/2;
-        if (aX < _x[k])
-            j = k;
-        else if (aX > _x[k+1])
-            i = k;
-        else
-            break;
-    }
-
+    int k = findInterval(aX);
     return _y[k] + (aX - _x[k]) * _b[k];
 }
 
-double PiecewiseLinearFunction::calcDerivative(const std::vector<int>& derivComponents, const Vector& x) const
+double PiecewiseLinearFunction::calcDerivative(double aX, int order) const
 {
-    if (derivComponents.size() == 0)
-        return SimTK::NaN;
-    if (derivComponents.size() > 1)
+    if (order == 0)
+        return calcValue(aX);
+    if (order > 1)
         return 0.0;
 
     int n = _x.getSize();
-    double aX = x[0];
 
     if (aX < _x[0]) {
         return _b[0];
@@ -489,8 +486,29 @@ double PiecewiseLinearFunction::calcDerivative(const std::vector<int>& derivComp
         return _b[n-1];
     }
 
+    return _b[findInterval(aX)];
+}
+
+/* Find k such that _x[k] <= aX <= _x[k+1], for aX within the range of the
+ * knots. Successive evaluations are usually at nearby abscissae (e.g., the
+ * times of a simulation), so check the interval found by the previous call
+ * and the one after it before doing a binary search.
+ */
+int PiecewiseLinearFunction::findInterval(double aX) const
+{
+    int n = _x.getSize();
+    int k = _interval.load(std::memory_order_relaxed);
+    if (k < n-1 && aX >= _x[k]) {
+        if (aX <= _x[k+1])
+            return k;
+        if (k < n-2 && aX <= _x[k+2]) {
+            _interval.store(k+1, std::memory_order_relaxed);
+            return k+1;
+        }
+    }
+
     // Do a binary search to find which two points the abscissa is between.
-    int k, i = 0;
+    int i = 0;
     int j = n;
     while (1)
     {
@@ -502,8 +520,8 @@ double PiecewiseLinearFunction::calcDerivative(const std::vector<int>& derivComp
         else
             break;
     }
-
-    return _b[k];
+    _interval.store(k, std::memory_order_relaxed);
+    return k;
 }
 
 int PiecewiseLinearFunction::getArgumentSize() const
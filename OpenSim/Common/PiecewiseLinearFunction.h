@@ -26,6 +26,7 @@
 
 // INCLUDES
 #include "osimCommonDLL.h"
+#include <atomic>
 #include <string>
 #include "Array.h"
 #include "PropertyDblArray.h"
@@ -64,6 +65,9 @@ protected:
 
 private:
     Array<double> _b;
+    /** The interval found by the previous evaluation. It is only a hint, so
+    concurrent evaluations may overwrite each other's. */
+    mutable std::atomic<int> _interval{0};
 
 //=============================================================================
 // METHODS
@@ -116,6 +120,8 @@ public:
     //--------------------------------------------------------------------------
     double calcValue(const SimTK::Vector& x) const override;
     double calcDerivative(const std::vector<int>& derivComponents, const SimTK::Vector& x) const override;
+    double calcValue(double x) const override;
+    double calcDerivative(double x, int order) const override;
     int getArgumentSize() const override;
     int getMaxDerivativeOrder() const override;
     SimTK::Function* createSimTKFunction() const override;
@@ -124,6 +130,7 @@ public:
 
 private:
    void calcCoefficients();
+   int findInterval(double aX) const;
 
 //=============================================================================
 };  // END class PiecewiseLinearFunction
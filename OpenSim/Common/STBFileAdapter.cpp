@@ -0,0 +1,264 @@
+/* -------------------------------------------------------------------------- *
+ *                         OpenSim:  STBFileAdapter.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "STBFileAdapter.h"
+
+#include "MemoryMappedFile.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+using namespace OpenSim;
+
+namespace {
+
+const char magic[8] = {'O', 'S', 'I', 'M', 'S', 'T', 'B', '\0'};
+const std::uint32_t formatVersion = 1;
+const std::uint32_t byteOrderMark = 0x01020304;
+
+void writeUInt32(std::ostream& out, std::uint32_t value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void writeUInt64(std::ostream& out, std::uint64_t value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void writeString(std::ostream& out, const std::string& str) {
+    writeUInt64(out, str.size());
+    out.write(str.data(), str.size());
+}
+
+/// Reads the header of an STB file from memory, checking that the file is
+/// large enough for each read.
+class HeaderReader {
+public:
+    HeaderReader(const std::string& fileName, const char* data,
+            std::size_t size) :
+            _fileName(fileName), _data(data), _size(size) {}
+
+    void read(void* dest, std::size_t numBytes) {
+        OPENSIM_THROW_IF(_pos + numBytes > _size, IOError,
+                fmt::format("File '{}' is truncated.", _fileName));
+        std::memcpy(dest, _data + _pos, numBytes);
+        _pos += numBytes;
+    }
+    template <typename T>
+    T read() {
+        T value;
+        read(&value, sizeof(T));
+        return value;
+    }
+    std::string readString() {
+        const auto length = read<std::uint64_t>();
+        OPENSIM_THROW_IF(length > _size - _pos, IOError,
+                fmt::format("File '{}' is truncated.", _fileName));
+        std::string str(_data + _pos, length);
+        _pos += length;
+        return str;
+    }
+    /// Skip the padding that aligns the data to 8 bytes.
+    void align() { _pos = (_pos + 7) / 8 * 8; }
+    std::size_t getPosition() const { return _pos; }
+
+private:
+    const std::string& _fileName;
+    const char* _data;
+    std::size_t _size;
+    std::size_t _pos = 0;
+};
+
+} // anonymous namespace
+
+STBFileAdapter*
+STBFileAdapter::clone() const {
+    return new STBFileAdapter{*this};
+}
+
+const std::string
+STBFileAdapter::tableString() {
+    return "table";
+}
+
+void
+STBFileAdapter::write(const TimeSeriesTable& table,
+                      const std::string& fileName) {
+    InputTables tables{};
+    tables.emplace(tableString(), &table);
+    STBFileAdapter{}.extendWrite(tables, fileName);
+}
+
+STBFileAdapter::OutputTables
+STBFileAdapter::extendRead(const std::string& fileName) const {
+    STBFileView view(fileName);
+    auto table = std::make_shared<TimeSeriesTable>(view.createTable());
+
+    OutputTables output_tables{};
+    output_tables.emplace(tableString(), table);
+    return output_tables;
+}
+
+void
+STBFileAdapter::extendWrite(const InputTables& absTables,
+                            const std::string& fileName) const {
+    OPENSIM_THROW_IF(absTables.empty(), NoTableFound);
+
+    const TimeSeriesTable* table{};
+    try {
+        auto abs_table = absTables.at(tableString());
+        table = dynamic_cast<const TimeSeriesTable*>(abs_table);
+    } catch(std::out_of_range&) {
+        OPENSIM_THROW(KeyMissing, tableString());
+    }
+    OPENSIM_THROW_IF(table == nullptr, IncorrectTableType);
+
+    OPENSIM_THROW_IF(fileName.empty(), EmptyFileName);
+
+    std::ofstream out{fileName, std::ios::binary};
+    OPENSIM_THROW_IF(!out.good(), IOError,
+            fmt::format("Could not open file '{}' for writing.", fileName));
+
+    // As in DelimFileAdapter, only metadata with string values is written.
+    std::vector<std::pair<std::string, std::string>> metadata;
+    for (const auto& key : table->getTableMetaDataKeys()) {
+        try {
+            metadata.emplace_back(key,
+                    table->getTableMetaData<std::string>(key));
+        } catch (const InvalidTemplateArgument&) {}
+    }
+
+    const auto& labels = table->getColumnLabels();
+    const std::size_t numRows = table->getNumRows();
+
+    out.write(magic, sizeof(magic));
+    writeUInt32(out, formatVersion);
+    writeUInt32(out, byteOrderMark);
+    writeUInt64(out, numRows);
+    writeUInt64(out, labels.size());
+    writeUInt64(out, metadata.size());
+    for (const auto& keyValue : metadata) {
+        writeString(out, keyValue.first);
+        writeString(out, keyValue.second);
+    }
+    for (const auto& label : labels) writeString(out, label);
+    const char padding[8] = {};
+    const auto headerSize = static_cast<std::size_t>(out.tellp());
+    out.write(padding, (8 - headerSize % 8) % 8);
+
+    const auto& time = table->getIndependentColumn();
+    out.write(reinterpret_cast<const char*>(time.data()),
+              numRows * sizeof(double));
+
+    const auto& matrix = table->getMatrix();
+    if (matrix.hasContiguousData()) {
+        // Matrix storage is column-major, as in the file.
+        out.write(reinterpret_cast<const char*>(
+                          matrix.getContiguousScalarData()),
+                  numRows * labels.size() * sizeof(double));
+    } else {
+        std::vector<double> column(numRows);
+        for (int j = 0; j < matrix.ncol(); ++j) {
+            for (int i = 0; i < matrix.nrow(); ++i) column[i] = matrix(i, j);
+            out.write(reinterpret_cast<const char*>(column.data()),
+                      numRows * sizeof(double));
+        }
+    }
+    OPENSIM_THROW_IF(!out.good(), IOError,
+            fmt::format("Error writing file '{}'.", fileName));
+}
+
+STBFileView::STBFileView(const std::string& fileName) :
+        _file(new MemoryMappedFile(fileName)) {
+    const char* data = _file->getData();
+    const std::size_t size = _file->getSize();
+    HeaderReader reader(fileName, data, size);
+
+    char fileMagic[8];
+    reader.read(fileMagic, sizeof(fileMagic));
+    OPENSIM_THROW_IF(std::memcmp(fileMagic, magic, sizeof(magic)) != 0,
+            IOError, fmt::format("File '{}' is not an STB file.", fileName));
+    const auto version = reader.read<std::uint32_t>();
+    OPENSIM_THROW_IF(version != formatVersion, IOError,
+            fmt::format("File '{}' has STB format version {}, but only "
+                        "version {} is supported.",
+                    fileName, version, formatVersion));
+    OPENSIM_THROW_IF(reader.read<std::uint32_t>() != byteOrderMark, IOError,
+            fmt::format("File '{}' was written on a machine with a different "
+                        "byte order.", fileName));
+
+    const auto numRows = reader.read<std::uint64_t>();
+    const auto numColumns = reader.read<std::uint64_t>();
+    const auto numMetadata = reader.read<std::uint64_t>();
+    for (std::uint64_t i = 0; i < numMetadata; ++i) {
+        const std::string key = reader.readString();
+        _metadata.setValueForKey(key, reader.readString());
+    }
+    for (std::uint64_t j = 0; j < numColumns; ++j) {
+        _columnLabels.push_back(reader.readString());
+    }
+    reader.align();
+
+    // The file must hold numRows * (numColumns + 1) doubles after the header;
+    // check without overflowing.
+    OPENSIM_THROW_IF(reader.getPosition() > size, IOError,
+            fmt::format("File '{}' is truncated.", fileName));
+    const std::uint64_t numValuesAvailable =
+            (size - reader.getPosition()) / sizeof(double);
+    const bool dataFits = numRows == 0 ||
+            (numColumns < numValuesAvailable &&
+                    numRows <= numValuesAvailable / (numColumns + 1));
+    OPENSIM_THROW_IF(!dataFits, IOError,
+            fmt::format("File '{}' is truncated.", fileName));
+    const std::uint64_t maxInt = std::numeric_limits<int>::max();
+    OPENSIM_THROW_IF(numRows > maxInt || numColumns > maxInt, IOError,
+            fmt::format("File '{}' has too many rows or columns.", fileName));
+    _numRows = static_cast<std::size_t>(numRows);
+
+    // The mapping is page-aligned and the data is 8-byte aligned within the
+    // file, so the doubles can be accessed in place.
+    const auto* values =
+            reinterpret_cast<const double*>(data + reader.getPosition());
+    const int nrow = static_cast<int>(numRows);
+    const int ncol = static_cast<int>(numColumns);
+    _time.reset(new SimTK::Vector(nrow, values, true));
+    _matrix.reset(new SimTK::Matrix(nrow, ncol, nrow, values + nrow));
+}
+
+STBFileView::~STBFileView() = default;
+
+SimTK::VectorView
+STBFileView::getDependentColumn(const std::string& label) const {
+    for (std::size_t j = 0; j < _columnLabels.size(); ++j) {
+        if (_columnLabels[j] == label) return _matrix->col(static_cast<int>(j));
+    }
+    OPENSIM_THROW(KeyNotFound, label);
+}
+
+TimeSeriesTable
+STBFileView::createTable() const {
+    const double* time = _time->getContiguousScalarData();
+    TimeSeriesTable table(std::vector<double>(time, time + _numRows),
+            *_matrix, _columnLabels);
+    table.updTableMetaData() = _metadata;
+    return table;
+}
@@ -0,0 +1,131 @@
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim:  STBFileAdapter.h                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#ifndef OPENSIM_STB_FILE_ADAPTER_H_
+#define OPENSIM_STB_FILE_ADAPTER_H_
+
+#include "FileAdapter.h"
+#include "TimeSeriesTable.h"
+
+#include <memory>
+
+namespace OpenSim {
+
+class MemoryMappedFile;
+
+/** STBFileAdapter is a FileAdapter that reads and writes TimeSeriesTable%s
+(of doubles) in a binary, columnar format (extension .stb). Numbers are
+stored exactly as they are in memory, so reading and writing are much faster
+than with STOFileAdapter and values round-trip exactly. The format is:
+\code
+"OSIMSTB\0"                        8-byte magic string
+uint32 version, uint32 0x01020304  format version and byte-order mark
+uint64 numRows, uint64 numColumns, uint64 numMetaDataKeys
+numMetaDataKeys x (string key, string value)
+numColumns x (string label)
+zero padding to a multiple of 8 bytes
+numRows x double                   the time column
+numColumns x numRows x double      the data, one column after another
+\endcode
+where each string is a uint64 length followed by its characters. Files are
+written in the byte order of the machine that writes them; reading a file
+with a different byte order is an error. Only table metadata whose values are
+strings is stored (the same metadata that STOFileAdapter writes).
+
+Since the columns are contiguous, use STBFileView to access the data of a
+file through a memory-mapped view of the file, without reading it into a
+table.                                                                        */
+class OSIMCOMMON_API STBFileAdapter : public FileAdapter {
+public:
+    STBFileAdapter()                                 = default;
+    STBFileAdapter(const STBFileAdapter&)            = default;
+    STBFileAdapter(STBFileAdapter&&)                 = default;
+    STBFileAdapter& operator=(const STBFileAdapter&) = default;
+    STBFileAdapter& operator=(STBFileAdapter&&)      = default;
+    ~STBFileAdapter()                                = default;
+
+    STBFileAdapter* clone() const override;
+
+    /** Write a table to an STB file.                                        */
+    static
+    void write(const TimeSeriesTable& table, const std::string& fileName);
+
+    /** Key used for table associative array returned/accepted by write/read. */
+    static const std::string tableString();
+
+protected:
+    /** Implementation of the read functionality.                             */
+    OutputTables extendRead(const std::string& fileName) const override;
+
+    /** Implementation of the write functionality.                            */
+    void extendWrite(const InputTables& tables,
+                     const std::string& fileName) const override;
+};
+
+/** Read-only access to the contents of an STB file (see STBFileAdapter)
+through a memory-mapped view of the file. The time column and the data are
+exposed as SimTK::Vector and SimTK::Matrix objects that refer directly to the
+mapped file, so no data is copied or parsed and only the parts of the file
+that are accessed are read from disk. These views are valid only as long as
+the STBFileView exists.
+\code
+STBFileView view("states.stb");
+const SimTK::Matrix& data = view.getMatrix();
+SimTK::VectorView knee = view.getDependentColumn("knee_angle_r");
+\endcode                                                                      */
+class OSIMCOMMON_API STBFileView {
+public:
+    explicit STBFileView(const std::string& fileName);
+    STBFileView(const STBFileView&)            = delete;
+    STBFileView& operator=(const STBFileView&) = delete;
+    ~STBFileView();
+
+    std::size_t getNumRows() const { return _numRows; }
+    std::size_t getNumColumns() const { return _columnLabels.size(); }
+    const std::vector<std::string>& getColumnLabels() const {
+        return _columnLabels;
+    }
+    const ValueArrayDictionary& getTableMetaData() const { return _metadata; }
+
+    /** The time column.                                                     */
+    const SimTK::Vector& getIndependentColumn() const { return *_time; }
+    /** The data, with one column per column label.                          */
+    const SimTK::Matrix& getMatrix() const { return *_matrix; }
+    /** The column with the given label.
+    @throws KeyNotFound If there is no column with the label.                */
+    SimTK::VectorView getDependentColumn(const std::string& label) const;
+
+    /** Copy the contents of the file into a TimeSeriesTable.                */
+    TimeSeriesTable createTable() const;
+
+private:
+    std::unique_ptr<MemoryMappedFile> _file;
+    std::size_t _numRows = 0;
+    std::vector<std::string> _columnLabels;
+    ValueArrayDictionary _metadata;
+    // These refer to the mapped data rather than owning their own storage.
+    std::unique_ptr<const SimTK::Vector> _time;
+    std::unique_ptr<const SimTK::Matrix> _matrix;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_STB_FILE_ADAPTER_H_
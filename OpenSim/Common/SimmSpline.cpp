@@ -509,6 +509,19 @@ int SimmSpline::addPoint(double aX, double aY)
 }
 
 double SimmSpline::calcValue(const Vector& x) const
+{
+    return calcValue(x[0]);
+}
+
+double SimmSpline::calcDerivative(const std::vector<int>& derivComponents, const Vector& x) const
+{
+    int aDerivOrder = (int)derivComponents.size();
+    if (aDerivOrder < 1 || aDerivOrder > 2)
+        throw Exception("SimmSpline::calcDerivative(): derivative order must be 1 or 2.");
+    return calcDerivative(x[0], aDerivOrder);
+}
+
+double SimmSpline::calcValue(double aX) const
 {
     // NOT A NUMBER
     if(!_y.getSize()) return(SimTK::NaN);
@@ -516,11 +529,10 @@ double SimmSpline::calcValue(const Vector& x) const
     if(!_c.getSize()) return(SimTK::NaN);
     if(!_d.getSize()) return(SimTK::NaN);
 
-    int i, j, k;
+    int k;
     double dx;
 
     int n = _x.getSize();
-    double aX = x[0];
 
    /* Check if the abscissa is out of range of the function. If it is,
     * then use the slope of the function at the appropriate end point to
@@ -556,39 +568,28 @@ double SimmSpline::calcValue(const Vector& x) const
     }
     else
     {
-        /* Do a binary search to find which two points the abscissa is between. */
-        i = 0;
-        j = n;
-        while (1)
-        {
-            k = (i+j)/2;
-            if (aX < _x[k])
-                j = k;
-            else if (aX > _x[k+1])
-                i = k;
-            else
-                break;
-        }
+        k = findInterval(aX);
     }
 
    dx = aX - _x[k];
    return _y[k] + dx*(_b[k] + dx*(_c[k] + dx*_d[k]));
 }
 
-double SimmSpline::calcDerivative(const std::vector<int>& derivComponents, const Vector& x) const
+double SimmSpline::calcDerivative(double aX, int aDerivOrder) const
 {
+    if (aDerivOrder == 0)
+        return calcValue(aX);
+
     // NOT A NUMBER
     if(!_y.getSize()) return(SimTK::NaN);
     if(!_b.getSize()) return(SimTK::NaN);
     if(!_c.getSize()) return(SimTK::NaN);
     if(!_d.getSize()) return(SimTK::NaN);
 
-    int i, j, k;
+    int k;
     double dx;
 
     int n = _x.getSize();
-    double aX = x[0];
-    int aDerivOrder = (int)derivComponents.size();
     if (aDerivOrder < 1 || aDerivOrder > 2)
         throw Exception("SimmSpline::calcDerivative(): derivative order must be 1 or 2.");
 
@@ -646,19 +647,7 @@ double SimmSpline::calcDerivative(const std::vector<int>& derivComponents, const
     }
     else
     {
-        /* Do a binary search to find which two points the abscissa is between. */
-        i = 0;
-        j = n;
-        while (1)
-        {
-            k = (i+j)/2;
-            if (aX < _x[k])
-                j = k;
-            else if (aX > _x[k+1])
-                i = k;
-            else
-                break;
-        }
+        k = findInterval(aX);
     }
 
    dx = aX - _x[k];
@@ -670,6 +659,41 @@ double SimmSpline::calcDerivative(const std::vector<int>& derivComponents, const
       return (2.0*_c[k] + 6.0*dx*_d[k]);
 }
 
+/* Find k such that _x[k] <= aX <= _x[k+1], for aX within the range of the
+ * knots. Successive evaluations are usually at nearby abscissae (e.g., the
+ * coordinate values of a simulation), so check the interval found by the
+ * previous call and the one after it before doing a binary search.
+ */
+int SimmSpline::findInterval(double aX) const
+{
+    int n = _x.getSize();
+    int k = _interval.load(std::memory_order_relaxed);
+    if (k < n-1 && aX >= _x[k]) {
+        if (aX <= _x[k+1])
+            return k;
+        if (k < n-2 && aX <= _x[k+2]) {
+            _interval.store(k+1, std::memory_order_relaxed);
+            return k+1;
+        }
+    }
+
+    /* Do a binary search to find which two points the abscissa is between. */
+    int i = 0;
+    int j = n;
+    while (1)
+    {
+        k = (i+j)/2;
+        if (aX < _x[k])
+            j = k;
+        else if (aX > _x[k+1])
+            i = k;
+        else
+            break;
+    }
+    _interval.store(k, std::memory_order_relaxed);
+    return k;
+}
+
 int SimmSpline::getArgumentSize() const
 {
     return 1;
@@ -26,6 +26,7 @@
 
 // INCLUDES
 #include "osimCommonDLL.h"
+#include <atomic>
 #include <string>
 #include "Array.h"
 #include "PropertyDblArray.h"
@@ -68,6 +69,9 @@ private:
     Array<double> _b;
     Array<double> _c;
     Array<double> _d;
+    /** The interval found by the previous evaluation. It is only a hint, so
+    concurrent evaluations may overwrite each other's. */
+    mutable std::atomic<int> _interval{0};
 
 //=============================================================================
 // METHODS
@@ -120,6 +124,8 @@ public:
     //--------------------------------------------------------------------------
     double calcValue(const SimTK::Vector& x) const override;
     double calcDerivative(const std::vector<int>& derivComponents, const SimTK::Vector& x) const override;
+    double calcValue(double x) const override;
+    double calcDerivative(double x, int order) const override;
     int getArgumentSize() const override;
     int getMaxDerivativeOrder() const override;
     SimTK::Function* createSimTKFunction() const override;
@@ -128,6 +134,7 @@ public:
 
 private:
     void calcCoefficients();
+    int findInterval(double aX) const;
 //=============================================================================
 };  // END class SimmSpline
 
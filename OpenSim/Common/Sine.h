@@ -86,15 +86,23 @@ public:
     // EVALUATION
     //--------------------------------------------------------------------------
     double calcValue(const SimTK::Vector& x) const override {
-        return get_amplitude()*sin(get_omega()*x[0] + get_phase())
-            + get_offset();
+        return calcValue(x[0]);
     }
     
     double calcDerivative(const std::vector<int>& derivComponents,
         const SimTK::Vector& x) const override {
-        int n = (int)derivComponents.size();
+        return calcDerivative(x[0], (int)derivComponents.size());
+    }
+
+    double calcValue(double x) const override {
+        return get_amplitude()*sin(get_omega()*x + get_phase())
+            + get_offset();
+    }
+
+    double calcDerivative(double x, int n) const override {
+        if (n == 0) return calcValue(x);
         return get_amplitude()*pow(get_omega(),n) * 
-            sin(get_omega()*x[0] + get_phase() + n*SimTK::Pi/2);
+            sin(get_omega()*x + get_phase() + n*SimTK::Pi/2);
     }
 
     SimTK::Function* createSimTKFunction() const override {
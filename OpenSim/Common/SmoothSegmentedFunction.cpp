@@ -24,6 +24,7 @@
 // INCLUDES
 //=============================================================================
 #include "SmoothSegmentedFunction.h"
+#include <algorithm>
 #include <fstream>
 #include "simmath/internal/SplineFitter.h"
 
@@ -39,6 +40,8 @@ static double UTOL = (double)SimTK::Eps*1e2;
 static double INTTOL = (double)SimTK::Eps*1e2;
 static int MAXITER = 20;
 static int NUM_SAMPLE_PTS = 100;
+static int MIN_TABLE_INTERVALS = 8;
+static int MAX_TABLE_INTERVALS = 4096;
 //=============================================================================
 // UTILITY FUNCTIONS
 //=============================================================================
@@ -200,7 +203,10 @@ ________________________________________________________________________
 double SmoothSegmentedFunction::calcValue(double x) const
 {
     double yVal = 0;
-    if(x >= _x0 && x <= _x1 )
+    if(x >= _x0 && x <= _x1 && !_tableCoefs.empty())
+    {
+        yVal = calcTabulatedDerivative(x, 0);
+    }else if(x >= _x0 && x <= _x1 )
     {
         int idx  = SegmentedQuinticBezierToolkit::calcIndex(x,_mXVec);
         double u = SegmentedQuinticBezierToolkit::
@@ -269,7 +275,9 @@ double SmoothSegmentedFunction::calcDerivative(double x, int order) const
     if(order==0){
                 yVal = calcValue(x);
     }else{
-            if(x >= _x0 && x <= _x1){        
+            if(x >= _x0 && x <= _x1 && order <= 2 && !_tableCoefs.empty()){
+                yVal = calcTabulatedDerivative(x, order);
+            }else if(x >= _x0 && x <= _x1){        
                 int idx  = SegmentedQuinticBezierToolkit::calcIndex(x,_mXVec);
                 double u = SegmentedQuinticBezierToolkit::
                                 calcU(x,_mXVec[idx], _arraySplineUX[idx], 
@@ -388,6 +396,141 @@ double SmoothSegmentedFunction::calcIntegral(double x) const
     return yVal;
 }
 
+void SmoothSegmentedFunction::tabulate(double tolerance)
+{
+    SimTK_ERRCHK2_ALWAYS(tolerance >= 0,
+        "SmoothSegmentedFunction::tabulate",
+        "%s: The tolerance must be non-negative, but it is %f.",
+        _name.c_str(), tolerance);
+
+    // The table is built from (and checked against) the Bezier curves.
+    _tableX0.clear();
+    _tableInvDx.clear();
+    _tableNumIntervals.clear();
+    _tableOffset.clear();
+    _tableCoefs.clear();
+    if(tolerance == 0) return;
+
+    // The scale of the value and of the first two derivatives.
+    SimTK::Vec3 scale(1.0);
+    for(int s=0; s < _numBezierSections; s++){
+        const double xs = _mXVec[s](0);
+        const double xe = _mXVec[s](5);
+        for(int i=0; i < NUM_SAMPLE_PTS; i++){
+            const double x = xs + (xe-xs)*i/(double)(NUM_SAMPLE_PTS-1);
+            for(int order=0; order <= 2; order++){
+                scale[order] = std::max(scale[order],
+                                        std::abs(calcDerivative(x, order)));
+            }
+        }
+    }
+
+    std::vector<double> x0, invDx, coefs;
+    std::vector<int> numIntervals, offset;
+    for(int s=0; s < _numBezierSections; s++){
+        const double xs = _mXVec[s](0);
+        const double xe = _mXVec[s](5);
+        std::vector<double> sectionCoefs;
+        int n = MIN_TABLE_INTERVALS;
+        for(;; n *= 2){
+            SimTK_ERRCHK3_ALWAYS(n <= MAX_TABLE_INTERVALS,
+                "SmoothSegmentedFunction::tabulate",
+                "%s: Could not tabulate Bezier section %i to a tolerance of "
+                "%g.", _name.c_str(), s, tolerance);
+
+            // Quintic Hermite interpolation of the value and the first two
+            // derivatives (scaled to the local coordinate t) at the knots.
+            const double h = (xe-xs)/n;
+            sectionCoefs.resize(6*n);
+            double p0 = calcDerivative(xs, 0);
+            double d0 = calcDerivative(xs, 1)*h;
+            double s0 = calcDerivative(xs, 2)*h*h;
+            for(int i=0; i < n; i++){
+                const double xk = i == n-1 ? xe : xs + (i+1)*h;
+                const double p1 = calcDerivative(xk, 0);
+                const double d1 = calcDerivative(xk, 1)*h;
+                const double s1 = calcDerivative(xk, 2)*h*h;
+                const double dp = p1 - p0;
+                double* c = &sectionCoefs[6*i];
+                c[0] = p0;
+                c[1] = d0;
+                c[2] = 0.5*s0;
+                c[3] = 10*dp - 6*d0 - 4*d1 - 1.5*s0 + 0.5*s1;
+                c[4] = -15*dp + 8*d0 + 7*d1 + 1.5*s0 - s1;
+                c[5] = 6*dp - 3*d0 - 3*d1 - 0.5*s0 + 0.5*s1;
+                p0 = p1; d0 = d1; s0 = s1;
+            }
+
+            // Check the table between the knots.
+            bool withinTolerance = true;
+            for(int i=0; i < n && withinTolerance; i++){
+                const double* c = &sectionCoefs[6*i];
+                for(double t : {0.25, 0.5, 0.75}){
+                    const double x = xs + (i+t)*h;
+                    const double y = c[0] + t*(c[1] + t*(c[2]
+                                   + t*(c[3] + t*(c[4] + t*c[5]))));
+                    const double dydx = (c[1] + t*(2*c[2] + t*(3*c[3]
+                                      + t*(4*c[4] + t*5*c[5]))))/h;
+                    const double d2ydx2 = (2*c[2] + t*(6*c[3]
+                                        + t*(12*c[4] + t*20*c[5])))/(h*h);
+                    if(std::abs(y - calcDerivative(x, 0))
+                            > tolerance*scale[0] ||
+                       std::abs(dydx - calcDerivative(x, 1))
+                            > tolerance*scale[1] ||
+                       std::abs(d2ydx2 - calcDerivative(x, 2))
+                            > tolerance*scale[2]){
+                        withinTolerance = false;
+                        break;
+                    }
+                }
+            }
+            if(withinTolerance) break;
+        }
+
+        x0.push_back(xs);
+        invDx.push_back(n/(xe-xs));
+        numIntervals.push_back(n);
+        offset.push_back((int)(coefs.size()/6));
+        coefs.insert(coefs.end(), sectionCoefs.begin(), sectionCoefs.end());
+    }
+
+    _tableX0 = x0;
+    _tableInvDx = invDx;
+    _tableNumIntervals = numIntervals;
+    _tableOffset = offset;
+    _tableCoefs = coefs;
+}
+
+bool SmoothSegmentedFunction::isTabulated() const
+{
+    return !_tableCoefs.empty();
+}
+
+double SmoothSegmentedFunction::calcTabulatedDerivative(double x,
+                                                        int order) const
+{
+    // There are only a few sections, so a linear search is fastest.
+    int s = 0;
+    const int numSections = (int)_tableX0.size();
+    while(s+1 < numSections && x >= _tableX0[s+1]) s++;
+
+    double t = (x - _tableX0[s])*_tableInvDx[s];
+    const int i = std::min(std::max((int)t, 0), _tableNumIntervals[s]-1);
+    t -= i;
+    const double* c = &_tableCoefs[6*(_tableOffset[s]+i)];
+
+    switch(order){
+    case 0:
+        return c[0] + t*(c[1] + t*(c[2] + t*(c[3] + t*(c[4] + t*c[5]))));
+    case 1:
+        return (c[1] + t*(2*c[2] + t*(3*c[3] + t*(4*c[4] + t*5*c[5]))))
+                *_tableInvDx[s];
+    default:
+        return (2*c[2] + t*(6*c[3] + t*(12*c[4] + t*20*c[5])))
+                *_tableInvDx[s]*_tableInvDx[s];
+    }
+}
+
 bool SmoothSegmentedFunction::isIntegralAvailable() const
 {
     return _computeIntegral;
@@ -25,6 +25,8 @@
 #include "osimCommonDLL.h"
 #include "SegmentedQuinticBezierToolkit.h"
 
+#include <vector>
+
 namespace OpenSim { 
 
     /**
@@ -133,6 +135,36 @@ namespace OpenSim {
 #endif
 
 
+       /**Replaces the evaluation of the curve and of its first and second
+       derivatives within the curve domain with the evaluation of a
+       precomputed table. Each Bezier section is divided into equal intervals,
+       and on each interval the curve is represented by the quintic Hermite
+       polynomial that matches the value and the first two derivatives of the
+       curve at the ends of the interval, so the tabulated curve is C2
+       continuous. The number of intervals is doubled until the value and the
+       first two derivatives of the table are within the tolerance of those of
+       the curve at points between the knots, relative to the largest
+       magnitude of each over the curve (or absolute, if this magnitude is less
+       than 1). The linear extrapolation, the higher derivatives and the
+       integral are not affected.
+
+       @param tolerance The acceptable error of the table; a value of 0 removes
+                        the table.
+       @throws SimTK::Exception::Base (from SimTK_ERRCHK)
+        -If the tolerance is negative, or cannot be met with 4096 intervals
+         per Bezier section
+
+       <B>Computational Costs</B>
+       \verbatim
+            x in curve domain  : ~25 flops (value, dy/dx or d2y/dx2)
+       \endverbatim
+       */
+       void tabulate(double tolerance);
+
+       /**@return true if the curve is evaluated using a table created by
+                  tabulate()*/
+       bool isTabulated() const;
+
        /**This will return the value of the integral of this objects curve 
        evaluated at x. 
        
@@ -320,6 +352,21 @@ namespace OpenSim {
         stored in 6x1 vectors in the order above*/
         SimTK::Array_<SimTK::Vector> _mYVec; 
 
+        /**The table created by tabulate(): for each Bezier section, the x
+        value at its start, the reciprocal of the width of its intervals, the
+        number of intervals, and the index of its first interval. The 6
+        polynomial coefficients of each interval, in the local coordinate
+        t in [0,1], are stored contiguously in _tableCoefs.*/
+        std::vector<double> _tableX0;
+        std::vector<double> _tableInvDx;
+        std::vector<int> _tableNumIntervals;
+        std::vector<int> _tableOffset;
+        std::vector<double> _tableCoefs;
+
+        /**Evaluates the table created by tabulate() (order 0 to 2) at a point
+        x within the curve domain*/
+        double calcTabulatedDerivative(double x, int order) const;
+
         /**The number of quintic Bezier curves that describe the relation*/
         int _numBezierSections;
 
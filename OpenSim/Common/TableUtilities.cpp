@@ -166,13 +166,13 @@ void TableUtilities::pad(
             "got {}.",
             numRowsToPrependAndAppend);
 
-    table._indData = Signal::Pad(numRowsToPrependAndAppend,
-            (int)table._indData.size(), table._indData.data());
-
     size_t numColumns = table.getNumColumns();
 
-    // _indData.size() is now the number of rows after padding.
-    SimTK::Matrix newMatrix((int)table._indData.size(), (int)numColumns);
+    // Pad the dependent columns first: the size of the independent column is
+    // the number of rows of the table, and so the length of its columns.
+    const int newNumRows =
+            (int)table.getNumRows() + 2 * numRowsToPrependAndAppend;
+    SimTK::Matrix newMatrix(newNumRows, (int)numColumns);
     for (size_t icol = 0; icol < numColumns; ++icol) {
         SimTK::Vector column = table.getDependentColumnAtIndex(icol);
         const std::vector<double> newColumn =
@@ -181,7 +181,10 @@ void TableUtilities::pad(
         newMatrix.updCol((int)icol) =
                 SimTK::Vector((int)newColumn.size(), newColumn.data(), true);
     }
-    table.updMatrix() = newMatrix;
+
+    table._indData = Signal::Pad(numRowsToPrependAndAppend,
+            (int)table._indData.size(), table._indData.data());
+    table._depData = newMatrix;
 }
 
 namespace {
@@ -0,0 +1,165 @@
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  testBoundedDataQueue.cpp                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Common/BoundedDataQueue.h>
+
+#include <thread>
+
+#define CATCH_CONFIG_MAIN
+#include <OpenSim/Auxiliary/catch.hpp>
+
+using namespace OpenSim;
+
+typedef BoundedDataQueue_<double> Queue;
+
+namespace {
+SimTK::RowVector makeRow(int size, double value) {
+    return SimTK::RowVector(size, value);
+}
+}
+
+TEST_CASE("BoundedDataQueue push and pop in order") {
+    Queue queue(4, 3);
+    CHECK(queue.isEmpty());
+    for (int i = 0; i < 3; ++i) queue.push_back(0.1 * i, makeRow(3, i));
+    CHECK(queue.getSize() == 3);
+
+    double time;
+    SimTK::RowVector row;
+    for (int i = 0; i < 3; ++i) {
+        queue.pop_front(time, row);
+        CHECK(time == 0.1 * i);
+        REQUIRE(row.size() == 3);
+        CHECK(row[2] == i);
+    }
+    CHECK_FALSE(queue.try_pop_front(time, row));
+
+    // Wrap around the end of the storage.
+    for (int i = 0; i < 10; ++i) {
+        CHECK(queue.try_push_back(i, makeRow(3, i)));
+        REQUIRE(queue.try_pop_front(time, row));
+        CHECK(row[0] == i);
+    }
+    const auto stats = queue.getStatistics();
+    CHECK(stats.numPushed == 13);
+    CHECK(stats.numPopped == 13);
+    CHECK(stats.numDropped == 0);
+
+    CHECK_THROWS_AS(queue.push_back(0, makeRow(2, 0)), Exception);
+    CHECK_THROWS_AS(Queue(0, 3), Exception);
+}
+
+TEST_CASE("BoundedDataQueue row size set by first row") {
+    Queue queue(2, 0);
+    CHECK(queue.getRowSize() == 0);
+    queue.push_back(0, makeRow(5, 1.0));
+    CHECK(queue.getRowSize() == 5);
+    CHECK_THROWS_AS(queue.push_back(0, makeRow(4, 1.0)), Exception);
+    double time;
+    SimTK::RowVector row;
+    queue.pop_front(time, row);
+    CHECK(row.size() == 5);
+}
+
+TEST_CASE("BoundedDataQueue overflow policies") {
+    double time;
+    SimTK::RowVector row;
+    SECTION("Backpressure rejects new rows") {
+        Queue queue(2, 1);
+        CHECK(queue.try_push_back(0, makeRow(1, 0)));
+        CHECK(queue.try_push_back(1, makeRow(1, 1)));
+        CHECK_FALSE(queue.try_push_back(2, makeRow(1, 2)));
+        CHECK(queue.getStatistics().numRejected == 1);
+        queue.pop_front(time, row);
+        CHECK(time == 0);
+    }
+    SECTION("DropOldest keeps the newest rows") {
+        Queue queue(2, 1, Queue::OverflowPolicy::DropOldest);
+        for (int i = 0; i < 5; ++i) CHECK(queue.try_push_back(i, makeRow(1, i)));
+        CHECK(queue.getSize() == 2);
+        CHECK(queue.getStatistics().numDropped == 3);
+        queue.pop_front(time, row);
+        CHECK(time == 3);
+        queue.pop_front(time, row);
+        CHECK(row[0] == 4);
+    }
+}
+
+TEST_CASE("BoundedDataQueue copy") {
+    Queue queue(3, 2);
+    queue.push_back(0.5, makeRow(2, 7));
+    Queue copy(queue);
+    double time;
+    SimTK::RowVector row;
+    copy.pop_front(time, row);
+    CHECK(time == 0.5);
+    CHECK(row[1] == 7);
+    CHECK(queue.getSize() == 1);
+}
+
+TEST_CASE("BoundedDataQueue producer and consumer threads") {
+    const int numRows = 20000;
+    SECTION("Backpressure delivers every row") {
+        Queue queue(16, 4);
+        std::thread producer([&]() {
+            for (int i = 0; i < numRows; ++i) {
+                queue.push_back(i, makeRow(4, i));
+            }
+        });
+        double time;
+        SimTK::RowVector row;
+        for (int i = 0; i < numRows; ++i) {
+            queue.pop_front(time, row);
+            REQUIRE(time == i);
+            REQUIRE(row[0] == i);
+            REQUIRE(row[3] == i);
+        }
+        producer.join();
+        CHECK(queue.getStatistics().numPopped == numRows);
+    }
+    SECTION("DropOldest delivers rows in order") {
+        Queue queue(4, 4, Queue::OverflowPolicy::DropOldest);
+        std::thread producer([&]() {
+            for (int i = 0; i < numRows; ++i) {
+                queue.push_back(i, makeRow(4, i));
+            }
+        });
+        double time;
+        double prevTime = -1;
+        SimTK::RowVector row;
+        std::uint64_t numPopped = 0;
+        while (prevTime < numRows - 1) {
+            if (!queue.try_pop_front(time, row)) continue;
+            ++numPopped;
+            REQUIRE(time > prevTime);
+            // All elements of a row come from the same push.
+            REQUIRE(row[0] == time);
+            REQUIRE(row[3] == time);
+            prevTime = time;
+        }
+        producer.join();
+        const auto stats = queue.getStatistics();
+        CHECK(stats.numPushed == numRows);
+        CHECK(stats.numPopped == numPopped);
+        CHECK(stats.numPopped + stats.numDropped == numRows);
+    }
+}
@@ -785,6 +785,78 @@ TEST_CASE("DataTable") {
     }
 }
 
+TEST_CASE("DataTable appendRow with spare capacity") {
+    const int numRows = 1000;
+    const std::vector<std::string> labels{"a", "b", "c"};
+    auto makeRow = [](int i) {
+        RowVector row(3);
+        row[0] = i;
+        row[1] = 2.0 * i;
+        row[2] = 3.0 * i;
+        return row;
+    };
+
+    for (bool reserve : {false, true}) {
+        TimeSeriesTable table;
+        table.setColumnLabels(labels);
+        if (reserve) table.reserve(numRows);
+        for (int i = 0; i < numRows; ++i) {
+            table.appendRow(0.01 * i, makeRow(i));
+            CHECK(table.getNumRows() == (size_t)(i + 1));
+        }
+        // Rows can be read and modified while there are spare rows.
+        CHECK(table.getRowAtIndex(numRows - 1)[2] == 3.0 * (numRows - 1));
+        table.updRowAtIndex(10)[0] = -1;
+        CHECK_THROWS_AS(table.getRowAtIndex(numRows), RowIndexOutOfRange);
+        CHECK(table.getMatrixBlock(numRows - 2, 0, 2, 3)(1, 1) ==
+                2.0 * (numRows - 1));
+
+        // Entire columns and the matrix have exactly numRows rows.
+        CHECK(table.getDependentColumn("b").size() == numRows);
+        CHECK(table.getMatrix().nrow() == numRows);
+        CHECK(table.getMatrix()(10, 0) == -1);
+        CHECK(table.getMatrix()(numRows - 1, 2) == 3.0 * (numRows - 1));
+
+        // Appending after a read keeps the existing data.
+        table.appendRow(0.01 * numRows, makeRow(numRows));
+        table.appendColumn("d", Vector(numRows + 1, 4.0));
+        CHECK(table.getMatrix().nrow() == numRows + 1);
+        CHECK(table.getMatrix()(numRows, 1) == 2.0 * numRows);
+        CHECK(table.getMatrix()(numRows, 3) == 4.0);
+
+        // Removing rows after appending.
+        table.appendRow(0.01 * (numRows + 1), {1.0, 2.0, 3.0, 4.0});
+        table.removeRowAtIndex(0);
+        CHECK(table.getNumRows() == (size_t)(numRows + 1));
+        CHECK(table.getMatrix().nrow() == numRows + 1);
+        CHECK(table.getMatrix()(numRows, 3) == 4.0);
+
+        // Copies have the same rows.
+        table.appendRow(0.01 * (numRows + 2), {1.0, 2.0, 3.0, 4.0});
+        TimeSeriesTable copy(table);
+        CHECK(copy.getNumRows() == table.getNumRows());
+        CHECK(copy.getMatrix().nrow() == (int)table.getNumRows());
+
+        // Const accessors do not release the spare rows, so views obtained
+        // earlier remain valid.
+        table.appendRow(0.01 * (numRows + 3), {1.0, 2.0, 3.0, 4.0});
+        const auto column = table.getDependentColumnAtIndex(3);
+        const auto matrix = table.getMatrix();
+        CHECK(column.size() == (int)table.getNumRows());
+        CHECK(matrix.nrow() == (int)table.getNumRows());
+        CHECK(column[numRows + 2] == 4.0);
+        CHECK(matrix(numRows + 2, 3) == 4.0);
+
+        // Padding a table with spare rows.
+        const int numRowsBeforePad = (int)table.getNumRows();
+        TableUtilities::pad(table, 2);
+        CHECK(table.getNumRows() == (size_t)(numRowsBeforePad + 4));
+        CHECK(table.getMatrix().nrow() == numRowsBeforePad + 4);
+        CHECK(table.getMatrix()(2, 1) == 2.0);
+        CHECK(table.getMatrix()(numRowsBeforePad + 1, 3) == 4.0);
+    }
+}
+
 TEST_CASE("TableUtilities::checkNonUniqueLabels") {
     CHECK_THROWS_AS(TableUtilities::checkNonUniqueLabels({"a", "a"}),
                     NonUniqueLabels);
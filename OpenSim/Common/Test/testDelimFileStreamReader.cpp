@@ -0,0 +1,145 @@
+/* -------------------------------------------------------------------------- *
+ *                  OpenSim:  testDelimFileStreamReader.cpp                   *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "OpenSim/Common/Adapters.h"
+
+#include <fstream>
+
+#define CATCH_CONFIG_MAIN
+#include <OpenSim/Auxiliary/catch.hpp>
+
+using namespace OpenSim;
+
+namespace {
+// Read the whole file in blocks and check it against the table that the file
+// adapters produce.
+void checkStreamedTable(const std::string& fileName,
+        const TimeSeriesTable& expected, int blockSize, bool mapped) {
+    CAPTURE(fileName, blockSize, mapped);
+    DelimFileStreamReader reader(fileName, blockSize, mapped);
+    CHECK(reader.getColumnLabels() == expected.getColumnLabels());
+
+    std::size_t numBlocks = 0;
+    const std::size_t numRows = reader.forEachBlock(
+            [&](const DelimFileStreamReader::Block& block) {
+                REQUIRE((int)block.times.size() == block.values.nrow());
+                REQUIRE(block.values.nrow() <= blockSize);
+                REQUIRE(block.values.ncol() ==
+                        (int)expected.getNumColumns());
+                for (int i = 0; i < block.values.nrow(); ++i) {
+                    const int row = (int)block.firstRowIndex + i;
+                    CHECK(block.times[i] ==
+                            expected.getIndependentColumn()[row]);
+                    for (int j = 0; j < block.values.ncol(); ++j) {
+                        CHECK(block.values(i, j) ==
+                                expected.getMatrix()(row, j));
+                    }
+                }
+                ++numBlocks;
+            });
+    CHECK(numRows == expected.getNumRows());
+    CHECK(reader.getNumRowsRead() == expected.getNumRows());
+    CHECK(numBlocks == (expected.getNumRows() + blockSize - 1) / blockSize);
+
+    // Nothing left to read.
+    DelimFileStreamReader::Block block;
+    CHECK_FALSE(reader.readNextBlock(block));
+    CHECK(block.times.empty());
+}
+} // anonymous namespace
+
+TEST_CASE("DelimFileStreamReader matches the file adapters") {
+    // A MOT file with leading whitespace in the fields.
+    const std::string motFile = "gait10dof18musc_ik_CRLF_line_ending.mot";
+    TimeSeriesTable mot(motFile);
+
+    // STO and CSV files written by the adapters, with a number of rows that
+    // is not a multiple of the block sizes.
+    TimeSeriesTable table(std::vector<double>{0.0, 0.1, 0.2, 0.3, 0.4},
+            SimTK::Test::randMatrix(5, 3), {"a", "b", "c"});
+    table.updMatrix()(2, 1) = SimTK::NaN;
+    table.addTableMetaData<std::string>("units", "m");
+    STOFileAdapter::write(table, "testDelimFileStreamReader.sto");
+    CSVFileAdapter::write(table, "testDelimFileStreamReader.csv");
+    TimeSeriesTable sto("testDelimFileStreamReader.sto");
+    TimeSeriesTable csv("testDelimFileStreamReader.csv");
+
+    for (bool mapped : {false, true}) {
+        for (int blockSize : {1, 2, 1000}) {
+            checkStreamedTable(motFile, mot, blockSize, mapped);
+            // NaN does not compare equal to itself, so compare the STO and
+            // CSV files without the NaN.
+            DelimFileStreamReader reader(
+                    "testDelimFileStreamReader.sto", blockSize, mapped);
+            DelimFileStreamReader::Block block;
+            std::vector<double> values;
+            while (reader.readNextBlock(block)) {
+                for (int i = 0; i < block.values.nrow(); ++i) {
+                    for (int j = 0; j < block.values.ncol(); ++j) {
+                        values.push_back(block.values(i, j));
+                    }
+                }
+            }
+            REQUIRE(values.size() == 15);
+            CHECK(SimTK::isNaN(values[2 * 3 + 1]));
+            CHECK(values[0] == sto.getMatrix()(0, 0));
+        }
+    }
+
+    // Metadata and conversion of a block to a table.
+    DelimFileStreamReader reader("testDelimFileStreamReader.csv", 2);
+    CHECK(reader.getTableMetaData().getValueForKey("units")
+                  .getValue<std::string>() == "m");
+    DelimFileStreamReader::Block block;
+    REQUIRE(reader.readNextBlock(block));
+    REQUIRE(reader.readNextBlock(block));
+    const TimeSeriesTable blockTable = reader.createTable(block);
+    CHECK(blockTable.getNumRows() == 2);
+    CHECK(blockTable.getColumnLabels() == csv.getColumnLabels());
+    CHECK(blockTable.getIndependentColumn()[0] ==
+            csv.getIndependentColumn()[2]);
+    CHECK(blockTable.getMatrix()(1, 2) == csv.getMatrix()(3, 2));
+}
+
+TEST_CASE("DelimFileStreamReader errors") {
+    CHECK_THROWS_AS(DelimFileStreamReader("nonexistent.sto"),
+            FileDoesNotExist);
+    {
+        std::ofstream out("testDelimFileStreamReader_bad.sto");
+        out << "DataType=double\nendheader\ntime\ta\tb\n"
+               "0\t1\t2\n"
+               "0.1\t1\n"
+               "0.2\t1\tx\n";
+    }
+    DelimFileStreamReader reader("testDelimFileStreamReader_bad.sto", 1);
+    DelimFileStreamReader::Block block;
+    CHECK(reader.readNextBlock(block));
+    CHECK_THROWS_AS(reader.readNextBlock(block), RowLengthMismatch);
+    CHECK_THROWS_AS(reader.readNextBlock(block), Exception);
+
+    {
+        std::ofstream out("testDelimFileStreamReader_vec3.sto");
+        out << "DataType=Vec3\nendheader\ntime\ta\n0\t1,2,3\n";
+    }
+    CHECK_THROWS_AS(DelimFileStreamReader("testDelimFileStreamReader_vec3.sto"),
+            DataTypeMismatch);
+}
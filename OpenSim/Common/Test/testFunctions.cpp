@@ -24,9 +24,16 @@
 #include "ComponentsForTesting.h"
 
 #include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/Constant.h>
+#include <OpenSim/Common/GCVSpline.h>
+#include <OpenSim/Common/LinearFunction.h>
+#include <OpenSim/Common/MultiChannelGCVSpline.h>
+#include <OpenSim/Common/MultiplierFunction.h>
 #include <OpenSim/Common/MultivariatePolynomialFunction.h>
+#include <OpenSim/Common/PiecewiseLinearFunction.h>
 #include <OpenSim/Common/Reporter.h>
 #include <OpenSim/Common/SignalGenerator.h>
+#include <OpenSim/Common/SimmSpline.h>
 #include <OpenSim/Common/Sine.h>
 
 #define CATCH_CONFIG_MAIN
@@ -92,6 +99,108 @@ TEST_CASE("Interpolate using PiecewiseLinearFunction") {
     SimTK_TEST(SimTK::isNaN(newY[3]));
 }
 
+TEST_CASE("Scalar evaluation of functions of one variable") {
+    const int n = 20;
+    double x[n], y[n];
+    for (int i = 0; i < n; ++i) {
+        x[i] = 0.1 * i + 0.02 * (i % 3);
+        y[i] = std::sin(3.0 * x[i]);
+    }
+    std::vector<std::unique_ptr<Function>> functions;
+    functions.emplace_back(new GCVSpline(5, n, x, y));
+    functions.emplace_back(new SimmSpline(n, x, y));
+    functions.emplace_back(new PiecewiseLinearFunction(n, x, y));
+    functions.emplace_back(new LinearFunction(-1.5, 0.3));
+    functions.emplace_back(new Constant(2.7));
+    functions.emplace_back(new Sine(1.5, 3.1, 0.3, 0.12345));
+    functions.emplace_back(
+            new MultiplierFunction(new SimmSpline(n, x, y), -2.0));
+
+    // Increasing and decreasing arguments, as in a simulation, then arguments
+    // in no particular order; the interval found by the previous evaluation
+    // must not affect the result.
+    std::vector<double> args;
+    for (int i = 0; i <= 190; ++i) args.push_back(0.01 * i);
+    for (int i = 190; i >= 0; --i) args.push_back(0.01 * i);
+    SimTK::Random::Uniform random(x[0], x[n - 1]);
+    for (int i = 0; i < 200; ++i) args.push_back(random.getValue());
+
+    for (const auto& f : functions) {
+        CAPTURE(f->getConcreteClassName());
+        for (const double arg : args) {
+            CAPTURE(arg);
+            const SimTK::Vector argAsVector(1, arg);
+            CHECK(f->calcValue(arg) ==
+                    Approx(f->calcValue(argAsVector)).margin(1e-12));
+            CHECK(f->calcDerivative(arg, 0) ==
+                    Approx(f->calcValue(argAsVector)).margin(1e-12));
+            for (int order = 1; order <= 2; ++order) {
+                CHECK(f->calcDerivative(arg, order) ==
+                        Approx(f->calcDerivative(std::vector<int>(order, 0),
+                                       argAsVector))
+                                .margin(1e-9));
+            }
+        }
+    }
+}
+
+TEST_CASE("MultiChannelGCVSpline") {
+    const int n = 30;
+    // More channels than are evaluated together in one block.
+    const int numChannels = 20;
+    double x[n];
+    std::vector<std::vector<double>> y(numChannels, std::vector<double>(n));
+    for (int j = 0; j < n; ++j) {
+        x[j] = 0.01 * j + 0.003 * (j % 2);
+        for (int i = 0; i < numChannels; ++i) {
+            y[i][j] = std::cos((i + 1) * 10.0 * x[j]) + i;
+        }
+    }
+    std::vector<const double*> channels;
+    for (const auto& channel : y) channels.push_back(channel.data());
+
+    for (int degree : {1, 3, 5, 7}) {
+        CAPTURE(degree);
+        MultiChannelGCVSpline spline(degree, n, x, channels);
+        CHECK(spline.getNumChannels() == numChannels);
+        std::vector<std::unique_ptr<GCVSpline>> splines;
+        for (int i = 0; i < numChannels; ++i) {
+            splines.emplace_back(new GCVSpline(degree, n, x, y[i].data()));
+        }
+
+        // Each channel evaluates to the same value as a GCVSpline, whether
+        // all channels or a subset are evaluated.
+        SimTK::Random::Uniform random(x[0] - 0.01, x[n - 1] + 0.01);
+        double values[numChannels];
+        for (int k = 0; k < 200; ++k) {
+            const double arg = k < 100 ? x[0] + 0.003 * k : random.getValue();
+            CAPTURE(arg);
+            for (int order = 0; order <= degree + 1; ++order) {
+                spline.calcDerivatives(arg, order, values);
+                for (int i = 0; i < numChannels; ++i) {
+                    CHECK(values[i] ==
+                            Approx(splines[i]->calcDerivative(arg, order))
+                                    .epsilon(1e-14));
+                }
+                spline.calcDerivatives(arg, order, values, 2, 2);
+                CHECK(values[0] ==
+                        Approx(splines[2]->calcDerivative(arg, order))
+                                .epsilon(1e-14));
+                CHECK(values[1] ==
+                        Approx(splines[3]->calcDerivative(arg, order))
+                                .epsilon(1e-14));
+            }
+        }
+        CHECK_THROWS_WITH(spline.calcValues(0.1, values, 3, 3),
+                Catch::Contains("Expected 3 channels starting at channel 3"));
+    }
+
+    CHECK_THROWS_WITH(MultiChannelGCVSpline(4, n, x, channels),
+            Catch::Contains("Expected degree to be 1, 3, 5, or 7"));
+    CHECK_THROWS_WITH(MultiChannelGCVSpline(3, 3, x, channels),
+            Catch::Contains("Expected at least 4 knots"));
+}
+
 TEST_CASE("MultivariatePolynomialFunction") {
     SECTION("Input errors") {
         {
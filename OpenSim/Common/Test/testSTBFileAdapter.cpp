@@ -0,0 +1,127 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  testSTBFileAdapter.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "OpenSim/Common/Adapters.h"
+#include "OpenSim/Common/Storage.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+#define CATCH_CONFIG_MAIN
+#include <OpenSim/Auxiliary/catch.hpp>
+
+using namespace OpenSim;
+
+TEST_CASE("STBFileAdapter round-trips tables exactly") {
+    TimeSeriesTable table(std::vector<double>{0.0, 0.1, 0.2, 0.3, 0.4},
+            SimTK::Test::randMatrix(5, 3), {"a", "b", "c"});
+    table.updMatrix()(2, 1) = SimTK::NaN;
+    table.addTableMetaData<std::string>("inDegrees", "yes");
+    STBFileAdapter::write(table, "testSTBFileAdapter.stb");
+
+    const auto checkTable = [&](const TimeSeriesTable& actual) {
+        REQUIRE(actual.getNumRows() == table.getNumRows());
+        REQUIRE(actual.getNumColumns() == table.getNumColumns());
+        CHECK(actual.getColumnLabels() == table.getColumnLabels());
+        CHECK(actual.getTableMetaData<std::string>("inDegrees") == "yes");
+        for (int i = 0; i < (int)table.getNumRows(); ++i) {
+            CHECK(actual.getIndependentColumn()[i] ==
+                    table.getIndependentColumn()[i]);
+            for (int j = 0; j < (int)table.getNumColumns(); ++j) {
+                if (i == 2 && j == 1) {
+                    CHECK(SimTK::isNaN(actual.getMatrix()(i, j)));
+                } else {
+                    // Values are stored exactly, not as text.
+                    CHECK(actual.getMatrix()(i, j) == table.getMatrix()(i, j));
+                }
+            }
+        }
+    };
+    SECTION("FileAdapter") {
+        checkTable(TimeSeriesTable("testSTBFileAdapter.stb"));
+    }
+    SECTION("Storage") {
+        Storage storage("testSTBFileAdapter.stb");
+        CHECK(storage.getSize() == (int)table.getNumRows());
+        CHECK(storage.getColumnLabels().getSize() == 4);
+    }
+    SECTION("STBFileView") {
+        STBFileView view("testSTBFileAdapter.stb");
+        CHECK(view.getNumRows() == table.getNumRows());
+        CHECK(view.getNumColumns() == table.getNumColumns());
+        CHECK(view.getColumnLabels() == table.getColumnLabels());
+        CHECK(view.getIndependentColumn()[4] == 0.4);
+        CHECK(view.getMatrix()(3, 2) == table.getMatrix()(3, 2));
+        const SimTK::VectorView c = view.getDependentColumn("c");
+        CHECK(c[1] == table.getMatrix()(1, 2));
+        // The view refers to the mapped file rather than a copy.
+        CHECK(&c[1] == &view.getMatrix()(1, 2));
+        CHECK_THROWS_AS(view.getDependentColumn("d"), KeyNotFound);
+        checkTable(view.createTable());
+    }
+    SECTION("Write a table after removing a column") {
+        TimeSeriesTable copy(table);
+        copy.removeColumn("b");
+        STBFileAdapter::write(copy, "testSTBFileAdapter_removed.stb");
+        TimeSeriesTable actual("testSTBFileAdapter_removed.stb");
+        CHECK(actual.getColumnLabels() == copy.getColumnLabels());
+        CHECK(actual.getMatrix()(4, 1) == table.getMatrix()(4, 2));
+    }
+}
+
+TEST_CASE("STBFileAdapter errors") {
+    CHECK_THROWS_AS(STBFileView("nonexistent.stb"), FileDoesNotExist);
+    {
+        std::ofstream out("testSTBFileAdapter_bad.stb", std::ios::binary);
+        out << "DataType=double\nendheader\n";
+    }
+    CHECK_THROWS_WITH(STBFileView("testSTBFileAdapter_bad.stb"),
+            Catch::Contains("is not an STB file"));
+
+    // Truncate a valid file.
+    TimeSeriesTable table(std::vector<double>{0.0, 0.1},
+            SimTK::Test::randMatrix(2, 2), {"a", "b"});
+    STBFileAdapter::write(table, "testSTBFileAdapter_truncated.stb");
+    std::string contents;
+    {
+        std::ifstream in("testSTBFileAdapter_truncated.stb", std::ios::binary);
+        contents.assign(std::istreambuf_iterator<char>(in),
+                std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream out("testSTBFileAdapter_truncated.stb", std::ios::binary);
+        out.write(contents.data(), contents.size() - 8);
+    }
+    CHECK_THROWS_WITH(STBFileView("testSTBFileAdapter_truncated.stb"),
+            Catch::Contains("is truncated"));
+
+    // A number of rows for which the size of the data overflows to 0.
+    const std::uint64_t numRows = std::uint64_t(1) << 61;
+    std::memcpy(&contents[16], &numRows, sizeof(numRows));
+    {
+        std::ofstream out("testSTBFileAdapter_truncated.stb", std::ios::binary);
+        out.write(contents.data(), contents.size());
+    }
+    CHECK_THROWS_WITH(STBFileView("testSTBFileAdapter_truncated.stb"),
+            Catch::Contains("is truncated"));
+}
@@ -1132,6 +1132,50 @@ void testMonotonicity(SimTK::Matrix mcfSample)
     cout << endl;
 }
 
+/**
+ Tabulates a copy of the curve and checks that its value and first two
+ derivatives are within the tolerance of those of the curve, at points that
+ include the knots of the table, the ends of the Bezier sections and the
+ linear extrapolation regions.
+*/
+void testTabulatedMuscleCurve(const SmoothSegmentedFunction& mcf,
+                              double tol)
+{
+    SmoothSegmentedFunction tabulated(mcf);
+    tabulated.tabulate(tol);
+    SimTK_TEST(tabulated.isTabulated());
+    SimTK_TEST(!mcf.isTabulated());
+
+    SimTK::Vec2 domain = mcf.getCurveDomain();
+    double range = domain(1) - domain(0);
+    SimTK::Vec3 scale(1.0);
+    int n = 10007;
+    for(int order = 0; order <= 2; ++order){
+        for(int i = 0; i <= n; ++i){
+            double x = domain(0) + range*i/n;
+            scale[order] = std::max(scale[order],
+                                    std::abs(mcf.calcDerivative(x, order)));
+        }
+    }
+    for(int i = -100; i <= n + 100; ++i){
+        double x = domain(0) + range*i/n;
+        for(int order = 0; order <= 2; ++order){
+            SimTK_TEST_EQ_TOL(tabulated.calcDerivative(x, order),
+                              mcf.calcDerivative(x, order),
+                              10*tol*scale[order]);
+        }
+        SimTK_TEST_EQ(tabulated.calcValue(x), tabulated.calcDerivative(x, 0));
+        // Higher derivatives are not tabulated.
+        SimTK_TEST_EQ(tabulated.calcDerivative(x, 3),
+                      mcf.calcDerivative(x, 3));
+    }
+    SimTK_TEST_EQ(tabulated.calcValue(domain(1)), mcf.calcValue(domain(1)));
+
+    tabulated.tabulate(0);
+    SimTK_TEST(!tabulated.isTabulated());
+    SimTK_TEST_MUST_THROW(tabulated.tabulate(-1.0));
+}
+
 //______________________________________________________________________________
 /**
  * Create a muscle bench marking system. The bench mark consists of a single muscle 
@@ -1885,6 +1929,19 @@ int main(int argc, char* argv[])
                       shoulderVal, plateauSlope, 1.01,false,"test"));
             cout << "    passed"<<endl;
 
+            cout <<"**************************************************"<<endl;
+            cout <<"TABULATED CURVE TESTING                           "<<endl;
+            for(double tol : {1e-4, 1e-8}){
+                testTabulatedMuscleCurve(tendonCurve, tol);
+                testTabulatedMuscleCurve(fiberFLCurve, tol);
+                testTabulatedMuscleCurve(fiberCECurve, tol);
+                testTabulatedMuscleCurve(fiberCECosPhiCurve, tol);
+                testTabulatedMuscleCurve(fiberFVCurve, tol);
+                testTabulatedMuscleCurve(fiberFVInvCurve, tol);
+                testTabulatedMuscleCurve(fiberfalCurve, tol);
+            }
+            cout << "    passed"<<endl;
+
                     ///////////////////////////////////////
         //FIBER COMPRESSIVE PHI CURVE
         ///////////////////////////////////////
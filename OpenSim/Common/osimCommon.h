@@ -36,6 +36,7 @@
 #include "LoadOpenSimLibrary.h"
 #include "Logger.h"
 #include "ModelDisplayHints.h"
+#include "MultiChannelGCVSpline.h"
 #include "MultiplierFunction.h"
 #include "MultivariatePolynomialFunction.h"
 #include "Object.h"
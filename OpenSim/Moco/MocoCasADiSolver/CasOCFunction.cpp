@@ -20,8 +20,344 @@
 
 #include "CasOCProblem.h"
 
+#include <OpenSim/Common/Logger.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 using namespace CasOC;
 
+namespace {
+class FiniteDifferenceHessian;
+
+/// The Jacobian of a CasOC::Function, computed with finite differences in
+/// which the inputs in each color of the Jacobian's sparsity pattern are
+/// perturbed together. The inputs of this function are the inputs and
+/// outputs of the original function (as CasADi requires), and the output is
+/// the Jacobian of all outputs with respect to all inputs. The entries given
+/// by Function::getAnalyticJacobianEntries() are not differenced, but the
+/// columns are colored on the full sparsity pattern: if two columns of a
+/// color shared a row, even an analytic one, the differences in that row
+/// would mix the effects of both inputs.
+class FiniteDifferenceJacobian : public casadi::Callback {
+public:
+    FiniteDifferenceJacobian(const Function& function,
+            std::vector<std::string> inames, std::vector<std::string> onames,
+            casadi::Sparsity sparsity, std::string scheme)
+            : m_function(function), m_inames(std::move(inames)),
+              m_onames(std::move(onames)), m_sparsity(std::move(sparsity)),
+              m_scheme(std::move(scheme)) {
+        const auto analyticEntries = m_function.getAnalyticJacobianEntries();
+        m_numAnalyticValues = (int)analyticEntries.size();
+        m_isAnalytic.assign(m_sparsity.nnz(), false);
+        for (int i = 0; i < m_numAnalyticValues; ++i) {
+            const casadi_int nz = m_sparsity.get_nz(
+                    analyticEntries[i].first, analyticEntries[i].second);
+            // Skip entries that sparsity detection found to be zero.
+            if (nz < 0) continue;
+            m_analyticNonzeros.emplace_back(i, nz);
+            m_isAnalytic[nz] = true;
+        }
+        m_colors = Function::colorColumns(m_sparsity);
+    }
+
+    int getNumColors() const { return (int)m_colors.size(); }
+    int getNumAnalyticEntries() const {
+        return (int)m_analyticNonzeros.size();
+    }
+
+    casadi_int get_n_in() override {
+        return m_function.n_in() + m_function.n_out();
+    }
+    casadi_int get_n_out() override { return 1; }
+    std::string get_name_in(casadi_int i) override { return m_inames.at(i); }
+    std::string get_name_out(casadi_int i) override {
+        return m_onames.at(i);
+    }
+    casadi::Sparsity get_sparsity_in(casadi_int i) override {
+        const casadi_int numIn = m_function.n_in();
+        return i < numIn ? m_function.sparsity_in(i)
+                         : m_function.sparsity_out(i - numIn);
+    }
+    casadi::Sparsity get_sparsity_out(casadi_int) override {
+        return m_sparsity;
+    }
+
+    /// The derivatives of this Jacobian (second derivatives of the function,
+    /// e.g., for an exact Hessian) are computed by FiniteDifferenceHessian.
+    bool has_jacobian_sparsity() const override { return true; }
+    casadi::Sparsity get_jacobian_sparsity() const override;
+    bool has_jacobian() const override { return true; }
+    casadi::Function get_jacobian(const std::string& name,
+            const std::vector<std::string>& inames,
+            const std::vector<std::string>& onames,
+            const casadi::Dict& opts) const override;
+
+    const Function& getFunction() const { return m_function; }
+    const casadi::Sparsity& getSparsity() const { return m_sparsity; }
+
+    VectorDM eval(const VectorDM& args) const override {
+        using casadi::DM;
+        const casadi_int numIn = m_function.n_in();
+        VectorDM in(args.begin(), args.begin() + numIn);
+        const DM x0 = DM::veccat(in);
+        const bool central = m_scheme == "central";
+        const double sign = m_scheme == "backward" ? -1 : 1;
+        // Step sizes that balance truncation and roundoff error.
+        const double eps = std::numeric_limits<double>::epsilon();
+        const double relStep = central ? std::cbrt(eps) : std::sqrt(eps);
+        std::vector<double> steps(x0.numel());
+        for (casadi_int j = 0; j < x0.numel(); ++j) {
+            steps[j] = sign * relStep * std::max(1.0, std::abs(x0(j).scalar()));
+        }
+
+        // Evaluate the function at x0 plus the given multiple of the steps
+        // for the inputs in the color.
+        const auto evalPerturbed = [&](const std::vector<casadi_int>& color,
+                                           double multiple) {
+            DM x = x0;
+            for (const auto j : color) x(j) = x0(j) + multiple * steps[j];
+            VectorDM xin(numIn);
+            casadi_int offset = 0;
+            for (casadi_int iin = 0; iin < numIn; ++iin) {
+                const auto size = m_function.nnz_in(iin);
+                xin[iin] = x(casadi::Slice(offset, offset + size));
+                offset += size;
+            }
+            return DM::veccat(m_function.eval(xin));
+        };
+
+        DM jacobian(m_sparsity);
+        double* nonzeros = jacobian.ptr();
+        const casadi_int* colind = m_sparsity.colind();
+        const casadi_int* row = m_sparsity.row();
+        const DM output0 =
+                central ? DM() : DM::veccat(m_function.eval(in));
+        for (const auto& color : m_colors) {
+            const DM diff = central ? evalPerturbed(color, 1) -
+                                              evalPerturbed(color, -1)
+                                    : evalPerturbed(color, 1) - output0;
+            const double denominator = central ? 2 : 1;
+            // No two inputs of a color affect the same output, so each
+            // difference is due to a single input.
+            for (const auto j : color) {
+                for (casadi_int k = colind[j]; k < colind[j + 1]; ++k) {
+                    if (m_isAnalytic[k]) continue;
+                    nonzeros[k] = diff(row[k]).scalar() /
+                                  (denominator * steps[j]);
+                }
+            }
+        }
+        if (!m_analyticNonzeros.empty()) {
+            std::vector<double> values(m_numAnalyticValues);
+            m_function.calcAnalyticJacobianEntries(in, values.data());
+            for (const auto& entry : m_analyticNonzeros) {
+                nonzeros[entry.second] = values[entry.first];
+            }
+        }
+        return {jacobian};
+    }
+
+private:
+    const Function& m_function;
+    std::vector<std::string> m_inames;
+    std::vector<std::string> m_onames;
+    casadi::Sparsity m_sparsity;
+    std::string m_scheme;
+    std::vector<std::vector<casadi_int>> m_colors;
+    int m_numAnalyticValues = 0;
+    // Pairs of (index into the analytic values, index into the nonzeros).
+    std::vector<std::pair<int, casadi_int>> m_analyticNonzeros;
+    std::vector<bool> m_isAnalytic;
+    mutable casadi::Sparsity m_hessianSparsity;
+    // The Hessian function must outlive its use by CasADi.
+    mutable std::shared_ptr<casadi::Callback> m_hessian;
+};
+
+/// The Jacobian of a FiniteDifferenceJacobian (that is, the second
+/// derivatives of a CasOC::Function), computed by differencing the
+/// Jacobian. The Jacobian entry (i, j) can depend on input k only if output
+/// i depends on input k, so inputs that affect disjoint sets of outputs also
+/// affect disjoint sets of Jacobian entries, and the inputs of each color of
+/// the function's Jacobian sparsity can be perturbed together. This requires
+/// one Jacobian evaluation (two for central differences) per color. The
+/// rows of the output are the nonzeros of the Jacobian, and the columns are
+/// the inputs of the FiniteDifferenceJacobian (only the inputs of the
+/// original function have nonzero derivatives).
+class FiniteDifferenceHessian : public casadi::Callback {
+public:
+    FiniteDifferenceHessian(const FiniteDifferenceJacobian& jacobian,
+            std::vector<std::string> inames, std::vector<std::string> onames,
+            casadi::Sparsity sparsity, std::string scheme)
+            : m_jacobian(jacobian), m_inames(std::move(inames)),
+              m_onames(std::move(onames)), m_sparsity(std::move(sparsity)),
+              m_scheme(std::move(scheme)) {
+        // Analytic entries depend on the inputs like any other entry.
+        m_colors = Function::colorColumns(m_jacobian.getSparsity());
+    }
+
+    /// The sparsity of the derivative of each nonzero (i, j) of the
+    /// Jacobian with respect to each input k such that (i, k) is a nonzero.
+    static casadi::Sparsity createSparsity(
+            const casadi::Sparsity& jacobianSparsity, casadi_int numColumns) {
+        const casadi_int* colind = jacobianSparsity.colind();
+        const casadi_int* row = jacobianSparsity.row();
+        // The transpose gives the inputs that affect each output.
+        const casadi::Sparsity transpose = jacobianSparsity.T();
+        const casadi_int* rowind = transpose.colind();
+        const casadi_int* col = transpose.row();
+        std::vector<casadi_int> rows;
+        std::vector<casadi_int> cols;
+        for (casadi_int j = 0; j < jacobianSparsity.size2(); ++j) {
+            for (casadi_int k = colind[j]; k < colind[j + 1]; ++k) {
+                const casadi_int i = row[k];
+                for (casadi_int l = rowind[i]; l < rowind[i + 1]; ++l) {
+                    rows.push_back(k);
+                    cols.push_back(col[l]);
+                }
+            }
+        }
+        return casadi::Sparsity::triplet(
+                jacobianSparsity.nnz(), numColumns, rows, cols);
+    }
+
+    int getNumColors() const { return (int)m_colors.size(); }
+
+    casadi_int get_n_in() override {
+        return m_jacobian.n_in() + m_jacobian.n_out();
+    }
+    casadi_int get_n_out() override { return 1; }
+    std::string get_name_in(casadi_int i) override { return m_inames.at(i); }
+    std::string get_name_out(casadi_int i) override {
+        return m_onames.at(i);
+    }
+    casadi::Sparsity get_sparsity_in(casadi_int i) override {
+        const casadi_int numIn = m_jacobian.n_in();
+        return i < numIn ? m_jacobian.sparsity_in(i)
+                         : m_jacobian.sparsity_out(i - numIn);
+    }
+    casadi::Sparsity get_sparsity_out(casadi_int) override {
+        return m_sparsity;
+    }
+
+    VectorDM eval(const VectorDM& args) const override {
+        using casadi::DM;
+        const auto& function = m_jacobian.getFunction();
+        const casadi_int numIn = function.n_in();
+        const casadi_int numJacobianIn = m_jacobian.n_in();
+        const DM x0 = DM::veccat(
+                VectorDM(args.begin(), args.begin() + numIn));
+        const bool central = m_scheme == "central";
+        const double sign = m_scheme == "backward" ? -1 : 1;
+        // Differencing a finite-difference Jacobian amplifies its error, so
+        // the steps are larger than those for the Jacobian.
+        const double eps = std::numeric_limits<double>::epsilon();
+        const double relStep = std::sqrt(std::sqrt(eps));
+        std::vector<double> steps(x0.numel());
+        for (casadi_int k = 0; k < x0.numel(); ++k) {
+            steps[k] = sign * relStep * std::max(1.0, std::abs(x0(k).scalar()));
+        }
+
+        // The nonzeros of the Jacobian at x0 plus the given multiple of the
+        // steps for the inputs in the color. The remaining inputs of the
+        // Jacobian (the nominal outputs of the function) are not used.
+        const auto evalPerturbed = [&](const std::vector<casadi_int>& color,
+                                           double multiple) {
+            DM x = x0;
+            for (const auto k : color) x(k) = x0(k) + multiple * steps[k];
+            VectorDM xin(args.begin(), args.begin() + numJacobianIn);
+            casadi_int offset = 0;
+            for (casadi_int iin = 0; iin < numIn; ++iin) {
+                const auto size = function.nnz_in(iin);
+                xin[iin] = x(casadi::Slice(offset, offset + size));
+                offset += size;
+            }
+            return m_jacobian.eval(xin)[0].nonzeros();
+        };
+
+        DM hessian(m_sparsity);
+        double* nonzeros = hessian.ptr();
+        const casadi_int* colind = m_sparsity.colind();
+        const casadi_int* row = m_sparsity.row();
+        const std::vector<double> jacobian0 =
+                central ? std::vector<double>()
+                        : args.at(numJacobianIn).nonzeros();
+        for (const auto& color : m_colors) {
+            const std::vector<double> plus = evalPerturbed(color, 1);
+            const std::vector<double> base =
+                    central ? evalPerturbed(color, -1) : jacobian0;
+            const double denominator = central ? 2 : 1;
+            for (const auto k : color) {
+                for (casadi_int h = colind[k]; h < colind[k + 1]; ++h) {
+                    nonzeros[h] = (plus[row[h]] - base[row[h]]) /
+                                  (denominator * steps[k]);
+                }
+            }
+        }
+        return {hessian};
+    }
+
+private:
+    const FiniteDifferenceJacobian& m_jacobian;
+    std::vector<std::string> m_inames;
+    std::vector<std::string> m_onames;
+    casadi::Sparsity m_sparsity;
+    std::string m_scheme;
+    std::vector<std::vector<casadi_int>> m_colors;
+};
+
+casadi::Sparsity FiniteDifferenceJacobian::get_jacobian_sparsity() const {
+    if (m_hessianSparsity.is_empty(true)) {
+        m_hessianSparsity = FiniteDifferenceHessian::createSparsity(
+                m_sparsity, m_function.nnz_in() + m_function.nnz_out());
+    }
+    return m_hessianSparsity;
+}
+
+casadi::Function FiniteDifferenceJacobian::get_jacobian(
+        const std::string& name, const std::vector<std::string>& inames,
+        const std::vector<std::string>& onames,
+        const casadi::Dict& opts) const {
+    if (!m_hessian) {
+        auto hessian = std::make_shared<FiniteDifferenceHessian>(*this,
+                inames, onames, get_jacobian_sparsity(), m_scheme);
+        OpenSim::log_debug("CasOC::Function '{}': {} Jacobian evaluations "
+                           "per finite-difference second derivative.",
+                m_function.name(), hessian->getNumColors());
+        hessian->construct(name, opts);
+        m_hessian = hessian;
+    }
+    return *m_hessian;
+}
+
+/// The Jacobian entries of a multibody system function for the problem's
+/// auxiliary dynamics partials. The auxiliary derivatives and residuals
+/// follow the multibody equations in the outputs.
+std::vector<std::pair<casadi_int, casadi_int>>
+createAuxiliaryDynamicsJacobianEntries(const Problem& problem) {
+    const casadi_int rowOffset = problem.getNumMultibodyDynamicsEquations();
+    const casadi_int statesOffset = 1;
+    const casadi_int controlsOffset = statesOffset + problem.getNumStates();
+    const casadi_int derivativesOffset = controlsOffset +
+                                         problem.getNumControls() +
+                                         problem.getNumMultipliers();
+    std::vector<std::pair<casadi_int, casadi_int>> entries;
+    for (const auto& partial : problem.getAuxiliaryDynamicsPartials()) {
+        casadi_int column = partial.index;
+        if (partial.variable == Var::states) {
+            column += statesOffset;
+        } else if (partial.variable == Var::controls) {
+            column += controlsOffset;
+        } else {
+            column += derivativesOffset;
+        }
+        entries.emplace_back(rowOffset + partial.equation, column);
+    }
+    return entries;
+}
+} // anonymous namespace
+
 casadi::Sparsity calcJacobianSparsityWithPerturbation(const VectorDM& x0s,
         int numOutputs,
         std::function<void(const casadi::DM&, casadi::DM&)> function) {
@@ -74,6 +410,7 @@ casadi::Sparsity calcJacobianSparsityWithPerturbation(const VectorDM& x0s,
 }
 
 casadi::Sparsity Function::get_jacobian_sparsity() const {
+    if (!m_jacobianSparsity.is_empty(true)) return m_jacobianSparsity;
     using casadi::DM;
     using casadi::Slice;
 
@@ -100,8 +437,62 @@ casadi::Sparsity Function::get_jacobian_sparsity() const {
 
     const VectorDM x0s = getSubsetPointsForSparsityDetection();
 
-    return calcJacobianSparsityWithPerturbation(
+    m_jacobianSparsity = calcJacobianSparsityWithPerturbation(
             x0s, (int)this->nnz_out(), function);
+    return m_jacobianSparsity;
+}
+
+casadi::Function Function::get_jacobian(const std::string& name,
+        const std::vector<std::string>& inames,
+        const std::vector<std::string>& onames,
+        const casadi::Dict& opts) const {
+    if (!m_jacobian) {
+        auto jacobian = std::make_shared<FiniteDifferenceJacobian>(*this,
+                inames, onames, get_jacobian_sparsity(),
+                m_finite_difference_scheme);
+        OpenSim::log_debug("CasOC::Function '{}': {} evaluations per "
+                           "finite-difference Jacobian instead of {}; {} "
+                           "entries computed analytically.",
+                this->name(), jacobian->getNumColors(), this->nnz_in(),
+                jacobian->getNumAnalyticEntries());
+        // Second derivatives (e.g., an exact Hessian) are computed from the
+        // Jacobian of this Jacobian (FiniteDifferenceHessian) rather than with
+        // CasADi's finite differences, which perturb one input at a time.
+        jacobian->construct(name, opts);
+        m_jacobian = jacobian;
+    }
+    return *m_jacobian;
+}
+
+std::vector<std::vector<casadi_int>> Function::colorColumns(
+        const casadi::Sparsity& sparsity) {
+    const casadi_int numCols = sparsity.size2();
+    const casadi_int* colind = sparsity.colind();
+    const casadi_int* row = sparsity.row();
+    // The transpose gives the columns that have a nonzero in each row.
+    const casadi::Sparsity transpose = sparsity.T();
+    const casadi_int* rowind = transpose.colind();
+    const casadi_int* col = transpose.row();
+
+    std::vector<casadi_int> colors(numCols, -1);
+    // forbidden[c] == j if column j cannot have color c.
+    std::vector<casadi_int> forbidden(numCols, -1);
+    std::vector<std::vector<casadi_int>> colorGroups;
+    for (casadi_int j = 0; j < numCols; ++j) {
+        if (colind[j] == colind[j + 1]) continue;
+        for (casadi_int k = colind[j]; k < colind[j + 1]; ++k) {
+            const casadi_int i = row[k];
+            for (casadi_int l = rowind[i]; l < rowind[i + 1]; ++l) {
+                if (colors[col[l]] >= 0) forbidden[colors[col[l]]] = j;
+            }
+        }
+        casadi_int color = 0;
+        while (forbidden[color] == j) ++color;
+        colors[j] = color;
+        if (color == (casadi_int)colorGroups.size()) colorGroups.emplace_back();
+        colorGroups[color].push_back(j);
+    }
+    return colorGroups;
 }
 
 void Function::constructFunction(const Problem* casProblem,
@@ -111,6 +502,11 @@ void Function::constructFunction(const Problem* casProblem,
     m_casProblem = casProblem;
     m_finite_difference_scheme = finiteDiffScheme;
     m_fullPointsForSparsityDetection = pointsForSparsityDetection;
+    m_useFiniteDifferenceColoring =
+            casProblem->getFiniteDifferenceColoring() &&
+            !pointsForSparsityDetection->empty();
+    m_jacobianSparsity = casadi::Sparsity();
+    m_jacobian.reset();
     casadi::Dict opts;
     setCommonOptions(opts);
     this->construct(name, opts);
@@ -244,6 +640,20 @@ VectorDM MultibodySystemExplicit<CalcKCErrors>::eval(
     return out;
 }
 
+template <bool CalcKCErrors>
+std::vector<std::pair<casadi_int, casadi_int>>
+MultibodySystemExplicit<CalcKCErrors>::getAnalyticJacobianEntries() const {
+    return createAuxiliaryDynamicsJacobianEntries(*m_casProblem);
+}
+
+template <bool CalcKCErrors>
+void MultibodySystemExplicit<CalcKCErrors>::calcAnalyticJacobianEntries(
+        const VectorDM& args, double* values) const {
+    Problem::ContinuousInput input{args.at(0).scalar(), args.at(1), args.at(2),
+            args.at(3), args.at(4), args.at(5)};
+    m_casProblem->calcAuxiliaryDynamicsPartials(input, values);
+}
+
 template class CasOC::MultibodySystemExplicit<false>;
 template class CasOC::MultibodySystemExplicit<true>;
 
@@ -330,5 +740,19 @@ VectorDM MultibodySystemImplicit<CalcKCErrors>::eval(
     return out;
 }
 
+template <bool CalcKCErrors>
+std::vector<std::pair<casadi_int, casadi_int>>
+MultibodySystemImplicit<CalcKCErrors>::getAnalyticJacobianEntries() const {
+    return createAuxiliaryDynamicsJacobianEntries(*m_casProblem);
+}
+
+template <bool CalcKCErrors>
+void MultibodySystemImplicit<CalcKCErrors>::calcAnalyticJacobianEntries(
+        const VectorDM& args, double* values) const {
+    Problem::ContinuousInput input{args.at(0).scalar(), args.at(1), args.at(2),
+            args.at(3), args.at(4), args.at(5)};
+    m_casProblem->calcAuxiliaryDynamicsPartials(input, values);
+}
+
 template class CasOC::MultibodySystemImplicit<false>;
 template class CasOC::MultibodySystemImplicit<true>;
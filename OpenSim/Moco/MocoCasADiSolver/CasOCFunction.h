@@ -36,6 +36,14 @@ public:
             std::shared_ptr<const std::vector<VariablesDM>>
                     pointsForSparsityDetection);
     void setCommonOptions(casadi::Dict& opts) {
+        if (m_useFiniteDifferenceColoring) {
+            // Derivatives are computed from the Jacobian (get_jacobian()).
+            opts["enable_fd"] = false;
+            opts["enable_forward"] = false;
+            opts["enable_reverse"] = false;
+            opts["enable_jacobian"] = true;
+            return;
+        }
         // Compute the derivatives of this function using finite differences.
         opts["enable_fd"] = true;
         opts["fd_method"] = getFiniteDifferenceScheme();
@@ -63,6 +71,38 @@ public:
     }
     casadi::Sparsity get_jacobian_sparsity() const override;
 
+    /// If the sparsity of the Jacobian is known (from sparsity detection) and
+    /// the problem allows it, the Jacobian is computed with finite
+    /// differences in which all inputs of the same color (inputs that affect
+    /// disjoint sets of outputs) are perturbed at once. This requires one
+    /// function evaluation (two for central differences) per color instead of
+    /// per input.
+    bool has_jacobian() const override {
+        return m_useFiniteDifferenceColoring;
+    }
+    casadi::Function get_jacobian(const std::string& name,
+            const std::vector<std::string>& inames,
+            const std::vector<std::string>& onames,
+            const casadi::Dict& opts) const override;
+
+    /// Partition the columns of a sparsity pattern into groups ("colors") of
+    /// columns that have no nonzero rows in common, using a greedy
+    /// (distance-2) coloring. Columns without nonzeros are omitted.
+    static std::vector<std::vector<casadi_int>> colorColumns(
+            const casadi::Sparsity& sparsity);
+
+    /// Entries (row, column) of the Jacobian that
+    /// calcAnalyticJacobianEntries() computes; the Jacobian from
+    /// get_jacobian() does not difference these entries.
+    virtual std::vector<std::pair<casadi_int, casadi_int>>
+    getAnalyticJacobianEntries() const {
+        return {};
+    }
+    /// Compute the entries given by getAnalyticJacobianEntries(), in the same
+    /// order.
+    virtual void calcAnalyticJacobianEntries(
+            const VectorDM& /*args*/, double* /*values*/) const {}
+
 protected:
     const Problem* m_casProblem;
 
@@ -88,9 +128,14 @@ private:
     }
 
     std::string m_finite_difference_scheme = "central";
+    bool m_useFiniteDifferenceColoring = false;
 
     std::shared_ptr<const std::vector<VariablesDM>>
             m_fullPointsForSparsityDetection;
+    // Detecting the sparsity is expensive, so it is done only once.
+    mutable casadi::Sparsity m_jacobianSparsity;
+    // The Jacobian function must outlive its use by CasADi.
+    mutable std::shared_ptr<casadi::Callback> m_jacobian;
 };
 
 class PathConstraint : public Function {
@@ -268,6 +313,12 @@ public:
     }
     casadi::Sparsity get_sparsity_out(casadi_int i) override final;
     VectorDM eval(const VectorDM& args) const override;
+    /// The auxiliary dynamics partials from the problem (see
+    /// Problem::addAuxiliaryDynamicsPartial()).
+    std::vector<std::pair<casadi_int, casadi_int>>
+    getAnalyticJacobianEntries() const override;
+    void calcAnalyticJacobianEntries(
+            const VectorDM& args, double* values) const override;
 };
 
 /// This function should compute a velocity correction term to make feasible
@@ -311,6 +362,10 @@ class MultibodySystemImplicit : public Function {
     }
     casadi::Sparsity get_sparsity_out(casadi_int i) override final;
     VectorDM eval(const VectorDM& args) const override;
+    std::vector<std::pair<casadi_int, casadi_int>>
+    getAnalyticJacobianEntries() const override;
+    void calcAnalyticJacobianEntries(
+            const VectorDM& args, double* values) const override;
 };
 
 } // namespace CasOC
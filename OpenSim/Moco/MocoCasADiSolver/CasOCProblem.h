@@ -79,6 +79,16 @@ struct ParameterInfo {
     std::string name;
     Bounds bounds;
 };
+/// A partial derivative of the auxiliary dynamics that the problem computes
+/// analytically (see Problem::addAuxiliaryDynamicsPartial()).
+struct AuxiliaryDynamicsPartial {
+    /// Index into the auxiliary derivatives followed by the auxiliary
+    /// residuals.
+    int equation;
+    /// Var::states, Var::controls, or Var::derivatives.
+    Var variable;
+    int index;
+};
 
 struct EndpointInfo {
     EndpointInfo(std::string name, int num_outputs,
@@ -299,6 +309,22 @@ protected:
         m_auxiliaryDerivativeNames = names;
         m_numAuxiliaryResiduals = (int)names.size();
     }
+    /// Declare that calcAuxiliaryDynamicsPartials() computes the partial
+    /// derivative of an auxiliary equation with respect to a state, control,
+    /// or derivative variable. The equation index refers to the auxiliary
+    /// derivatives (one per auxiliary state) followed by the auxiliary
+    /// residuals. When the multibody system's Jacobian is computed with
+    /// finite differences over colors (see getFiniteDifferenceColoring()),
+    /// these entries are not differenced. Add these after adding the
+    /// variables.
+    void addAuxiliaryDynamicsPartial(int equation, Var variable, int index) {
+        OPENSIM_THROW_IF(variable != Var::states && variable != Var::controls &&
+                                 variable != Var::derivatives,
+                OpenSim::Exception,
+                "Expected the variable to be states, controls, or "
+                "derivatives.");
+        m_auxiliaryDynamicsPartials.push_back({equation, variable, index});
+    }
 
 public:
     /// Kinematic constraint errors should be ordered as so:
@@ -329,6 +355,11 @@ public:
             const ContinuousInput& /*input*/,
             casadi::DM& /*path_constraint*/) const {}
 
+    /// Compute the partial derivatives declared with
+    /// addAuxiliaryDynamicsPartial(), in the order in which they were added.
+    virtual void calcAuxiliaryDynamicsPartials(
+            const ContinuousInput& /*input*/, double* /*partials*/) const {}
+
     virtual std::vector<std::string>
     createKinematicConstraintEquationNamesImpl() const;
 
@@ -380,9 +411,11 @@ public:
     }
 
     void initialize(const std::string& finiteDiffScheme,
+            bool finiteDiffColoring,
             std::shared_ptr<const std::vector<VariablesDM>>
                     pointsForSparsityDetection) const {
         auto* mutThis = const_cast<Problem*>(this);
+        mutThis->m_finiteDifferenceColoring = finiteDiffColoring;
 
         {
             int index = 0;
@@ -472,6 +505,15 @@ public:
     int getNumParameters() const { return (int)m_paramInfos.size(); }
     int getNumMultipliers() const { return (int)m_multiplierInfos.size(); }
     std::string getDynamicsMode() const { return m_dynamicsMode; }
+    /// Whether CasOC::Function%s with a known Jacobian sparsity compute their
+    /// Jacobians with finite differences over colors of inputs.
+    bool getFiniteDifferenceColoring() const {
+        return m_finiteDifferenceColoring;
+    }
+    const std::vector<AuxiliaryDynamicsPartial>&
+    getAuxiliaryDynamicsPartials() const {
+        return m_auxiliaryDynamicsPartials;
+    }
     bool isDynamicsModeImplicit() const { return m_isDynamicsModeImplicit; }
     int getNumDerivatives() const {
         return getNumAccelerations() + getNumAuxiliaryResidualEquations();
@@ -614,7 +656,9 @@ private:
     int m_numAccelerationConstraintEquations = 0;
     bool m_enforceConstraintDerivatives = false;
     std::string m_dynamicsMode = "explicit";
+    bool m_finiteDifferenceColoring = false;
     std::vector<std::string> m_auxiliaryDerivativeNames;
+    std::vector<AuxiliaryDynamicsPartial> m_auxiliaryDynamicsPartials;
     bool m_isDynamicsModeImplicit = false;
     bool m_prescribedKinematics = false;
     int m_numMultibodyDynamicsEquationsIfPrescribedKinematics = 0;
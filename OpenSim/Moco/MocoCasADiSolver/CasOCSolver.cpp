@@ -92,9 +92,15 @@ Solution Solver::solve(const Iterate& guess) const {
         }
     }
     m_problem.initialize(m_finite_difference_scheme,
+            m_finite_difference_coloring,
             std::const_pointer_cast<const std::vector<VariablesDM>>(
                     pointsForSparsityDetection));
     return transcription->solve(guess);
 }
 
+casadi::DM Solver::evalDefects(const Iterate& iterate) const {
+    auto transcription = createTranscription();
+    return transcription->evalDefects(iterate);
+}
+
 } // namespace CasOC
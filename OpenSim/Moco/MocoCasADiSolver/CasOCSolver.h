@@ -124,6 +124,17 @@ public:
         return m_finite_difference_scheme;
     }
 
+    /// If sparsity detection is enabled, compute the Jacobian of each
+    /// CasOC::Function with finite differences in which structurally
+    /// independent inputs are perturbed together (graph coloring).
+    /// @note Default is true.
+    void setFiniteDifferenceColoring(bool tf) {
+        m_finite_difference_coloring = tf;
+    }
+    bool getFiniteDifferenceColoring() const {
+        return m_finite_difference_coloring;
+    }
+
     void setCallbackInterval(int callbackInterval) {
         m_callbackInterval = callbackInterval;
     }
@@ -171,6 +182,12 @@ public:
 
     Solution solve(const Iterate& guess) const;
 
+    /// Evaluate the defect constraints of the transcription on this solver's
+    /// mesh for the provided iterate (see Transcription::evalDefects()).
+    /// solve() must have been called on a solver for the same problem, so
+    /// that the problem's functions are initialized.
+    casadi::DM evalDefects(const Iterate& iterate) const;
+
 private:
     std::unique_ptr<Transcription> createTranscription() const;
 
@@ -187,6 +204,7 @@ private:
     Bounds m_implicitMultibodyAccelerationBounds;
     Bounds m_implicitAuxiliaryDerivativeBounds;
     std::string m_finite_difference_scheme = "central";
+    bool m_finite_difference_coloring = true;
     std::string m_sparsity_detection = "none";
     std::string m_write_sparsity;
     int m_callbackInterval = 0;
@@ -592,40 +592,7 @@ Solution Transcription::solve(const Iterate& guessOrig) {
 
     // Resample the guess.
     // -------------------
-    const auto guessTimes = createTimes(guessOrig.variables.at(initial_time),
-            guessOrig.variables.at(final_time));
-    auto guess = guessOrig.resample(guessTimes);
-
-    // Adjust guesses for the slack variables to ensure they are the correct
-    // length (i.e. slacks.size2() == m_numPointsIgnoringConstraints).
-    if (guess.variables.find(Var::slacks) != guess.variables.end()) {
-        auto& slacks = guess.variables.at(Var::slacks);
-
-        // If slack variables provided in the guess are equal to the grid
-        // length, remove the elements on the mesh points where the slack
-        // variables are not defined.
-        if (slacks.size2() == m_numGridPoints) {
-            casadi::DM meshIndices = createMeshIndices();
-            std::vector<casadi_int> slackColumnsToRemove;
-            for (int itime = 0; itime < m_numGridPoints; ++itime) {
-                if (meshIndices(itime).__nonzero__()) {
-                    slackColumnsToRemove.push_back(itime);
-                }
-            }
-            // The first argument is an empty vector since we don't want to
-            // remove an entire row.
-            slacks.remove(std::vector<casadi_int>(), slackColumnsToRemove);
-        }
-
-        // Check that either that the slack variables provided in the guess
-        // are the correct length, or that the correct number of columns
-        // were removed.
-        OPENSIM_THROW_IF(slacks.size2() != m_numMeshInteriorPoints,
-                OpenSim::Exception,
-                "Expected slack variables to be length {}, but they are length "
-                "{}.",
-                m_numMeshInteriorPoints, slacks.size2());
-    }
+    const auto guess = resampleToGrid(guessOrig);
 
     // Create the CasADi NLP function.
     // -------------------------------
@@ -720,6 +687,55 @@ Solution Transcription::solve(const Iterate& guessOrig) {
     return solution;
 }
 
+Iterate Transcription::resampleToGrid(const Iterate& iterate) const {
+    const auto times = createTimes(iterate.variables.at(initial_time),
+            iterate.variables.at(final_time));
+    auto resampled = iterate.resample(times);
+
+    // Adjust the slack variables to ensure they are the correct
+    // length (i.e. slacks.size2() == m_numPointsIgnoringConstraints).
+    if (resampled.variables.find(Var::slacks) != resampled.variables.end()) {
+        auto& slacks = resampled.variables.at(Var::slacks);
+
+        // If slack variables provided in the iterate are equal to the grid
+        // length, remove the elements on the mesh points where the slack
+        // variables are not defined.
+        if (slacks.size2() == m_numGridPoints) {
+            casadi::DM meshIndices = createMeshIndices();
+            std::vector<casadi_int> slackColumnsToRemove;
+            for (int itime = 0; itime < m_numGridPoints; ++itime) {
+                if (meshIndices(itime).__nonzero__()) {
+                    slackColumnsToRemove.push_back(itime);
+                }
+            }
+            // The first argument is an empty vector since we don't want to
+            // remove an entire row.
+            slacks.remove(std::vector<casadi_int>(), slackColumnsToRemove);
+        }
+
+        // Check that either that the slack variables provided in the iterate
+        // are the correct length, or that the correct number of columns
+        // were removed.
+        OPENSIM_THROW_IF(slacks.size2() != m_numMeshInteriorPoints,
+                OpenSim::Exception,
+                "Expected slack variables to be length {}, but they are length "
+                "{}.",
+                m_numMeshInteriorPoints, slacks.size2());
+    }
+    return resampled;
+}
+
+casadi::DM Transcription::evalDefects(const Iterate& iterate) {
+    transcribe();
+    const auto resampled = resampleToGrid(iterate);
+    casadi::Function defectsFunc("defects", {flattenVariables(m_vars)},
+            {m_constraints.defects});
+    casadi::DMVector out;
+    defectsFunc.call(
+            casadi::DMVector{flattenVariables(resampled.variables)}, out);
+    return out[0];
+}
+
 void Transcription::printConstraintValues(const Iterate& it,
         const Constraints<casadi::DM>& constraints,
         std::ostream& stream) const {
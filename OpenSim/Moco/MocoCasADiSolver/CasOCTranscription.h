@@ -64,6 +64,12 @@ public:
 
     Solution solve(const Iterate& guessOrig);
 
+    /// Evaluate the defect constraints for the provided iterate after
+    /// resampling the iterate onto this transcription's grid. The returned
+    /// matrix has a column for each mesh interval. This is used to estimate
+    /// the error of a solution obtained on a different (coarser) mesh.
+    casadi::DM evalDefects(const Iterate& iterate);
+
 protected:
     /// This must be called in the constructor of derived classes so that
     /// overridden virtual methods are accessible to the base class. This
@@ -171,6 +177,9 @@ private:
     }
 
     void transcribe();
+    /// Resample the iterate onto the grid, adjusting the length of the slack
+    /// variables as necessary.
+    Iterate resampleToGrid(const Iterate& iterate) const;
     void setObjectiveAndEndpointConstraints();
     void calcDefects() {
         calcDefectsImpl(m_vars.at(states), m_xdot, m_constraints.defects);
@@ -37,6 +37,57 @@
 
 using namespace OpenSim;
 
+#ifdef OPENSIM_WITH_CASADI
+namespace {
+/// Return the mesh of the solution with each interval bisected if its
+/// estimated error exceeds the tolerance. The error of an interval is the
+/// largest scaled defect of the solution on checkSolver's mesh, which is set
+/// to the solution's mesh with every interval bisected.
+std::vector<double> refineMesh(const std::vector<double>& mesh,
+        const CasOC::Solution& solution, CasOC::Solver& checkSolver,
+        double tolerance, double& maxError) {
+    std::vector<double> bisected;
+    for (int imesh = 0; imesh < (int)mesh.size() - 1; ++imesh) {
+        bisected.push_back(mesh[imesh]);
+        bisected.push_back(0.5 * (mesh[imesh] + mesh[imesh + 1]));
+    }
+    bisected.push_back(mesh.back());
+    checkSolver.setMesh(bisected);
+    const DM defects = checkSolver.evalDefects(solution);
+
+    // Scale the defects by the magnitude of their states, so that the error
+    // is relative for large states and absolute for small states.
+    const DM& states = solution.variables.at(CasOC::states);
+    const int NS = (int)states.size1();
+    std::vector<double> scale(NS, 1.0);
+    for (int istate = 0; istate < NS; ++istate) {
+        for (int itime = 0; itime < (int)states.size2(); ++itime) {
+            scale[istate] = std::max(scale[istate],
+                    1.0 + std::abs(states(istate, itime).scalar()));
+        }
+    }
+
+    std::vector<double> refined;
+    maxError = 0;
+    for (int imesh = 0; imesh < (int)mesh.size() - 1; ++imesh) {
+        double error = 0;
+        for (int ihalf = 2 * imesh; ihalf < 2 * imesh + 2; ++ihalf) {
+            for (int irow = 0; irow < (int)defects.size1(); ++irow) {
+                error = std::max(error,
+                        std::abs(defects(irow, ihalf).scalar()) /
+                                scale[irow % NS]);
+            }
+        }
+        maxError = std::max(maxError, error);
+        refined.push_back(mesh[imesh]);
+        if (error > tolerance) refined.push_back(bisected[2 * imesh + 1]);
+    }
+    refined.push_back(mesh.back());
+    return refined;
+}
+} // anonymous namespace
+#endif
+
 MocoCasADiSolver::MocoCasADiSolver() { constructProperties(); }
 
 void MocoCasADiSolver::constructProperties() {
@@ -44,6 +95,9 @@ void MocoCasADiSolver::constructProperties() {
     constructProperty_optim_sparsity_detection("none");
     constructProperty_optim_write_sparsity("");
     constructProperty_optim_finite_difference_scheme("central");
+    constructProperty_optim_finite_difference_coloring(true);
+    constructProperty_mesh_refinement_max_iterations(0);
+    constructProperty_mesh_refinement_tolerance(1e-3);
     constructProperty_parallel();
     constructProperty_output_interval(0);
 
@@ -277,6 +331,8 @@ std::unique_ptr<CasOC::Solver> MocoCasADiSolver::createCasOCSolver(
     checkPropertyValueIsInSet(getProperty_optim_finite_difference_scheme(),
             {"central", "forward", "backward"});
     casSolver->setFiniteDifferenceScheme(get_optim_finite_difference_scheme());
+    casSolver->setFiniteDifferenceColoring(
+            get_optim_finite_difference_coloring());
 
     casSolver->setCallbackInterval(get_output_interval());
 
@@ -334,6 +390,51 @@ std::unique_ptr<CasOC::Solver> MocoCasADiSolver::createCasOCSolver(
 #endif
 }
 
+SimTK::Matrix MocoCasADiSolver::calcMultibodySystemJacobian(
+        const MocoTrajectory& trajectory) const {
+#ifdef OPENSIM_WITH_CASADI
+    OPENSIM_THROW_IF_FRMOBJ(get_multibody_dynamics_mode() != "explicit",
+            Exception,
+            "Expected multibody_dynamics_mode to be 'explicit', but it is "
+            "'{}'.",
+            get_multibody_dynamics_mode());
+    auto casProblem = createCasOCProblem();
+    CasOC::Iterate iterate = convertToCasOCIterate(trajectory);
+    auto& variables = iterate.variables;
+    if (!variables.count(CasOC::derivatives)) {
+        variables[CasOC::derivatives] =
+                DM::zeros(casProblem->getNumDerivatives(), 1);
+    }
+    // The trajectory is also the point at which the sparsity is detected.
+    casProblem->initialize(get_optim_finite_difference_scheme(),
+            get_optim_finite_difference_coloring(),
+            std::make_shared<const std::vector<CasOC::VariablesDM>>(
+                    1, variables));
+
+    const casadi::Function& function = casProblem->getMultibodySystem();
+    std::vector<DM> in{variables.at(CasOC::initial_time),
+            variables.at(CasOC::states)(Slice(), 0),
+            variables.at(CasOC::controls)(Slice(), 0),
+            variables.at(CasOC::multipliers)(Slice(), 0),
+            variables.at(CasOC::derivatives)(Slice(), 0),
+            variables.at(CasOC::parameters)};
+    // The Jacobian function also takes the nominal outputs.
+    const std::vector<DM> out = function(in);
+    in.insert(in.end(), out.begin(), out.end());
+    const DM jacobian = function.jacobian()(in).at(0);
+
+    SimTK::Matrix simtkJacobian((int)jacobian.rows(), (int)jacobian.columns());
+    for (int irow = 0; irow < jacobian.rows(); ++irow) {
+        for (int icol = 0; icol < jacobian.columns(); ++icol) {
+            simtkJacobian(irow, icol) = double(jacobian(irow, icol));
+        }
+    }
+    return simtkJacobian;
+#else
+    OPENSIM_THROW(MocoCasADiSolverNotAvailable);
+#endif
+}
+
 MocoSolution MocoCasADiSolver::solveImpl() const {
 #ifdef OPENSIM_WITH_CASADI
     const Stopwatch stopwatch;
@@ -359,17 +460,45 @@ MocoSolution MocoCasADiSolver::solveImpl() const {
         casGuess = convertToCasOCIterate(guess);
     }
 
-    // Temporarily disable printing of negative muscle force warnings so the
-    // log isn't flooded while computing finite differences.
-    Logger::Level origLoggerLevel = Logger::getLevel();
-    Logger::setLevel(Logger::Level::Warn);
+    checkPropertyValueIsInRangeOrSet(
+            getProperty_mesh_refinement_max_iterations(), 0,
+            std::numeric_limits<int>::max(), {});
+    OPENSIM_THROW_IF_FRMOBJ(get_mesh_refinement_tolerance() <= 0, Exception,
+            "Expected mesh_refinement_tolerance to be positive, but it is {}.",
+            get_mesh_refinement_tolerance());
+
     CasOC::Solution casSolution;
-    try {
-        casSolution = casSolver->solve(casGuess);
-    } catch (...) {
-        OpenSim::Logger::setLevel(origLoggerLevel);
+    int numIterations = 0;
+    for (int irefine = 0;; ++irefine) {
+        {
+            // Temporarily disable printing of negative muscle force warnings
+            // so the log isn't flooded while computing finite differences.
+            LogLevelWarnGuard logLevelGuard;
+            casSolution = casSolver->solve(casGuess);
+        }
+        numIterations += (int)casSolution.stats.at("iter_count");
+
+        if (irefine == get_mesh_refinement_max_iterations() ||
+                !casSolution.stats.at("success")) {
+            break;
+        }
+        const auto& mesh = casSolver->getMesh();
+        auto checkSolver = createCasOCSolver(*casProblem);
+        double maxError;
+        auto refinedMesh = refineMesh(mesh, casSolution, *checkSolver,
+                get_mesh_refinement_tolerance(), maxError);
+        if (get_verbosity()) {
+            log_info("Mesh refinement {}: {} mesh intervals, maximum estimated "
+                     "error {}; bisecting {} intervals.",
+                    irefine + 1, mesh.size() - 1, maxError,
+                    refinedMesh.size() - mesh.size());
+        }
+        if (refinedMesh.size() == mesh.size()) break;
+        casSolver->setMesh(std::move(refinedMesh));
+        // Warm-start the next solve; the solution is resampled onto the
+        // refined mesh.
+        casGuess = casSolution;
     }
-    OpenSim::Logger::setLevel(origLoggerLevel);
 
     MocoSolution mocoSolution =
             convertToMocoTrajectory<MocoSolution>(casSolution);
@@ -422,7 +551,7 @@ MocoSolution MocoCasADiSolver::solveImpl() const {
     const long long elapsed = stopwatch.getElapsedTimeInNs();
     setSolutionStats(mocoSolution, casSolution.stats.at("success"),
             casSolution.objective, casSolution.stats.at("return_status"),
-            casSolution.stats.at("iter_count"), SimTK::nsToSec(elapsed),
+            numIterations, SimTK::nsToSec(elapsed),
             casSolution.objective_breakdown);
 
     if (get_verbosity()) {
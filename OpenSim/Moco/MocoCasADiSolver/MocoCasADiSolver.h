@@ -71,6 +71,54 @@ The "central" finite difference is more accurate but can be 2 times
 slower than "forward" (tested on exampleSlidingMass). Sometimes, problems
 may struggle to converge with "forward".
 
+When sparsity detection is enabled, the Jacobian of each function that invokes
+OpenSim is computed by perturbing many inputs at once: inputs that affect
+disjoint sets of outputs are grouped ("colored") using the detected sparsity
+pattern, so the number of model evaluations per Jacobian is the number of
+groups rather than the number of inputs. With coloring, the partial
+derivatives of the tendon compliance dynamics of each
+DeGrooteFregly2016Muscle with respect to the muscle's own activation,
+normalized tendon force, and normalized tendon force derivative variables are
+computed analytically (see DeGrooteFregly2016Muscle::calcPartials()) rather
+than with finite differences. Set optim_finite_difference_coloring to false
+to perturb one input at a time.
+
+Exact Hessian
+=============
+With optim_hessian_approximation set to "exact", IPOPT takes Newton steps
+using the Hessian of the Lagrangian, which often requires far fewer
+iterations than the "limited-memory" quasi-Newton approximation, though each
+iteration costs more. The functions that invoke OpenSim are evaluated
+separately at each mesh point, so the Hessian is block-sparse, and each
+block is built from the second derivatives of one function at one mesh
+point. With coloring (see above), these second derivatives are computed by
+differencing the colored finite-difference Jacobian with the same grouping
+of inputs: the entries of the Jacobian for an output depend only on the
+inputs that affect that output. The cost of the second derivatives of a
+function is then roughly the square of the number of groups, rather than the
+number of groups times the number of inputs. The mesh points are processed
+in parallel (see Parallelization). Without coloring, CasADi computes the
+second derivatives with finite differences, one input at a time. Whether
+"exact" is faster overall depends on the problem; compare the number of
+iterations and the solver duration of the two settings.
+
+Mesh refinement
+===============
+Instead of choosing a fine mesh by hand, you can solve the problem on a coarse
+mesh (e.g., with a small num_mesh_intervals) and let the solver refine the
+mesh only where the solution is inaccurate. If mesh_refinement_max_iterations
+is greater than 0, after each solve the solver estimates the error in each
+mesh interval by resampling the solution onto a mesh in which every interval
+is bisected and evaluating the defect constraints there: these constraints
+are satisfied at the collocation points but generally not between them. Each
+defect is divided by 1 plus the maximum magnitude of its state. Intervals in
+which the estimated error exceeds mesh_refinement_tolerance are bisected, and
+the problem is solved again on the new mesh, using the previous solution
+(interpolated) as the initial guess. Refinement stops when no interval
+exceeds the tolerance, when the maximum number of refinements is reached, or
+if a solve fails. The returned solution is from the last solve, and its
+number of iterations is the total across all solves.
+
 Parallelization
 ===============
 By default, CasADi evaluate the integral cost integrand and the
@@ -100,17 +148,19 @@ parallelization they prefer.
 
 Parameter variables
 ===================
-By default, MocoCasADiSolver is much slower than MocoTroperSolver at
-handling problems with MocoParameters. Many parameters require invoking
-Model::initSystem() to take effect, and this function is expensive (for
-CasADi, we must invoke this function for every time point, while in Tropter,
-we can invoke the function only once for every NLP iterate). However, if you
-know that all parameters in your problem do not require Model::initSystem(),
-you can substantially speed up your optimization by setting the
-parameters_require_initsystem property to false. Be careful, though: you
-will end up with incorrect results if your parameter does indeed require
-Model::initSystem(). To protect against this, ensure that you obtain the
-same results whether this setting is true or false.
+Many parameters require invoking Model::initSystem() to take effect, and
+this function is expensive. Each thread evaluates the problem with its own
+copy of the model, and a copy's Model::initSystem() is invoked only when the
+parameter values differ from those the copy last used; only the changed
+parameters are applied. Therefore, Model::initSystem() is invoked roughly
+once per thread for each new parameter iterate (and for each perturbation of
+a parameter when computing derivatives) rather than for every time point.
+Still, if you know that all parameters in your problem do not require
+Model::initSystem(), you can substantially speed up your optimization by
+setting the parameters_require_initsystem property to false. Be careful,
+though: you will end up with incorrect results if your parameter does indeed
+require Model::initSystem(). To protect against this, ensure that you obtain
+the same results whether this setting is true or false.
 
 @note The software license of CasADi (LGPL) is more restrictive than that of
 the rest of Moco (Apache 2.0).
@@ -137,6 +187,18 @@ public:
     OpenSim_DECLARE_PROPERTY(optim_finite_difference_scheme, std::string,
             "The finite difference scheme CasADi will use to calculate problem "
             "derivatives (default: 'central').");
+    OpenSim_DECLARE_PROPERTY(optim_finite_difference_coloring, bool,
+            "If sparsity detection is enabled, compute the Jacobians of the "
+            "problem's functions by perturbing inputs that affect disjoint "
+            "sets of outputs together (graph coloring), so that fewer model "
+            "evaluations are needed (default: true).");
+    OpenSim_DECLARE_PROPERTY(mesh_refinement_max_iterations, int,
+            "The maximum number of times to refine the mesh and solve again "
+            "(default: 0, no refinement). See 'Mesh refinement' in the class "
+            "documentation.");
+    OpenSim_DECLARE_PROPERTY(mesh_refinement_tolerance, double,
+            "Mesh intervals whose estimated relative error exceeds this value "
+            "are bisected during mesh refinement (default: 1e-3).");
 
     OpenSim_DECLARE_OPTIONAL_PROPERTY(parallel, int,
             "Evaluate integral costs and the differential-algebraic "
@@ -227,6 +289,19 @@ protected:
     /// solver.
     void checkGuess(const MocoTrajectory& guess) const;
 
+    /// Compute the Jacobian of the multibody system function (explicit
+    /// multibody dynamics mode) at the first time point of the trajectory,
+    /// the way the optimizer would, using the finite difference settings of
+    /// this solver. The rows are the outputs (multibody derivatives,
+    /// auxiliary derivatives, auxiliary residuals, and kinematic constraint
+    /// errors) and the columns are the inputs (time, states, controls,
+    /// multipliers, derivatives, and parameters). This allows checking the
+    /// Jacobian computed with finite difference coloring (see
+    /// optim_finite_difference_coloring) against the Jacobian computed by
+    /// perturbing one input at a time.
+    SimTK::Matrix calcMultibodySystemJacobian(
+            const MocoTrajectory& trajectory) const;
+
 private:
     void constructProperties();
 
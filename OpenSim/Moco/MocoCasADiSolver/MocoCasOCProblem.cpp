@@ -22,6 +22,8 @@
 
 #include <OpenSim/Simulation/SimulationUtilities.h>
 
+#include <algorithm>
+
 using namespace OpenSim;
 
 thread_local SimTK::Vector_<SimTK::SpatialVec>
@@ -95,6 +97,8 @@ MocoCasOCProblem::MocoCasOCProblem(const MocoCasADiSolver& mocoCasADiSolver,
 
     setAuxiliaryDerivativeNames(derivativeNames);
 
+    addMuscleDynamicsPartials(problemRep, stateNames, controlNames);
+
     // Add any scalar constraints associated with kinematic constraints in
     // the model as path constraints in the problem.
     // Whether or not enabled kinematic constraints exist in the model,
@@ -253,3 +257,85 @@ MocoCasOCProblem::MocoCasOCProblem(const MocoCasADiSolver& mocoCasADiSolver,
             fmt::format("delete_this_to_stop_optimization_{}_{}.txt",
                     problemRep.getName(), m_formattedTimeString));
 }
+
+void MocoCasOCProblem::addMuscleDynamicsPartials(
+        const MocoProblemRep& problemRep,
+        const std::vector<std::string>& stateNames,
+        const std::vector<std::string>& controlNames) {
+    const auto indexOf = [](const std::vector<std::string>& names,
+                                 const std::string& name) {
+        const auto it = std::find(names.begin(), names.end(), name);
+        return it == names.end() ? -1 : (int)(it - names.begin());
+    };
+    const int numMultibodyStates = getNumCoordinates() + getNumSpeeds();
+    const auto& implicitRefs = problemRep.getImplicitComponentReferencePtrs();
+
+    const auto& model = problemRep.getModelDisabledConstraints();
+    for (const auto& muscle :
+            model.getComponentList<DeGrooteFregly2016Muscle>()) {
+        if (!muscle.get_appliesForce() ||
+                muscle.get_ignore_tendon_compliance()) {
+            continue;
+        }
+        const std::string path = muscle.getAbsolutePathString();
+        MuscleDynamicsPartialsInfo info;
+        info.musclePath = path;
+        info.activationIsControl = muscle.get_ignore_activation_dynamics();
+        info.activationIndex =
+                info.activationIsControl
+                        ? indexOf(controlNames, path)
+                        : indexOf(stateNames,
+                                  path + "/" +
+                                          DeGrooteFregly2016Muscle::
+                                                  getActivationStateName());
+        info.normTendonForceIndex = indexOf(stateNames,
+                path + "/" +
+                        DeGrooteFregly2016Muscle::
+                                getNormalizedTendonForceStateName());
+        if (info.activationIndex < 0 || info.normTendonForceIndex < 0) {
+            continue;
+        }
+        info.isTendonDynamicsExplicit =
+                muscle.get_tendon_compliance_dynamics_mode() == "explicit";
+        info.normTendonForceDerivativeIndex = -1;
+        int residualIndex = -1;
+        if (!info.isTendonDynamicsExplicit) {
+            for (int i = 0; i < (int)implicitRefs.size(); ++i) {
+                if (&implicitRefs[i].second.getRef() == &muscle) {
+                    residualIndex = i;
+                }
+            }
+            if (residualIndex < 0) continue;
+            info.normTendonForceDerivativeIndex =
+                    getNumAccelerations() + residualIndex;
+        }
+        info.firstPartial = (int)getAuxiliaryDynamicsPartials().size();
+
+        // The order must match that in calcAuxiliaryDynamicsPartials().
+        const auto activationVar =
+                info.activationIsControl ? CasOC::Var::controls
+                                         : CasOC::Var::states;
+        const int derivativeEquation =
+                info.normTendonForceIndex - numMultibodyStates;
+        if (info.isTendonDynamicsExplicit) {
+            addAuxiliaryDynamicsPartial(
+                    derivativeEquation, activationVar, info.activationIndex);
+            addAuxiliaryDynamicsPartial(derivativeEquation, CasOC::Var::states,
+                    info.normTendonForceIndex);
+        } else {
+            const int residualEquation =
+                    getNumAuxiliaryStates() + residualIndex;
+            addAuxiliaryDynamicsPartial(derivativeEquation,
+                    CasOC::Var::derivatives,
+                    info.normTendonForceDerivativeIndex);
+            addAuxiliaryDynamicsPartial(
+                    residualEquation, activationVar, info.activationIndex);
+            addAuxiliaryDynamicsPartial(residualEquation, CasOC::Var::states,
+                    info.normTendonForceIndex);
+            addAuxiliaryDynamicsPartial(residualEquation,
+                    CasOC::Var::derivatives,
+                    info.normTendonForceDerivativeIndex);
+        }
+        m_muscleDynamicsPartials.push_back(std::move(info));
+    }
+}
@@ -483,6 +483,62 @@ private:
 
         m_jar->leave(std::move(mocoProblemRep));
     }
+    void calcAuxiliaryDynamicsPartials(const ContinuousInput& input,
+            double* partials) const override {
+        auto mocoProblemRep = m_jar->take();
+
+        // Muscle-tendon lengths and velocities require realizing to Velocity.
+        applyInput(SimTK::Stage::Velocity, input.time, input.states,
+                input.controls, input.multipliers, input.derivatives,
+                input.parameters, mocoProblemRep);
+        const auto& modelDisabledConstraints =
+                mocoProblemRep->getModelDisabledConstraints();
+        auto& simtkStateDisabledConstraints =
+                mocoProblemRep->updStateDisabledConstraints();
+        modelDisabledConstraints.realizeVelocity(simtkStateDisabledConstraints);
+
+        for (const auto& info : m_muscleDynamicsPartials) {
+            const auto& muscle = modelDisabledConstraints
+                    .getComponent<DeGrooteFregly2016Muscle>(info.musclePath);
+            const double activation =
+                    info.activationIsControl
+                            ? *(input.controls.ptr() + info.activationIndex)
+                            : *(input.states.ptr() + info.activationIndex);
+            const double normTendonForce =
+                    *(input.states.ptr() + info.normTendonForceIndex);
+            const double normTendonForceDerivative =
+                    info.isTendonDynamicsExplicit
+                            ? SimTK::NaN
+                            : *(input.derivatives.ptr() +
+                                      info.normTendonForceDerivativeIndex);
+            const auto muscleTendonPartials = muscle.calcPartials(
+                    muscle.getLength(simtkStateDisabledConstraints),
+                    muscle.getLengtheningSpeed(simtkStateDisabledConstraints),
+                    activation, normTendonForce, normTendonForceDerivative);
+
+            // The order must match that in addMuscleDynamicsPartials().
+            double* muscleTendonPartialsOut = partials + info.firstPartial;
+            if (info.isTendonDynamicsExplicit) {
+                muscleTendonPartialsOut[0] = muscleTendonPartials
+                        .partialNormTendonForceDerivativePartialActivation;
+                muscleTendonPartialsOut[1] = muscleTendonPartials
+                        .partialNormTendonForceDerivativePartialNormTendonForce;
+            } else {
+                // The derivative of the normalized tendon force state is the
+                // derivative variable.
+                muscleTendonPartialsOut[0] = 1.0;
+                muscleTendonPartialsOut[1] = muscleTendonPartials
+                        .partialEquilibriumResidualPartialActivation;
+                muscleTendonPartialsOut[2] = muscleTendonPartials
+                        .partialEquilibriumResidualPartialNormTendonForce;
+                muscleTendonPartialsOut[3] =
+                        muscleTendonPartials
+                                .partialEquilibriumResidualPartialNormTendonForceDerivative;
+            }
+        }
+
+        m_jar->leave(std::move(mocoProblemRep));
+    }
     std::vector<std::string>
     createKinematicConstraintEquationNamesImpl() const override {
         auto mocoProblemRep = m_jar->take();
@@ -503,6 +559,17 @@ private:
     }
 
 private:
+    /// Declare the partial derivatives of the tendon compliance dynamics of
+    /// each DeGrooteFregly2016Muscle (with a compliant tendon) with respect to
+    /// the muscle's activation, normalized tendon force, and normalized
+    /// tendon force derivative variables, which are computed analytically by
+    /// DeGrooteFregly2016Muscle::calcPartials(). The dependence on the
+    /// generalized coordinates and speeds (through the muscle-tendon length
+    /// and velocity) is still computed with finite differences.
+    void addMuscleDynamicsPartials(const MocoProblemRep& problemRep,
+            const std::vector<std::string>& stateNames,
+            const std::vector<std::string>& controlNames);
+
     /// Apply parameters to properties in the models returned by
     /// `mocoProblemRep.getModelBase()` and
     /// `mocoProblemRep.getModelDisabledConstraints()`.
@@ -752,6 +819,20 @@ private:
     std::unordered_map<int, int> m_yIndexMap;
     std::vector<int> m_modelControlIndices;
     std::unique_ptr<FileDeletionThrower> m_fileDeletionThrower;
+    struct MuscleDynamicsPartialsInfo {
+        std::string musclePath;
+        bool isTendonDynamicsExplicit;
+        // If ignore_activation_dynamics is true, activation is a control.
+        bool activationIsControl;
+        int activationIndex;
+        int normTendonForceIndex;
+        // Only used with implicit tendon compliance dynamics.
+        int normTendonForceDerivativeIndex;
+        // Index of the muscle's first partial derivative in the output of
+        // calcAuxiliaryDynamicsPartials().
+        int firstPartial;
+    };
+    std::vector<MuscleDynamicsPartialsInfo> m_muscleDynamicsPartials;
     // Local memory to hold constraint forces.
     static thread_local SimTK::Vector_<SimTK::SpatialVec>
             m_constraintBodyForces;
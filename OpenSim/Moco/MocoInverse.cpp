@@ -122,7 +122,7 @@ MocoInverseSolution MocoInverse::solve() const {
     std::pair<MocoStudy, TimeSeriesTable> init = initializeInternal();
     const auto& study = init.first;
 
-    MocoSolution mocoSolution = study.solve().unseal();
+    MocoSolution mocoSolution = solveInWindows(study).unseal();
 
     const auto& statesTrajTable = init.second;
     mocoSolution.insertStatesTrajectory(statesTrajTable);
@@ -185,7 +185,8 @@ public:
     }
 
     MocoStudy initialize() const;
-    /// Solve the problem returned by initialize() and compute the outputs
+    /// Solve the problem returned by initialize() (in overlapping time windows
+    /// if num_windows is greater than 1; see MocoTool) and compute the outputs
     /// listed in output_paths.
     MocoInverseSolution solve() const;
 
@@ -51,6 +51,8 @@ void MocoProblemRep::initialize() {
     m_state_infos.clear();
     m_control_infos.clear();
     m_parameters.clear();
+    m_applied_parameter_values.resize(0);
+    m_parameters_changed_since_initsystem = false;
     m_costs.clear();
     m_endpoint_constraints.clear();
     m_path_constraints.clear();
@@ -739,10 +741,31 @@ void MocoProblemRep::applyParametersToModelProperties(
             "There are {} parameters in this MocoProblem, but {} values were "
             "provided.",
             m_parameters.size(), parameterValues.size());
+    // Only apply the parameters whose values differ from those applied by the
+    // previous call, and only call initSystem() if some parameter changed
+    // since the previous initSystem(). Solvers call this function for every
+    // evaluation of the problem, and the parameters usually change far less
+    // often than the states and controls.
+    if (m_applied_parameter_values.size() != parameterValues.size()) {
+        m_applied_parameter_values.resize(parameterValues.size());
+        m_applied_parameter_values.setToNaN();
+    }
     for (int i = 0; i < (int)m_parameters.size(); ++i) {
+        // NaN compares unequal, so all parameters are applied the first time.
+        if (parameterValues(i) == m_applied_parameter_values(i)) continue;
         m_parameters[i]->applyParameterToModelProperties(parameterValues(i));
-    }
-    if (initSystemAndDisableConstraints) {
+        m_applied_parameter_values(i) = parameterValues(i);
+        m_parameters_changed_since_initsystem = true;
+    }
+    if (initSystemAndDisableConstraints &&
+            m_parameters_changed_since_initsystem) {
+        m_parameters_changed_since_initsystem = false;
+        // A parameter may be any double, Vec3, or Vec6 property of any
+        // component, and some (e.g., Body mass properties, Coordinate default
+        // values) are copied into the SimTK::System only when the system is
+        // built. There is no way to push a single property into an existing
+        // System or to know which cache entries it affects, so the whole
+        // model is re-initialized.
         // TODO: Avoid these const_casts.
 
         // Model base.
@@ -300,6 +300,15 @@ public:
     /// model. You can pass `true` to have initSystem() called for you, and to
     /// also re-disable any constraints re-enabled by the initSystem() call
     /// (see getModelDisabledConstraints()).
+    ///
+    /// This object remembers the values from the previous call: only the
+    /// parameters whose values changed are applied, and initSystem() is
+    /// called only if a parameter changed since the previous initSystem().
+    /// Therefore, each thread can reuse the same MocoProblemRep for many
+    /// evaluations with the same parameter values at little cost. Do not
+    /// modify the parameterized properties in any other way. A change to any
+    /// parameter still re-initializes the entire model, not only the
+    /// components that the parameter affects.
     void applyParametersToModelProperties(const SimTK::Vector& parameterValues,
             bool initSystemAndDisableConstraints = false) const;
 
@@ -397,6 +406,9 @@ private:
     std::unordered_map<std::string, MocoVariableInfo> m_control_infos;
 
     std::vector<std::unique_ptr<MocoParameter>> m_parameters;
+    // See applyParametersToModelProperties().
+    mutable SimTK::Vector m_applied_parameter_values;
+    mutable bool m_parameters_changed_since_initsystem = false;
     std::vector<std::unique_ptr<MocoGoal>> m_costs;
     std::vector<std::unique_ptr<MocoGoal>> m_endpoint_constraints;
     std::vector<std::unique_ptr<MocoPathConstraint>> m_path_constraints;
@@ -22,15 +22,39 @@
 #include "MocoProblem.h"
 #include "MocoTropterSolver.h"
 #include "MocoUtilities.h"
+#include <cstdint>
+#include <fstream>
 #include <regex>
 
 #include <OpenSim/Common/IO.h>
 #include <OpenSim/Common/Reporter.h>
+#include <OpenSim/Common/STBFileAdapter.h>
 #include <OpenSim/Simulation/StatesTrajectory.h>
 #include <OpenSim/Simulation/VisualizerUtilities.h>
 
 using namespace OpenSim;
 
+namespace {
+/// 64-bit FNV-1a hash. Unlike std::hash, the result is the same on all
+/// platforms and standard libraries, so cache keys are stable.
+std::string hashString(const std::string& str) {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (const char c : str) {
+        hash ^= (unsigned char)c;
+        hash *= 1099511628211ull;
+    }
+    return fmt::format("{:016x}", hash);
+}
+
+template <typename SolverType>
+bool setGuessIfNone(MocoSolver& solver, const MocoTrajectory& guess) {
+    auto* derived = dynamic_cast<SolverType*>(&solver);
+    if (!derived || !derived->getGuess().empty()) return false;
+    derived->setGuess(guess);
+    return true;
+}
+} // anonymous namespace
+
 MocoStudy::MocoStudy() { constructProperties(); }
 
 MocoStudy::MocoStudy(const std::string& omocoFile) : Object(omocoFile) {
@@ -41,6 +65,7 @@ MocoStudy::MocoStudy(const std::string& omocoFile) : Object(omocoFile) {
 void MocoStudy::constructProperties() {
     constructProperty_write_solution(false);
     constructProperty_results_directory("./");
+    constructProperty_solution_cache_directory("");
     constructProperty_problem(MocoProblem());
     constructProperty_solver(MocoCasADiSolver());
 }
@@ -79,10 +104,107 @@ MocoCasADiSolver& MocoStudy::initCasADiSolver() {
 
 MocoSolver& MocoStudy::updSolver() { return updSolver<MocoSolver>(); }
 
+void MocoStudy::getSolutionCachePaths(
+        std::string& solutionPath, std::string& latestPath) const {
+    const std::string modelXML =
+            get_problem().getPhase(0).getModelProcessor().process().dump();
+    const std::string key = hashString(
+            modelXML + get_problem().dump() + get_solver().dump());
+    const std::string prefix = get_solution_cache_directory() +
+                               SimTK::Pathname::getPathSeparator();
+    solutionPath = prefix + key + ".stb";
+    latestPath = prefix + hashString(modelXML) + "_latest.txt";
+}
+
+MocoSolution MocoStudy::readCachedSolution(const std::string& path) {
+    MocoSolution solution(path);
+    const STBFileView file(path);
+    const auto& metadata = file.getTableMetaData();
+    const auto getValue = [&metadata](const std::string& key) {
+        return metadata.getValueForKey(key).getValue<std::string>();
+    };
+    double objective;
+    SimTK::convertStringTo(getValue("objective"), objective);
+    int numIterations;
+    SimTK::convertStringTo(getValue("num_iterations"), numIterations);
+    double duration;
+    SimTK::convertStringTo(getValue("solver_duration"), duration);
+    std::vector<std::pair<std::string, double>> breakdown;
+    const std::string termPrefix = "objective_";
+    for (const auto& key : metadata.getKeys()) {
+        if (!IO::StartsWith(key, termPrefix)) continue;
+        double term;
+        SimTK::convertStringTo(getValue(key), term);
+        breakdown.emplace_back(key.substr(termPrefix.size()), term);
+    }
+    // Only successful solutions are cached.
+    solution.setSuccess(true);
+    solution.setStatus(getValue("status"));
+    solution.setObjective(objective);
+    solution.setNumIterations(numIterations);
+    solution.setSolverDuration(duration);
+    solution.setObjectiveBreakdown(std::move(breakdown));
+    return solution;
+}
+
+std::unique_ptr<MocoSolver> MocoStudy::createSolverWithCachedGuess(
+        const std::string& latestPath) const {
+    if (!IO::FileExists(latestPath)) return nullptr;
+    std::string fileName;
+    {
+        std::ifstream latest(latestPath);
+        std::getline(latest, fileName);
+    }
+    const std::string path = get_solution_cache_directory() +
+                             SimTK::Pathname::getPathSeparator() + fileName;
+    if (fileName.empty() || !IO::FileExists(path)) return nullptr;
+
+    // Set the guess on a copy, so that the user's solver is left as it was
+    // configured.
+    std::unique_ptr<MocoSolver> solver(get_solver().clone());
+    solver->resetProblem(get_problem());
+    try {
+        const MocoTrajectory guess(path);
+        if (setGuessIfNone<MocoCasADiSolver>(*solver, guess) ||
+                setGuessIfNone<MocoTropterSolver>(*solver, guess)) {
+            return solver;
+        }
+    } catch (const Exception& e) {
+        log_info("Cached solution '{}' cannot be used as the guess: {}", path,
+                e.getMessage());
+    }
+    return nullptr;
+}
+
 MocoSolution MocoStudy::solve() const {
-    initSolverInternal();
+    std::string cachedSolutionPath;
+    std::string latestPath;
+    if (!get_solution_cache_directory().empty()) {
+        getSolutionCachePaths(cachedSolutionPath, latestPath);
+    }
 
-    MocoSolution solution = get_solver().solve();
+    MocoSolution solution;
+    if (!cachedSolutionPath.empty() && IO::FileExists(cachedSolutionPath)) {
+        log_info("Using cached solution '{}'.", cachedSolutionPath);
+        solution = readCachedSolution(cachedSolutionPath);
+    } else {
+        std::unique_ptr<MocoSolver> solverWithCachedGuess;
+        if (!latestPath.empty()) {
+            solverWithCachedGuess = createSolverWithCachedGuess(latestPath);
+        }
+        if (solverWithCachedGuess) {
+            solution = solverWithCachedGuess->solve();
+        } else {
+            initSolverInternal();
+            solution = get_solver().solve();
+        }
+        if (!cachedSolutionPath.empty() && solution.success()) {
+            OpenSim::IO::makeDir(get_solution_cache_directory());
+            solution.write(cachedSolutionPath);
+            std::ofstream latest(latestPath);
+            latest << IO::GetFileNameFromURI(cachedSolutionPath) << std::endl;
+        }
+    }
 
     bool originallySealed = solution.isSealed();
     if (get_write_solution()) {
@@ -68,6 +68,27 @@ MocoSolution solution = study.solve();
 solution.write("solution.sto");
 @endcode
 
+Solution cache
+--------------
+If you solve the same study, or close variants of it, many times (e.g., in a
+batch pipeline), set the solution_cache_directory property. solve() then
+computes a key from the XML of the processed model, the problem, and the
+solver, and looks for a solution with that key in the directory:
+
+- If there is one, solve() returns it without solving the problem.
+- Otherwise, if the solver (MocoCasADiSolver or MocoTropterSolver) has no
+  guess, the most recent cached solution for the same model is used as the
+  guess, if it is compatible with the problem. Studies that differ only in
+  goal weights, bounds, or data usually converge much faster from this guess.
+
+Successful solutions are added to the cache as binary STB files. A cached
+solution is identical to the original, except that its objective terms are
+ordered by name. The key does not include anything that is not serialized
+with the study: for example, a table passed to a goal in code (rather than
+by file name), the contents of data files (only their names), or a guess set
+with setGuess(). Clear the cache directory (or do not use a cache) if such
+inputs change.
+
 Saving the study setup to a file
 --------------------------------
 You can save the MocoStudy to a file by calling MocoStudy::print(), and you
@@ -93,6 +114,11 @@ public:
     OpenSim_DECLARE_PROPERTY(results_directory, std::string,
             "Provide the folder path (relative to working directory) to which "
             "the solution file should be written. Default: './'.");
+    OpenSim_DECLARE_PROPERTY(solution_cache_directory, std::string,
+            "Directory in which to cache solutions so that solving the same "
+            "study again returns the cached solution, and similar studies "
+            "use a cached solution as the initial guess. Empty (default) to "
+            "not use a cache.");
 
     MocoStudy();
 
@@ -196,6 +222,16 @@ protected:
 private:
     void initSolverInternal() const;
     void constructProperties();
+    /// Paths of the cached solution for the current problem and solver, and
+    /// of the file that names the most recent cached solution for the model.
+    void getSolutionCachePaths(
+            std::string& solutionPath, std::string& latestPath) const;
+    static MocoSolution readCachedSolution(const std::string& path);
+    /// If the solver has no guess, a copy of the solver (with the problem
+    /// reset) whose guess is the most recent cached solution for the model;
+    /// otherwise, nullptr.
+    std::unique_ptr<MocoSolver> createSolverWithCachedGuess(
+            const std::string& latestPath) const;
 };
 
 template <>
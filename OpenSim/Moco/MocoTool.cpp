@@ -17,16 +17,38 @@
  * -------------------------------------------------------------------------- */
 #include "MocoTool.h"
 
+#include "MocoCasADiSolver/MocoCasADiSolver.h"
+#include "MocoStudy.h"
 #include "MocoUtilities.h"
 
+#include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/Stopwatch.h>
+
+#include <thread>
+
 using namespace OpenSim;
 
+namespace {
+/// Linearly interpolate the row of the matrix (with rows at the given times)
+/// at the given time, which must be within the range of the times.
+SimTK::RowVector interpolateRow(const SimTK::Vector& times,
+        const SimTK::Matrix& matrix, double time) {
+    int i = 0;
+    while (i < times.size() - 2 && times[i + 1] < time) ++i;
+    const double fraction = (time - times[i]) / (times[i + 1] - times[i]);
+    return matrix.row(i) + fraction * (matrix.row(i + 1) - matrix.row(i));
+}
+} // anonymous namespace
+
 void MocoTool::constructProperties() {
     constructProperty_initial_time();
     constructProperty_final_time();
     constructProperty_mesh_interval(0.02);
     constructProperty_clip_time_range(false);
     constructProperty_model(ModelProcessor());
+    constructProperty_num_windows(1);
+    constructProperty_window_overlap(0.1);
+    constructProperty_window_stitching_solve(true);
 }
 
 void MocoTool::updateTimeInfo(const std::string& dataLabel,
@@ -91,3 +113,172 @@ std::string MocoTool::getDocumentDirectory() const {
     }
     return setupDir;
 }
+
+MocoSolution MocoTool::solveInWindows(const MocoStudy& study) const {
+    const int numWindows = get_num_windows();
+    OPENSIM_THROW_IF_FRMOBJ(numWindows < 1, Exception,
+            "Expected num_windows to be at least 1, but got {}.", numWindows);
+    if (numWindows == 1) return study.solve();
+    OPENSIM_THROW_IF_FRMOBJ(get_window_overlap() < 0, Exception,
+            "Expected window_overlap to be non-negative, but got {}.",
+            get_window_overlap());
+
+    MocoStudy baseStudy(study);
+    auto& baseSolver = baseStudy.updSolver<MocoCasADiSolver>();
+    baseSolver.resetProblem(baseStudy.getProblem());
+    const MocoTrajectory guess = baseSolver.getGuess();
+    const auto& phase = baseStudy.getProblem().getPhase(0);
+    const double initialTime = phase.getTimeInitialBounds().getLower();
+    const double finalTime = phase.getTimeFinalBounds().getUpper();
+    const double meshInterval =
+            (finalTime - initialTime) / baseSolver.get_num_mesh_intervals();
+
+    // Each window keeps its solution between two consecutive cuts.
+    std::vector<double> cuts(numWindows + 1);
+    for (int iwin = 0; iwin < numWindows; ++iwin) {
+        cuts[iwin] = initialTime +
+                     iwin * (finalTime - initialTime) / numWindows;
+    }
+    cuts.back() = finalTime;
+    const double halfOverlap = 0.5 * get_window_overlap();
+
+    // Divide the cores between the windows that are solved concurrently.
+    const int numCores = std::max((int)std::thread::hardware_concurrency(), 1);
+    const int parallelEV = getMocoParallelEnvironmentVariable();
+    int numThreads = parallelEV == 0 ? 1
+                                     : (parallelEV > 1 ? parallelEV : numCores);
+    numThreads = std::min(numThreads, numWindows);
+    const int jobsPerWindow = numCores / numThreads;
+
+    // Each window is solved on its own copy of the study (and therefore its
+    // own model and solver).
+    const Stopwatch stopwatch;
+    std::vector<MocoSolution> solutions(numWindows);
+    parallelForChunks(numWindows, numThreads, [&](int, int begin, int end) {
+        for (int iwin = begin; iwin < end; ++iwin) {
+            const double windowInitial =
+                    std::max(initialTime, cuts[iwin] - halfOverlap);
+            const double windowFinal =
+                    std::min(finalTime, cuts[iwin + 1] + halfOverlap);
+            MocoStudy windowStudy(baseStudy);
+            windowStudy.setName(
+                    study.getName() + "_window" + std::to_string(iwin));
+            // The windows share the model, so concurrent windows would read
+            // and write the same entries of the solution cache.
+            windowStudy.set_solution_cache_directory("");
+            windowStudy.updProblem().setTimeBounds(windowInitial, windowFinal);
+            auto& solver = windowStudy.updSolver<MocoCasADiSolver>();
+            const int numMeshIntervals = std::max(1,
+                    (int)std::ceil((windowFinal - windowInitial) /
+                                           meshInterval - 1e-9));
+            solver.set_num_mesh_intervals(numMeshIntervals);
+            if (numThreads > 1) {
+                // For this property, 1 means all cores.
+                solver.set_parallel(jobsPerWindow > 1 ? jobsPerWindow : 0);
+            }
+            solver.resetProblem(windowStudy.getProblem());
+            if (!guess.empty()) {
+                MocoTrajectory windowGuess = guess;
+                windowGuess.resample(createVectorLinspace(
+                        numMeshIntervals + 1, windowInitial, windowFinal));
+                solver.setGuess(std::move(windowGuess));
+            }
+            solutions[iwin] = windowStudy.solve().unseal();
+        }
+    });
+
+    // Join the windows at the cuts.
+    std::vector<std::vector<int>> rows(numWindows);
+    int numTimes = 0;
+    for (int iwin = 0; iwin < numWindows; ++iwin) {
+        const auto& time = solutions[iwin].getTime();
+        for (int itime = 0; itime < time.size(); ++itime) {
+            if ((iwin == 0 || time[itime] >= cuts[iwin]) &&
+                    (iwin == numWindows - 1 ||
+                            time[itime] < cuts[iwin + 1])) {
+                rows[iwin].push_back(itime);
+            }
+        }
+        numTimes += (int)rows[iwin].size();
+    }
+    const MocoSolution& first = solutions.front();
+    SimTK::Vector time(numTimes);
+    SimTK::Matrix states(numTimes, first.getNumStates());
+    SimTK::Matrix controls(numTimes, first.getNumControls());
+    SimTK::Matrix multipliers(numTimes, first.getNumMultipliers());
+    SimTK::Matrix derivatives(numTimes, first.getNumDerivatives());
+    SimTK::Matrix slacks(numTimes, first.getSlacksTrajectory().ncol());
+    double maxJump = 0;
+    int irow = 0;
+    for (int iwin = 0; iwin < numWindows; ++iwin) {
+        const auto& solution = solutions[iwin];
+        for (const int itime : rows[iwin]) {
+            time[irow] = solution.getTime()[itime];
+            states.updRow(irow) = solution.getStatesTrajectory().row(itime);
+            controls.updRow(irow) = solution.getControlsTrajectory().row(itime);
+            multipliers.updRow(irow) =
+                    solution.getMultipliersTrajectory().row(itime);
+            derivatives.updRow(irow) =
+                    solution.getDerivativesTrajectory().row(itime);
+            slacks.updRow(irow) = solution.getSlacksTrajectory().row(itime);
+            ++irow;
+        }
+        if (iwin > 0 && !rows[iwin].empty()) {
+            // Compare the states of the previous window at the first time
+            // kept from this window.
+            const int itime = rows[iwin].front();
+            const auto& previous = solutions[iwin - 1];
+            const SimTK::RowVector jump =
+                    solution.getStatesTrajectory().row(itime) -
+                    interpolateRow(previous.getTime(),
+                            previous.getStatesTrajectory(),
+                            solution.getTime()[itime]);
+            maxJump = std::max(maxJump, SimTK::max(jump.abs()));
+        }
+    }
+    MocoSolution joined(time, first.getStateNames(), first.getControlNames(),
+            first.getMultiplierNames(), first.getDerivativeNames(),
+            first.getParameterNames(), states, controls, multipliers,
+            derivatives, first.getParameters());
+    for (int islack = 0; islack < slacks.ncol(); ++islack) {
+        joined.appendSlack(first.getSlackNames()[islack], slacks.col(islack));
+    }
+    log_info("Solved {} time windows in {}. Largest jump in the states where "
+             "the windows are joined: {}.",
+            numWindows, stopwatch.getElapsedTimeFormatted(), maxJump);
+
+    if (get_window_stitching_solve()) {
+        baseSolver.setGuess(joined);
+        return baseStudy.solve();
+    }
+
+    bool success = true;
+    std::string status = first.getStatus();
+    double objective = 0;
+    int numIterations = 0;
+    std::vector<std::pair<std::string, double>> breakdown;
+    for (const auto& name : first.getObjectiveTermNames()) {
+        breakdown.emplace_back(name, 0);
+    }
+    for (int iwin = 0; iwin < numWindows; ++iwin) {
+        const auto& solution = solutions[iwin];
+        if (success && !solution.success()) {
+            success = false;
+            status = "window " + std::to_string(iwin) + ": " +
+                     solution.getStatus();
+        }
+        objective += solution.getObjective();
+        numIterations += solution.getNumIterations();
+        for (int iterm = 0; iterm < (int)breakdown.size(); ++iterm) {
+            breakdown[iterm].second +=
+                    solution.getObjectiveTermByIndex(iterm);
+        }
+    }
+    joined.setObjective(objective);
+    joined.setObjectiveBreakdown(std::move(breakdown));
+    joined.setStatus(status);
+    joined.setNumIterations(numIterations);
+    joined.setSolverDuration(stopwatch.getElapsedTime());
+    joined.setSuccess(success);
+    return joined;
+}
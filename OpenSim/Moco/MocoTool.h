@@ -24,6 +24,9 @@
 
 namespace OpenSim {
 
+class MocoSolution;
+class MocoStudy;
+
 /** This is a base class for solving problems that depend on an observed motion
 using Moco's optimal control methods.
 
@@ -46,7 +49,31 @@ muscles alone. There are multiple possible causes for this:
     deactivation time constants allow,
   - the filtering of the data causes unrealistic desired net joint moments.
 You may want to add "reserve" actuators to your model.
-This can be done with the ModOpAddReserves model operator. */
+This can be done with the ModOpAddReserves model operator.
+
+Time windows
+------------
+The cost of solving a single problem over a long trial (e.g., many gait
+cycles) grows faster than the duration of the trial. If num_windows is greater
+than 1, the time range is split into that many windows of equal duration, and
+each window is extended by half of window_overlap into its neighbors. The
+windows are independent problems, each solved on its own copy of the study
+(and therefore of the model and solver) with the same mesh interval. The
+windows are solved concurrently, on as many threads as the
+OPENSIM_MOCO_PARALLEL environment variable allows (all cores by default), and
+the cores are divided among the solvers of the concurrent windows. The
+solution from each window is kept up to the middle of its overlap with the
+next window, away from the boundaries at which the window's states and
+controls are unconstrained, and the pieces are joined into a single solution.
+The largest jump in the states where the pieces are joined is logged. By
+default (window_stitching_solve), the problem is then solved over the full
+time range, using the joined solution as the initial guess, so that the
+states are continuous; this solve starts close to the optimum. If
+window_stitching_solve is false, the joined solution is returned: its
+objective is the sum of the objectives of the windows, which includes the
+overlaps, and its number of iterations is the sum across the windows. The
+initial guess for each window is the solver's guess resampled onto the
+window's time range, if the solver has a guess. */
 class MocoTool : public Object {
     OpenSim_DECLARE_ABSTRACT_OBJECT(MocoTool, Object);
 
@@ -72,6 +99,20 @@ public:
     OpenSim_DECLARE_PROPERTY(
             model, ModelProcessor, "The musculoskeletal model to use.");
 
+    OpenSim_DECLARE_PROPERTY(num_windows, int,
+            "The number of overlapping time windows in which to solve the "
+            "problem; 1 solves a single problem over the full time range "
+            "(default: 1).");
+
+    OpenSim_DECLARE_PROPERTY(window_overlap, double,
+            "The duration for which adjacent time windows overlap "
+            "(default: 0.1 seconds).");
+
+    OpenSim_DECLARE_PROPERTY(window_stitching_solve, bool,
+            "After solving the time windows, solve the problem over the full "
+            "time range using the joined windows as the initial guess, so "
+            "that the states are continuous (default: true).");
+
     MocoTool() { constructProperties(); }
 
     void setModel(ModelProcessor model) { set_model(std::move(model)); }
@@ -104,6 +145,10 @@ protected:
     /// returns an empty string.
     std::string getDocumentDirectory() const;
 
+    /// Solve the study, in overlapping time windows if num_windows is greater
+    /// than 1. The study's solver must be a MocoCasADiSolver.
+    MocoSolution solveInWindows(const MocoStudy& study) const;
+
 #endif
 private:
     void constructProperties();
@@ -136,7 +136,7 @@ MocoSolution MocoTrack::solveInternal(bool visualize) {
 
     // Solve!
     // ------
-    MocoSolution solution = study.solve();
+    MocoSolution solution = solveInWindows(study);
     if (visualize) { study.visualize(solution); }
 
     return solution;
@@ -265,7 +265,9 @@ public:
     }
 
     MocoStudy initialize();
-    /// Solve the MocoTrack problem and obtain the solution.
+    /// Solve the MocoTrack problem and obtain the solution. If num_windows is
+    /// greater than 1, the problem is solved in overlapping time windows (see
+    /// MocoTool).
     MocoSolution solve() { return solveInternal(false); }
     /// Solve the MocoTrack problem, visualize the solution, then obtain the
     /// solution.
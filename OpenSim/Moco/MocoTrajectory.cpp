@@ -20,6 +20,8 @@
 #include "MocoProblem.h"
 #include "MocoUtilities.h"
 
+#include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/STBFileAdapter.h>
 #include <OpenSim/Common/STOFileAdapter.h>
 #include <OpenSim/Common/GCVSplineSet.h>
 #include <OpenSim/Simulation/Model/Model.h>
@@ -779,7 +781,11 @@ MocoTrajectory::MocoTrajectory(const std::string& filepath) {
 
 void MocoTrajectory::write(const std::string& filepath) const {
     ensureUnsealed();
-    STOFileAdapter::write(convertToTable(), filepath);
+    if (IO::EndsWithIgnoringCase(filepath, ".stb")) {
+        STBFileAdapter::write(convertToTable(), filepath);
+    } else {
+        STOFileAdapter::write(convertToTable(), filepath);
+    }
 }
 
 TimeSeriesTable MocoTrajectory::convertToTable() const {
@@ -1385,15 +1391,16 @@ void MocoSolution::convertToTableImpl(TimeSeriesTable& table) const {
     std::string success = m_success ? "true" : "false";
     table.updTableMetaData().setValueForKey("success", success);
     table.updTableMetaData().setValueForKey("status", m_status);
+    // Write the objective with enough digits to read it back exactly.
     table.updTableMetaData().setValueForKey(
-            "objective", std::to_string(m_objective));
+            "objective", fmt::format("{:.17g}", m_objective));
     table.updTableMetaData().setValueForKey(
             "num_iterations", std::to_string(m_numIterations));
     table.updTableMetaData().setValueForKey(
             "solver_duration", std::to_string(m_solverDuration));
     for (const auto& entry : m_objectiveBreakdown) {
-        table.updTableMetaData().setValueForKey(
-                "objective_" + entry.first, std::to_string(entry.second));
+        table.updTableMetaData().setValueForKey("objective_" + entry.first,
+                fmt::format("{:.17g}", entry.second));
 
     }
 }
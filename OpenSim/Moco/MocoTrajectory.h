@@ -598,7 +598,9 @@ public:
     /// @name Convert to other formats
     /// @{
 
-    /// Save the trajectory to a STO file. Use the ."sto" file extension.
+    /// Save the trajectory to a STO file. Use the ."sto" file extension. If
+    /// the extension is ".stb", the trajectory is saved to a binary STB file
+    /// (see STBFileAdapter) instead, which preserves values exactly.
     void write(const std::string& filepath) const;
 
     /// This table can be saved as a Storage file that can be used in the
@@ -865,6 +867,10 @@ private:
     double m_solverDuration = -1;
     // Allow solvers to set success, status, and construct a solution.
     friend class MocoSolver;
+    // Allow MocoStudy to construct a solution from its solution cache.
+    friend class MocoStudy;
+    // Allow MocoTool to join the solutions of time windows.
+    friend class MocoTool;
 };
 
 } // namespace OpenSim
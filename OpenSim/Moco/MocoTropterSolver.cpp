@@ -341,15 +341,11 @@ MocoSolution MocoTropterSolver::solveImpl() const {
 
     // Temporarily disable printing of negative muscle force warnings so the
     // output stream isn't flooded while computing finite differences.
-    Logger::Level origLoggerLevel = Logger::getLevel();
-    Logger::setLevel(Logger::Level::Warn);
     tropter::Solution tropSolution;
-    try {
+    {
+        LogLevelWarnGuard logLevelGuard;
         tropSolution = dircol->solve(tropIterate);
-    } catch (...) {
-        OpenSim::Logger::setLevel(origLoggerLevel);
     }
-    OpenSim::Logger::setLevel(origLoggerLevel);
 
     if (get_verbosity()) { dircol->print_constraint_values(tropSolution); }
 
@@ -20,6 +20,7 @@
 
 #include "MocoProblem.h"
 #include "MocoTrajectory.h"
+#include <mutex>
 #include <regex>
 
 #include <OpenSim/Actuators/CoordinateActuator.h>
@@ -258,6 +259,27 @@ MocoTrajectory OpenSim::createPeriodicTrajectory(
 }
 
 
+namespace {
+std::mutex logLevelWarnGuardMutex;
+int numLogLevelWarnGuards = 0;
+Logger::Level logLevelBeforeWarnGuards = Logger::Level::Info;
+} // anonymous namespace
+
+LogLevelWarnGuard::LogLevelWarnGuard() {
+    std::lock_guard<std::mutex> lock(logLevelWarnGuardMutex);
+    if (numLogLevelWarnGuards++ == 0) {
+        logLevelBeforeWarnGuards = Logger::getLevel();
+        Logger::setLevel(Logger::Level::Warn);
+    }
+}
+
+LogLevelWarnGuard::~LogLevelWarnGuard() {
+    std::lock_guard<std::mutex> lock(logLevelWarnGuardMutex);
+    if (--numLogLevelWarnGuards == 0) {
+        Logger::setLevel(logLevelBeforeWarnGuards);
+    }
+}
+
 int OpenSim::getMocoParallelEnvironmentVariable() {
     const std::string varName = "OPENSIM_MOCO_PARALLEL";
     if (SimTK::Pathname::environmentVariableExists(varName)) {
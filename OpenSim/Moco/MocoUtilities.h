@@ -168,6 +168,20 @@ OSIMMOCO_API MocoTrajectory createPeriodicTrajectory(
 /// @ingroup mocoutil
 OSIMMOCO_API int getMocoParallelEnvironmentVariable();
 
+/// While an object of this class exists, the Logger's level is Warn, so that,
+/// for example, the log isn't flooded with warnings while a solver computes
+/// finite differences. The original level is restored when the last such
+/// object is destroyed (also if an exception is thrown), so objects may be
+/// nested or created from multiple threads at once.
+/// @ingroup mocoutil
+class OSIMMOCO_API LogLevelWarnGuard {
+public:
+    LogLevelWarnGuard();
+    ~LogLevelWarnGuard();
+    LogLevelWarnGuard(const LogLevelWarnGuard&) = delete;
+    LogLevelWarnGuard& operator=(const LogLevelWarnGuard&) = delete;
+};
+
 /// Thrown by FileDeletionThrower::throwIfDeleted().
 /// @ingroup mocoutil
 class FileDeletionThrowerException : public Exception {
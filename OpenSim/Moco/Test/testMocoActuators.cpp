@@ -312,6 +312,103 @@ TEMPLATE_TEST_CASE(
     }
 }
 
+TEST_CASE("Hanging muscle with analytic tendon dynamics partials",
+        "[casadi]") {
+    // With finite difference coloring, the partial derivatives of the tendon
+    // compliance dynamics with respect to the muscle's own variables are
+    // computed analytically; perturbing one input at a time uses only finite
+    // differences. Both must lead to the same solution.
+    auto ignoreActivationDynamics = GENERATE(true, false);
+    auto isTendonDynamicsExplicit = GENERATE(true, false);
+    CAPTURE(ignoreActivationDynamics);
+    CAPTURE(isTendonDynamicsExplicit);
+
+    Model model = createHangingMuscleModel(0.1, 0.05,
+            ignoreActivationDynamics, false, isTendonDynamicsExplicit);
+
+    MocoStudy study;
+    MocoProblem& problem = study.updProblem();
+    problem.setModelAsCopy(model);
+    problem.setTimeBounds(0, 0.5);
+    problem.setStateInfo("/joint/height/value", {0.14, 0.17}, 0.165, 0.155);
+    problem.setStateInfo("/joint/height/speed", {-10, 10}, 0, 0);
+    problem.setControlInfo("/forceset/muscle", {0.02, 1});
+    problem.addGoal<MocoInitialForceEquilibriumDGFGoal>();
+    problem.addGoal<MocoControlGoal>("effort");
+
+    auto& solver = study.initSolver<MocoCasADiSolver>();
+    solver.set_num_mesh_intervals(20);
+    solver.set_multibody_dynamics_mode("explicit");
+    solver.set_optim_convergence_tolerance(1e-6);
+    solver.set_optim_constraint_tolerance(1e-6);
+    solver.set_minimize_implicit_auxiliary_derivatives(true);
+    solver.set_optim_sparsity_detection("random");
+
+    solver.set_optim_finite_difference_coloring(true);
+    MocoSolution solutionAnalytic = study.solve();
+    solver.set_optim_finite_difference_coloring(false);
+    MocoSolution solutionFiniteDifference = study.solve();
+
+    CHECK(solutionAnalytic.success());
+    CHECK(solutionFiniteDifference.success());
+    CHECK(solutionAnalytic.getObjective() ==
+            Approx(solutionFiniteDifference.getObjective()).epsilon(1e-4));
+    CHECK(solutionAnalytic.compareContinuousVariablesRMS(
+                  solutionFiniteDifference) < 1e-3);
+}
+
+/// Exposes the Jacobian of the multibody system function.
+class MocoCasADiSolverJacobian : public MocoCasADiSolver {
+public:
+    using MocoCasADiSolver::calcMultibodySystemJacobian;
+};
+
+TEST_CASE("Hanging muscle Jacobian with analytic tendon dynamics partials",
+        "[casadi]") {
+    // The Jacobian with coloring and analytic partials must match, entry by
+    // entry, the Jacobian computed by perturbing one input at a time.
+    auto ignoreActivationDynamics = GENERATE(true, false);
+    auto isTendonDynamicsExplicit = GENERATE(true, false);
+    CAPTURE(ignoreActivationDynamics);
+    CAPTURE(isTendonDynamicsExplicit);
+
+    Model model = createHangingMuscleModel(0.1, 0.05,
+            ignoreActivationDynamics, false, isTendonDynamicsExplicit);
+
+    MocoProblem problem;
+    problem.setModelAsCopy(model);
+    problem.setTimeBounds(0, 0.5);
+    problem.setStateInfo("/joint/height/value", {0.14, 0.17}, 0.165, 0.155);
+    problem.setStateInfo("/joint/height/speed", {-10, 10}, 0, 0);
+    problem.setControlInfo("/forceset/muscle", {0.02, 1});
+
+    MocoCasADiSolverJacobian solver;
+    solver.resetProblem(problem);
+    solver.set_multibody_dynamics_mode("explicit");
+    solver.set_minimize_implicit_auxiliary_derivatives(true);
+    solver.set_parallel(0);
+    const MocoTrajectory point = solver.createGuess("bounds");
+
+    solver.set_optim_finite_difference_coloring(true);
+    const SimTK::Matrix jacobianColored =
+            solver.calcMultibodySystemJacobian(point);
+    solver.set_optim_finite_difference_coloring(false);
+    const SimTK::Matrix jacobianUncolored =
+            solver.calcMultibodySystemJacobian(point);
+
+    REQUIRE(jacobianColored.nrow() == jacobianUncolored.nrow());
+    REQUIRE(jacobianColored.ncol() == jacobianUncolored.ncol());
+    for (int irow = 0; irow < jacobianColored.nrow(); ++irow) {
+        for (int icol = 0; icol < jacobianColored.ncol(); ++icol) {
+            INFO("row " << irow << ", column " << icol);
+            CHECK(jacobianColored(irow, icol) ==
+                    Approx(jacobianUncolored(irow, icol))
+                            .epsilon(1e-3)
+                            .margin(1e-5));
+        }
+    }
+}
+
 TEST_CASE("ActivationCoordinateActuator") {
     // Create a problem with ACA and ensure the activation bounds are
     // set as expected.
@@ -18,6 +18,7 @@
 
 #define CATCH_CONFIG_MAIN
 #include "Testing.h"
+#include <cstdlib>
 #include <fstream>
 
 #include <OpenSim/Actuators/BodyActuator.h>
@@ -2023,6 +2024,100 @@ TEST_CASE("Objective breakdown", "[casadi]") {
     CHECK(solution.getObjectiveTerm("goal_b") == Approx(0.01 * 7.3));
 }
 
+TEST_CASE("Finite difference coloring", "[casadi]") {
+    // Coloring changes only how the Jacobians are computed, so the solution
+    // must be the same as when perturbing one input at a time.
+    auto scheme = GENERATE(as<std::string>{}, "central", "forward");
+    MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>();
+    auto& solver = study.initSolver<MocoCasADiSolver>();
+    solver.set_optim_sparsity_detection("random");
+    solver.set_optim_finite_difference_scheme(scheme);
+    solver.set_optim_finite_difference_coloring(false);
+    MocoSolution solutionUncolored = study.solve();
+    solver.set_optim_finite_difference_coloring(true);
+    MocoSolution solutionColored = study.solve();
+    CHECK(solutionColored.getFinalTime() ==
+            Approx(solutionUncolored.getFinalTime()).epsilon(1e-4));
+    CHECK(solutionColored.compareContinuousVariablesRMS(solutionUncolored) <
+            1e-3);
+}
+
+TEST_CASE("Exact Hessian with finite difference coloring", "[casadi]") {
+    // The second derivatives from differencing the colored Jacobian must
+    // lead to the same solution as the quasi-Newton approximation.
+    auto scheme = GENERATE(as<std::string>{}, "central", "forward");
+    MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>();
+    auto& solver = study.initSolver<MocoCasADiSolver>();
+    solver.set_optim_sparsity_detection("random");
+    solver.set_optim_finite_difference_scheme(scheme);
+    solver.set_optim_hessian_approximation("limited-memory");
+    MocoSolution solutionLimitedMemory = study.solve();
+    solver.set_optim_hessian_approximation("exact");
+    MocoSolution solutionExact = study.solve();
+    CHECK(solutionExact.success());
+    CHECK(solutionExact.getFinalTime() ==
+            Approx(solutionLimitedMemory.getFinalTime()).epsilon(1e-3));
+    CHECK(solutionExact.compareContinuousVariablesRMS(
+                  solutionLimitedMemory) < 1e-2);
+}
+
+TEST_CASE("Mesh refinement", "[casadi]") {
+    // The control switches from its upper to its lower bound halfway
+    // through the motion, so the error is largest near the switch.
+    MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>();
+    auto& solver = study.initSolver<MocoCasADiSolver>();
+    solver.set_num_mesh_intervals(5);
+    MocoSolution coarse = study.solve();
+
+    solver.set_mesh_refinement_max_iterations(3);
+    solver.set_mesh_refinement_tolerance(1e-4);
+    MocoSolution refined = study.solve();
+    CHECK(refined.success());
+    CHECK(refined.getNumTimes() > coarse.getNumTimes());
+    // At most, every interval is bisected in each refinement.
+    CHECK(refined.getNumTimes() <= 5 * 8 + 1);
+    CHECK(refined.getFinalTime() == Approx(2.0).epsilon(1e-2));
+
+    SECTION("Refinement stops when the tolerance is met") {
+        solver.set_mesh_refinement_tolerance(1e10);
+        MocoSolution unrefined = study.solve();
+        CHECK(unrefined.getNumTimes() == coarse.getNumTimes());
+    }
+}
+
+TEST_CASE("Solution cache", "[casadi]") {
+    // Start without the solutions cached by previous runs of this test.
+    const std::string cacheDirectory = "testMocoInterface_solution_cache";
+#ifdef _WIN32
+    std::system(("rmdir /s /q " + cacheDirectory + " 2> nul").c_str());
+#else
+    std::system(("rm -rf " + cacheDirectory).c_str());
+#endif
+
+    MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>();
+    study.set_solution_cache_directory(cacheDirectory);
+    MocoSolution solution = study.solve();
+    REQUIRE(solution.success());
+
+    // The second solve returns the cached solution.
+    MocoSolution cached = study.solve();
+    CHECK(cached.success());
+    CHECK(cached.isNumericallyEqual(solution));
+    CHECK(cached.getObjective() == solution.getObjective());
+    CHECK(cached.getNumIterations() == solution.getNumIterations());
+    CHECK(cached.getSolverDuration() == Approx(solution.getSolverDuration()));
+
+    // A variant of the problem is solved, using the cached solution as the
+    // guess, and the solver's guess is left unchanged.
+    study.updProblem().setTimeBounds(
+            MocoInitialBounds(0), MocoFinalBounds(0, 5));
+    auto& solver = study.initSolver<MocoCasADiSolver>();
+    MocoSolution variant = study.solve();
+    CHECK(variant.success());
+    CHECK(variant.getFinalTime() == Approx(2.0).epsilon(1e-2));
+    CHECK(solver.getGuess().empty());
+}
+
 TEST_CASE("Solver isAvailable()") {
 #ifdef OPENSIM_WITH_CASADI
     CHECK(MocoCasADiSolver::isAvailable());
@@ -150,3 +150,53 @@ TEST_CASE("MocoInverse Rajagopal2016, 18 muscles", "[casadi]") {
             {{"controls", {}}}) < 1e-2);
     CHECK(std.compareContinuousVariablesRMS(solution, {{"states", {}}}) < 1e-2);
 }
+
+TEST_CASE("MocoInverse in time windows", "[casadi]") {
+
+    MocoInverse inverse;
+    ModelProcessor modelProcessor =
+        ModelProcessor("subject_walk_armless_18musc.osim") |
+        ModOpReplaceJointsWithWelds({"subtalar_r", "subtalar_l",
+            "mtp_r", "mtp_l"}) |
+        ModOpReplaceMusclesWithDeGrooteFregly2016() |
+        ModOpIgnorePassiveFiberForcesDGF() |
+        ModOpTendonComplianceDynamicsModeDGF("implicit") |
+        ModOpAddExternalLoads("subject_walk_armless_external_loads.xml");
+
+    inverse.setModel(modelProcessor);
+    inverse.setKinematics(
+        TableProcessor("subject_walk_armless_coordinates.mot") |
+        TabOpLowPassFilter(6));
+    inverse.set_initial_time(0.450);
+    inverse.set_final_time(1.0);
+    inverse.set_kinematics_allow_extra_columns(true);
+    inverse.set_mesh_interval(0.025);
+    inverse.set_constraint_tolerance(1e-4);
+    inverse.set_convergence_tolerance(1e-4);
+    inverse.set_num_windows(2);
+    inverse.set_window_overlap(0.1);
+
+    MocoTrajectory std("std_testMocoInverse_subject_18musc_solution.sto");
+    SECTION("Joined windows") {
+        inverse.set_window_stitching_solve(false);
+        MocoSolution solution = inverse.solve().getMocoSolution();
+        CHECK(solution.success());
+        CHECK(solution.getInitialTime() == Approx(0.450));
+        CHECK(solution.getFinalTime() == Approx(1.0));
+        // The windows are joined away from their boundaries, so the solution
+        // is close to that of a single problem.
+        CHECK(std.compareContinuousVariablesRMS(solution,
+                {{"controls", {}}}) < 5e-2);
+        CHECK(std.compareContinuousVariablesRMS(solution,
+                {{"states", {}}}) < 5e-2);
+    }
+    SECTION("Stitching solve") {
+        // The stitching solve is the default.
+        MocoSolution solution = inverse.solve().getMocoSolution();
+        CHECK(solution.success());
+        CHECK(std.compareContinuousVariablesRMS(solution,
+                {{"controls", {}}}) < 1e-2);
+        CHECK(std.compareContinuousVariablesRMS(solution,
+                {{"states", {}}}) < 1e-2);
+    }
+}
@@ -257,3 +257,47 @@ TEMPLATE_TEST_CASE("See-saw center of mass", "",
 
     CHECK(sol_xCOM == Approx(xCOM).epsilon(0.003));
 }
+
+TEST_CASE("MocoProblemRep applies only changed parameters") {
+    MocoProblem mp;
+    mp.setModel(createOscillatorTwoSpringsModel());
+    mp.addParameter("stiffness1", "spring1", "stiffness", MocoBounds(0, 100));
+    mp.addParameter("stiffness2", "spring2", "stiffness", MocoBounds(0, 100));
+    auto rep = mp.createRepHeap();
+    const auto& model = rep->getModelDisabledConstraints();
+    const auto& spring1 =
+            model.getComponent<SpringGeneralizedForce>("spring1");
+    const auto& spring2 =
+            model.getComponent<SpringGeneralizedForce>("spring2");
+
+    // initSystem() replaces the state, so a state variable that we set
+    // reveals whether initSystem() was called.
+    SimTK::Vector values(2);
+    values[0] = 10;
+    values[1] = 20;
+    rep->applyParametersToModelProperties(values, true);
+    CHECK(spring1.getStiffness() == 10);
+    CHECK(spring2.getStiffness() == 20);
+    rep->updStateDisabledConstraints().setTime(0.3);
+
+    // Same values: initSystem() is not called.
+    rep->applyParametersToModelProperties(values, true);
+    CHECK(rep->updStateDisabledConstraints().getTime() == 0.3);
+
+    // A changed value is applied, and initSystem() is called.
+    values[1] = 30;
+    rep->applyParametersToModelProperties(values, true);
+    CHECK(spring1.getStiffness() == 10);
+    CHECK(spring2.getStiffness() == 30);
+    CHECK(rep->updStateDisabledConstraints().getTime() == 0);
+
+    // Changes applied without initSystem() still cause the next request
+    // for initSystem() to call it.
+    rep->updStateDisabledConstraints().setTime(0.3);
+    values[0] = 40;
+    rep->applyParametersToModelProperties(values, false);
+    CHECK(spring1.getStiffness() == 40);
+    CHECK(rep->updStateDisabledConstraints().getTime() == 0.3);
+    rep->applyParametersToModelProperties(values, true);
+    CHECK(rep->updStateDisabledConstraints().getTime() == 0);
+}
@@ -45,6 +45,8 @@ void BufferedOrientationsReference::getValuesAtTime(
 
     if (time >= times.front() && time <= times.back()) {
         nextRow = _orientationData.getRow(time);
+    } else if (_bounded) {
+        _boundedOrientationDataQueue.pop_front(time, nextRow);
     } else {
         _orientationDataQueue.pop_front(time, nextRow);
     }
@@ -60,7 +62,11 @@ void BufferedOrientationsReference::getNextValuesAndTime(
         double& time, SimTK::Array_<SimTK::Rotation_<double>>& values) {
 
     SimTK::RowVector_<SimTK::Rotation> nextRow;
-    _orientationDataQueue.pop_front(time, nextRow);
+    if (_bounded) {
+        _boundedOrientationDataQueue.pop_front(time, nextRow);
+    } else {
+        _orientationDataQueue.pop_front(time, nextRow);
+    }
     int n = nextRow.size();
     values.resize(n);
 
@@ -69,6 +75,18 @@ void BufferedOrientationsReference::getNextValuesAndTime(
 
 void BufferedOrientationsReference::putValues(
         double time, const SimTK::RowVector_<SimTK::Rotation>& dataRow) {
-    _orientationDataQueue.push_back(time, dataRow);
+    if (_bounded) {
+        _boundedOrientationDataQueue.push_back(time, dataRow);
+    } else {
+        _orientationDataQueue.push_back(time, dataRow);
+    }
+}
+
+void BufferedOrientationsReference::setBufferOptions(
+        int capacity, OverflowPolicy policy) {
+    _boundedOrientationDataQueue =
+            BoundedDataQueue_<SimTK::Rotation>(capacity, 0, policy);
+    _orientationDataQueue = DataQueue_<SimTK::Rotation>();
+    _bounded = true;
 }
 } // end of namespace OpenSim
\ No newline at end of file
@@ -24,6 +24,7 @@
  * -------------------------------------------------------------------------- */
 
 #include "OrientationsReference.h"
+#include <OpenSim/Common/BoundedDataQueue.h>
 #include <OpenSim/Common/DataQueue.h>
 
 namespace OpenSim {
@@ -37,6 +38,12 @@ namespace OpenSim {
  * draw data from for solving.
  * Ideally this would be templatized, allowing for all Reference classes to leverage it.
  *
+ * By default, the queue (DataQueue_) is unbounded. Use setBufferOptions() to
+ * queue the rows in a lock-free ring buffer (BoundedDataQueue_) of a fixed
+ * capacity instead; when it is full, putValues() either waits for the solver
+ * to consume a row or discards the oldest row, so that a live stream is never
+ * blocked and the solver always tracks the most recent data.
+ *
  * @author Ayman Habib
  */
 
@@ -89,9 +96,31 @@ public:
     void setFinished(bool finished) { 
         _finished = finished;
     };
+
+#ifndef SWIG
+    typedef BoundedDataQueue_<SimTK::Rotation>::OverflowPolicy OverflowPolicy;
+    typedef BoundedDataQueue_<SimTK::Rotation>::Statistics BufferStatistics;
+
+    /** Bound the queue: set the maximum number of rows that putValues() can
+    queue and what happens when the queue is full. Rows that are already
+    queued are discarded, so call this before producing data. */
+    void setBufferOptions(int capacity, OverflowPolicy policy);
+
+    /** Counts of rows pushed, popped and dropped, and the latency from
+    putValues() to the solver. These are only counted once the queue is
+    bounded (see setBufferOptions()). */
+    BufferStatistics getBufferStatistics() const {
+        return _boundedOrientationDataQueue.getStatistics();
+    }
+#endif
 private:
-    // Use a specialized data structure for holding the orientation data
+    // Use a specialized data structure for holding the orientation data.
     mutable DataQueue_<SimTK::Rotation> _orientationDataQueue;
+    // Used instead of _orientationDataQueue if _bounded. The row size is set
+    // by the first row passed to putValues().
+    mutable BoundedDataQueue_<SimTK::Rotation> _boundedOrientationDataQueue{
+            1, 0};
+    bool _bounded{false};
     bool _finished{false};
     //=============================================================================
 };  // END of class BufferedOrientationsReference
@@ -24,8 +24,6 @@
 //=============================================================================
 // INCLUDES
 //=============================================================================
-#include <Lepton.h>
-
 #include "ExpressionBasedBushingForce.h"
 
 using namespace std;
@@ -215,13 +213,20 @@ void ExpressionBasedBushingForce::extendFinalizeFromProperties()
     }
 }
 
+const std::vector<std::string>&
+ExpressionBasedBushingForce::getDeflectionVariables() {
+    static const std::vector<std::string> variables{"theta_x", "theta_y",
+            "theta_z", "delta_x", "delta_y", "delta_z"};
+    return variables;
+}
+
 /** Set the expression for the Mx function and create it's lepton program */
 void ExpressionBasedBushingForce::setMxExpression(std::string expression) 
 {
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Mx_expression(expression);
-    MxProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    MxProg = ExpressionEvaluator(expression, getDeflectionVariables());
 }
 
 /** Set the expression for the My function and create it's lepton program */
@@ -231,7 +236,7 @@ void ExpressionBasedBushingForce::setMyExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_My_expression(expression);
-    MyProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    MyProg = ExpressionEvaluator(expression, getDeflectionVariables());
 }
 
 /** Set the expression for the Mz function and create it's lepton program */
@@ -240,7 +245,7 @@ void ExpressionBasedBushingForce::setMzExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Mz_expression(expression);
-    MzProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    MzProg = ExpressionEvaluator(expression, getDeflectionVariables());
 }
 
 /** Set the expression for the Fx function and create it's lepton program */
@@ -249,7 +254,7 @@ void ExpressionBasedBushingForce::setFxExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Fx_expression(expression);
-    FxProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    FxProg = ExpressionEvaluator(expression, getDeflectionVariables());
 }
 
 /** Set the expression for the Fy function and create it's lepton program */
@@ -258,7 +263,7 @@ void ExpressionBasedBushingForce::setFyExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Fy_expression(expression);
-    FyProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    FyProg = ExpressionEvaluator(expression, getDeflectionVariables());
 }
 
 /** Set the expression for the Fz function and create it's lepton program */
@@ -267,7 +272,7 @@ void ExpressionBasedBushingForce::setFzExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Fz_expression(expression);
-    FzProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    FzProg = ExpressionEvaluator(expression, getDeflectionVariables());
 }
 //=============================================================================
 // COMPUTATION
@@ -282,15 +287,8 @@ SimTK::Vec6 ExpressionBasedBushingForce::
 
     Vec6 fk = Vec6(0.0);
 
-    std::map<std::string, double> deflectionVars;
-    deflectionVars["theta_x"] = dq[0];
-    deflectionVars["theta_y"] = dq[1];
-    deflectionVars["theta_z"] = dq[2];
-    deflectionVars["delta_x"] = dq[3];
-    deflectionVars["delta_y"] = dq[4];
-    deflectionVars["delta_z"] = dq[5];
-
-
+    // The deflections are in the order of getDeflectionVariables().
+    const double* deflectionVars = &dq[0];
     fk[0] = MxProg.evaluate(deflectionVars);
     fk[1] = MyProg.evaluate(deflectionVars);
     fk[2] = MzProg.evaluate(deflectionVars);
@@ -25,6 +25,7 @@
 
 
 // INCLUDE
+#include "ExpressionEvaluator.h"
 #include "Force.h"
 #include <OpenSim/Simulation/Model/TwoFrameLinker.h>
 
@@ -269,11 +270,13 @@ private:
 
     void setNull();
     void constructProperties();
+    /** The variables of the expressions, in the order of the deflections. */
+    static const std::vector<std::string>& getDeflectionVariables();
 
     SimTK::Mat66 _dampingMatrix{ 0.0 };
 
-    // parser programs for efficiently evaluating the expressions
-    Lepton::ExpressionProgram MxProg, MyProg, MzProg, FxProg, FyProg, FzProg;
+    // compiled expressions for efficiently evaluating the expressions
+    ExpressionEvaluator MxProg, MyProg, MzProg, FxProg, FyProg, FzProg;
 
 //==============================================================================
 };  // END of class ExpressionBasedBushingForce
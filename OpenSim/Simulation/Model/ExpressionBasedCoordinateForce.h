@@ -23,11 +23,13 @@
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
 // INCLUDE
+#include "ExpressionEvaluator.h"
 #include "Force.h"
-#include <lepton/ExpressionProgram.h>
 
 namespace OpenSim {
 
+/** A generalized force applied to a coordinate, whose magnitude is given by an
+expression of the coordinate's value (q) and speed (qdot). */
 class OSIMSIMULATION_API ExpressionBasedCoordinateForce : public Force
 {
 OpenSim_DECLARE_CONCRETE_OBJECT(ExpressionBasedCoordinateForce, Force);
@@ -126,8 +128,8 @@ private:
     void setNull();
     void constructProperties();
 
-    // parser programs for efficiently evaluating the expressions
-    Lepton::ExpressionProgram _forceProg;
+    // compiled expression for efficiently evaluating the force
+    ExpressionEvaluator _forceExpression;
 
     // Corresponding generalized coordinate to which the force
     // is applied.
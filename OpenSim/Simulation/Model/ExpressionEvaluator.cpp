@@ -0,0 +1,392 @@
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  ExpressionEvaluator.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ExpressionEvaluator.h"
+
+#include <OpenSim/Common/Exception.h>
+#include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/Logger.h>
+#include <lepton/Operation.h>
+#include <lepton/Parser.h>
+
+#include <SimTKcommon/internal/Pathname.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <locale>
+#include <map>
+#include <sstream>
+
+#ifndef _WIN32
+    #include <dlfcn.h>
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #include <sys/types.h>
+    #include <sys/wait.h>
+    #include <unistd.h>
+#endif
+
+using namespace OpenSim;
+
+namespace {
+/// FNV-1a hash of the string, as 16 hexadecimal digits.
+std::string hashString(const std::string& str) {
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (const char c : str) {
+        hash ^= (unsigned char)c;
+        hash *= 1099511628211ULL;
+    }
+    std::ostringstream stream;
+    stream << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return stream.str();
+}
+
+/// A C literal for the value, or an empty string if it is not finite.
+std::string formatConstant(double value) {
+    if (!std::isfinite(value)) return "";
+    std::ostringstream stream;
+    stream.imbue(std::locale::classic());
+    stream << std::setprecision(17) << value;
+    return "(" + stream.str() + ")";
+}
+
+/// Append a C statement that computes the node (after those of its children)
+/// to the source, and return the name of the temporary that holds its value.
+/// Returns an empty string if the node cannot be translated.
+std::string translateNode(const Lepton::ExpressionTreeNode& node,
+        const std::vector<std::string>& variables, std::string& source,
+        int& numTemps) {
+    using Lepton::Operation;
+    std::vector<std::string> args;
+    for (const auto& child : node.getChildren()) {
+        args.push_back(translateNode(child, variables, source, numTemps));
+        if (args.back().empty()) return "";
+    }
+    const Operation& op = node.getOperation();
+    const auto call = [&args](const std::string& function) {
+        return function + "(" + args[0] + ")";
+    };
+    std::string expr;
+    std::string constant;
+    switch (op.getId()) {
+    case Operation::CONSTANT:
+        expr = formatConstant(
+                dynamic_cast<const Operation::Constant&>(op).getValue());
+        if (expr.empty()) return "";
+        break;
+    case Operation::ADD_CONSTANT:
+        constant = formatConstant(
+                dynamic_cast<const Operation::AddConstant&>(op).getValue());
+        if (constant.empty()) return "";
+        expr = args[0] + " + " + constant;
+        break;
+    case Operation::MULTIPLY_CONSTANT:
+        constant = formatConstant(
+                dynamic_cast<const Operation::MultiplyConstant&>(op)
+                        .getValue());
+        if (constant.empty()) return "";
+        expr = args[0] + " * " + constant;
+        break;
+    case Operation::POWER_CONSTANT:
+        constant = formatConstant(
+                dynamic_cast<const Operation::PowerConstant&>(op).getValue());
+        if (constant.empty()) return "";
+        expr = "pow(" + args[0] + ", " + constant + ")";
+        break;
+    case Operation::VARIABLE: {
+        const auto it = std::find(
+                variables.begin(), variables.end(), op.getName());
+        expr = "v[" + std::to_string(it - variables.begin()) + "]";
+        break;
+    }
+    case Operation::ADD: expr = args[0] + " + " + args[1]; break;
+    case Operation::SUBTRACT: expr = args[0] + " - " + args[1]; break;
+    case Operation::MULTIPLY: expr = args[0] + " * " + args[1]; break;
+    case Operation::DIVIDE: expr = args[0] + " / " + args[1]; break;
+    case Operation::POWER:
+        expr = "pow(" + args[0] + ", " + args[1] + ")";
+        break;
+    case Operation::NEGATE: expr = "-" + args[0]; break;
+    case Operation::SQRT: expr = call("sqrt"); break;
+    case Operation::EXP: expr = call("exp"); break;
+    case Operation::LOG: expr = call("log"); break;
+    case Operation::SIN: expr = call("sin"); break;
+    case Operation::COS: expr = call("cos"); break;
+    case Operation::SEC: expr = "1.0 / " + call("cos"); break;
+    case Operation::CSC: expr = "1.0 / " + call("sin"); break;
+    case Operation::TAN: expr = call("tan"); break;
+    case Operation::COT: expr = "1.0 / " + call("tan"); break;
+    case Operation::ASIN: expr = call("asin"); break;
+    case Operation::ACOS: expr = call("acos"); break;
+    case Operation::ATAN: expr = call("atan"); break;
+    case Operation::SINH: expr = call("sinh"); break;
+    case Operation::COSH: expr = call("cosh"); break;
+    case Operation::TANH: expr = call("tanh"); break;
+    case Operation::ERF: expr = call("erf"); break;
+    case Operation::ERFC: expr = call("erfc"); break;
+    case Operation::STEP: expr = args[0] + " >= 0.0 ? 1.0 : 0.0"; break;
+    case Operation::DELTA: expr = args[0] + " == 0.0 ? 1.0 : 0.0"; break;
+    case Operation::SQUARE: expr = args[0] + " * " + args[0]; break;
+    case Operation::CUBE:
+        expr = args[0] + " * " + args[0] + " * " + args[0];
+        break;
+    case Operation::RECIPROCAL: expr = "1.0 / " + args[0]; break;
+    // Same as std::min() and std::max(), as in Lepton.
+    case Operation::MIN:
+        expr = args[1] + " < " + args[0] + " ? " + args[1] + " : " + args[0];
+        break;
+    case Operation::MAX:
+        expr = args[0] + " < " + args[1] + " ? " + args[1] + " : " + args[0];
+        break;
+    case Operation::ABS: expr = call("fabs"); break;
+    default:
+        // Custom functions are only available through Lepton.
+        return "";
+    }
+    const std::string temp = "t" + std::to_string(numTemps++);
+    source += "    const double " + temp + " = " + expr + ";\n";
+    return temp;
+}
+
+#ifndef _WIN32
+/// Whether the file (not following symbolic links) exists, is of the given
+/// type, is owned by this user, and cannot be written by anyone else.
+bool isPrivate(const std::string& path, mode_t type) {
+    struct stat info;
+    return lstat(path.c_str(), &info) == 0 && (info.st_mode & S_IFMT) == type &&
+           info.st_uid == geteuid() &&
+           (info.st_mode & (S_IWGRP | S_IWOTH)) == 0;
+}
+
+/// Run the program with the given arguments (without a shell), discarding its
+/// output, and return whether it exited successfully.
+bool runProgram(const std::vector<std::string>& args) {
+    std::vector<char*> argv;
+    for (const auto& arg : args) argv.push_back(const_cast<char*>(arg.c_str()));
+    argv.push_back(nullptr);
+    const pid_t pid = fork();
+    if (pid < 0) return false;
+    if (pid == 0) {
+        const int devNull = open("/dev/null", O_WRONLY);
+        if (devNull >= 0) {
+            dup2(devNull, STDOUT_FILENO);
+            dup2(devNull, STDERR_FILENO);
+            close(devNull);
+        }
+        execvp(argv[0], argv.data());
+        _exit(127);
+    }
+    int status;
+    while (waitpid(pid, &status, 0) < 0) {
+        if (errno != EINTR) return false;
+    }
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+#endif
+} // anonymous namespace
+
+ExpressionEvaluator::ExpressionEvaluator() : ExpressionEvaluator("0", {}) {}
+
+ExpressionEvaluator::ExpressionEvaluator(
+        const std::string& expression, std::vector<std::string> variables)
+        : m_parsed(Lepton::Parser::parse(expression).optimize()),
+          m_variables(std::move(variables)) {
+    createProgram();
+    for (const auto& step : m_program) {
+        OPENSIM_THROW_IF(step.variable == (int)m_variables.size(), Exception,
+                "Expression '{}' uses unknown variable '{}'.", expression,
+                step.operation->getName());
+    }
+
+    // Constants are not worth compiling.
+    const std::string varName = "OPENSIM_EXPRESSION_JIT_CACHE";
+    if (m_parsed.getRootNode().getOperation().getId() !=
+                    Lepton::Operation::CONSTANT &&
+            SimTK::Pathname::environmentVariableExists(varName)) {
+        compileNative(m_parsed.getRootNode(),
+                SimTK::Pathname::getEnvironmentVariable(varName));
+    }
+}
+
+ExpressionEvaluator::ExpressionEvaluator(const ExpressionEvaluator& other)
+        : m_parsed(other.m_parsed), m_variables(other.m_variables),
+          m_nativeFunction(other.m_nativeFunction),
+          m_library(other.m_library) {
+    createProgram();
+}
+
+ExpressionEvaluator& ExpressionEvaluator::operator=(
+        const ExpressionEvaluator& other) {
+    if (this != &other) {
+        m_parsed = other.m_parsed;
+        m_variables = other.m_variables;
+        m_nativeFunction = other.m_nativeFunction;
+        m_library = other.m_library;
+        createProgram();
+    }
+    return *this;
+}
+
+void ExpressionEvaluator::compileNative(const Lepton::ExpressionTreeNode& root,
+        const std::string& cacheDirectory) {
+#ifndef _WIN32
+    std::string body;
+    int numTemps = 0;
+    const std::string result =
+            translateNode(root, m_variables, body, numTemps);
+    if (result.empty()) return;
+    const std::string source =
+            std::string("#include <math.h>\n") +
+            "double opensim_expression(const double* v) {\n" + body +
+            "    return " + result + ";\n}\n";
+    const std::string basePath =
+            cacheDirectory + "/opensim_expression_" + hashString(source);
+    const std::string libraryPath = basePath + ".so";
+
+    static std::atomic<bool> warned(false);
+    const auto fallBack = [&](const std::string& reason) {
+        if (!warned.exchange(true)) {
+            log_warn("ExpressionEvaluator: {}; using the Lepton interpreter "
+                     "for expressions that cannot be compiled.",
+                    reason);
+        }
+    };
+
+    // Other users must not be able to replace the libraries we load.
+    if (mkdir(cacheDirectory.c_str(), 0700) != 0 && errno != EEXIST) {
+        fallBack("could not create '" + cacheDirectory + "'");
+        return;
+    }
+    if (!isPrivate(cacheDirectory, S_IFDIR)) {
+        fallBack("'" + cacheDirectory + "' is not a directory that only "
+                 "this user can write to");
+        return;
+    }
+
+    if (!IO::FileExists(libraryPath)) {
+        // Write the source and compile to files with unique names, and rename
+        // the library so that other processes never load a partially written
+        // library.
+        std::string sourcePath = basePath + "_XXXXXX.c";
+        const int sourceFile = mkstemps(&sourcePath[0], 2);
+        if (sourceFile < 0) {
+            fallBack("could not write to '" + cacheDirectory + "'");
+            return;
+        }
+        const bool wrote = write(sourceFile, source.data(), source.size()) ==
+                           (ssize_t)source.size();
+        close(sourceFile);
+        std::string tempPath = libraryPath + ".XXXXXX";
+        const int tempFile = wrote ? mkstemp(&tempPath[0]) : -1;
+        if (tempFile < 0) {
+            std::remove(sourcePath.c_str());
+            fallBack("could not write to '" + cacheDirectory + "'");
+            return;
+        }
+        close(tempFile);
+        const char* cc = std::getenv("CC");
+        const std::string compiler = cc && *cc ? cc : "cc";
+        const bool compiled = runProgram({compiler, "-O2", "-fPIC", "-shared",
+                "-o", tempPath, sourcePath, "-lm"});
+        std::remove(sourcePath.c_str());
+        if (!compiled || chmod(tempPath.c_str(), 0700) != 0 ||
+                std::rename(tempPath.c_str(), libraryPath.c_str()) != 0) {
+            std::remove(tempPath.c_str());
+            fallBack("could not compile the expression with '" + compiler +
+                     "'");
+            return;
+        }
+    }
+    if (!isPrivate(libraryPath, S_IFREG)) {
+        fallBack("'" + libraryPath + "' is not a file that only this user "
+                 "can write to");
+        return;
+    }
+
+    void* library = dlopen(libraryPath.c_str(), RTLD_NOW | RTLD_LOCAL);
+    void* function =
+            library ? dlsym(library, "opensim_expression") : nullptr;
+    if (!function) {
+        if (library) dlclose(library);
+        fallBack("could not load '" + libraryPath + "'");
+        return;
+    }
+    m_library = std::shared_ptr<void>(library, [](void* lib) { dlclose(lib); });
+    m_nativeFunction = reinterpret_cast<NativeFunction>(function);
+#endif
+}
+
+void ExpressionEvaluator::createProgram() {
+    // The operations are only valid for this copy of the parsed expression.
+    m_program.clear();
+    m_maxStackSize = 0;
+    appendSteps(m_parsed.getRootNode(), 0);
+}
+
+void ExpressionEvaluator::appendSteps(
+        const Lepton::ExpressionTreeNode& node, int stackSize) {
+    // The children leave their values on top of the stack, in order.
+    const auto& children = node.getChildren();
+    for (int i = 0; i < (int)children.size(); ++i) {
+        appendSteps(children[i], stackSize + i);
+    }
+    const Lepton::Operation& op = node.getOperation();
+    int variable = -1;
+    if (op.getId() == Lepton::Operation::VARIABLE) {
+        variable = (int)(std::find(m_variables.begin(), m_variables.end(),
+                                 op.getName()) -
+                         m_variables.begin());
+    }
+    m_program.push_back({&op, (int)children.size(), variable});
+    m_maxStackSize = std::max(m_maxStackSize, stackSize + 1);
+}
+
+double ExpressionEvaluator::evaluateProgram(const double* values) const {
+    // Operations other than variables do not use the map of variables.
+    static const std::map<std::string, double> noVariables;
+    // Most expressions fit in the local stack.
+    double localStack[32];
+    std::vector<double> heapStack;
+    double* stack = localStack;
+    if (m_maxStackSize > 32) {
+        heapStack.resize(m_maxStackSize);
+        stack = heapStack.data();
+    }
+    int top = 0;
+    for (const auto& step : m_program) {
+        if (step.variable >= 0) {
+            stack[top++] = values[step.variable];
+        } else {
+            top -= step.numArguments;
+            stack[top] = step.operation->evaluate(stack + top, noVariables);
+            ++top;
+        }
+    }
+    return stack[0];
+}
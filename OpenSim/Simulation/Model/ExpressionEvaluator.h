@@ -0,0 +1,117 @@
+#ifndef OPENSIM_EXPRESSION_EVALUATOR_H_
+#define OPENSIM_EXPRESSION_EVALUATOR_H_
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  ExpressionEvaluator.h                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Simulation/osimSimulationDLL.h>
+#include <lepton/ParsedExpression.h>
+
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+/** A Lepton expression that is parsed, optimized, and compiled once into a
+sequence of operations, and then evaluated without building a map of variable
+values or (unless the expression is deeply nested) allocating memory.
+The variables of the expression are declared up front, in the order in which
+their values are passed to evaluate(); the expression need not use all of
+them. This is used by the expression-based forces (e.g.,
+ExpressionBasedCoordinateForce).
+
+The intermediate values of an evaluation are kept on the stack of the
+calling thread, so evaluation does not modify the %ExpressionEvaluator, and it
+may be evaluated from multiple threads at once (as long as any custom
+functions in the expression allow that).
+
+<b>Native code</b>
+
+If the environment variable OPENSIM_EXPRESSION_JIT_CACHE is set to a
+directory, expressions are instead translated to C, compiled into a shared
+library with the system's C compiler (the CC environment variable, or `cc`),
+and loaded, which is much faster for complex expressions. The library is
+named by a hash of the generated source and kept in that directory, so each
+distinct expression is compiled only once across processes. The directory is
+created so that only the current user can access it, and libraries are only
+loaded from a directory (and file) that no other user can write to. If the
+expression uses a custom function, if compiling or loading fails (e.g., no
+compiler is installed), or on Windows, the compiled Lepton expression is used.
+Use isNative() to check which is used. */
+class OSIMSIMULATION_API ExpressionEvaluator {
+public:
+    /** The expression "0". */
+    ExpressionEvaluator();
+    /** Compile the expression. This throws an Exception if the expression
+    uses a variable that is not in `variables`. */
+    ExpressionEvaluator(
+            const std::string& expression, std::vector<std::string> variables);
+    ExpressionEvaluator(const ExpressionEvaluator& other);
+    ExpressionEvaluator& operator=(const ExpressionEvaluator& other);
+
+    /** Evaluate the expression, in which the ith declared variable has the
+    value `values[i]`. */
+    double evaluate(const double* values) const {
+        if (m_nativeFunction) return m_nativeFunction(values);
+        return evaluateProgram(values);
+    }
+    double evaluate(std::initializer_list<double> values) const {
+        return evaluate(values.begin());
+    }
+
+    /** Whether the expression is evaluated by native code (see above). */
+    bool isNative() const { return m_nativeFunction != nullptr; }
+
+private:
+    void createProgram();
+    void appendSteps(const Lepton::ExpressionTreeNode& node, int stackSize);
+    double evaluateProgram(const double* values) const;
+    void compileNative(const Lepton::ExpressionTreeNode& root,
+            const std::string& cacheDirectory);
+
+    using NativeFunction = double (*)(const double*);
+
+    // A step of the program, in which the operands are on the top of the
+    // stack and are replaced by the result. A variable pushes the value of
+    // the declared variable with the given index.
+    struct Step {
+        const Lepton::Operation* operation;
+        int numArguments;
+        int variable;
+    };
+
+    Lepton::ParsedExpression m_parsed;
+    std::vector<std::string> m_variables;
+    // The operations of m_parsed, in postfix order (only valid for this copy
+    // of m_parsed).
+    std::vector<Step> m_program;
+    int m_maxStackSize = 0;
+    // The native code, if any, and the library that contains it (shared by
+    // copies).
+    NativeFunction m_nativeFunction = nullptr;
+    std::shared_ptr<void> m_library;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_EXPRESSION_EVALUATOR_H_
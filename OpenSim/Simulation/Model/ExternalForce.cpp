@@ -29,7 +29,6 @@
 #include <OpenSim/Common/Storage.h>
 #include <OpenSim/Common/Constant.h>
 #include <OpenSim/Common/PiecewiseLinearFunction.h>
-#include <OpenSim/Common/GCVSpline.h>
 
 #include "ExternalForce.h"
 
@@ -264,6 +263,27 @@ void ExternalForce::extendConnectToModel(Model& model)
     _forceFunctions.clearAndDestroy();
     _pointFunctions.clearAndDestroy();
     _torqueFunctions.clearAndDestroy();
+    _dataSpline = MultiChannelGCVSpline();
+    _forceChannel = _pointChannel = _torqueChannel = -1;
+
+    // With enough data for a cubic spline, interpolate all of the data with
+    // one spline so that the force, point and torque share a single search
+    // for the time interval.
+    if (nt > 3) {
+        std::vector<const double*> channels;
+        const auto addChannels = [&channels](
+                Array<Array<double> >& data, int& firstChannel) {
+            firstChannel = (int)channels.size();
+            for (int i = 0; i < 3; ++i) channels.push_back(&data[i][0]);
+        };
+        if (_appliesForce) {
+            addChannels(force, _forceChannel);
+            if (_specifiesPoint) addChannels(point, _pointChannel);
+        }
+        if (_appliesTorque) addChannels(torque, _torqueChannel);
+        _dataSpline = MultiChannelGCVSpline(3, nt, &time[0], channels);
+        return;
+    }
 
     // Create functions now that we should have good data remaining
     if(_appliesForce){
@@ -278,8 +298,6 @@ void ExternalForce::extendConnectToModel(Model& model)
                 case 3 :
                     _forceFunctions.append(new PiecewiseLinearFunction(force[i].getSize(), &time[0], &(force[i][0])) );
                     break;
-                default:
-                    _forceFunctions.append(new GCVSpline( 3, force[i].getSize(), &time[0], &(force[i][0])) );
             }   
         }
 
@@ -295,8 +313,6 @@ void ExternalForce::extendConnectToModel(Model& model)
                 case 3:
                     _pointFunctions.append(new PiecewiseLinearFunction(point[i].getSize(), &time[0], &(point[i][0])) );
                     break;
-                default:
-                    _pointFunctions.append(new GCVSpline( 3, point[i].getSize(), &time[0], &(point[i][0])) );
                 }
             }
         }
@@ -313,8 +329,6 @@ void ExternalForce::extendConnectToModel(Model& model)
                 case 3:
                     _torqueFunctions.append(new PiecewiseLinearFunction(torque[i].getSize(), &time[0], &(torque[i][0])) );
                     break;
-                default:
-                    _torqueFunctions.append(new GCVSpline( 3, torque[i].getSize(), &time[0], &(torque[i][0])) );
             }
         }
     }
@@ -335,12 +349,13 @@ void ExternalForce::computeForce(const SimTK::State& state,
 
     assert(_appliedToBody!=nullptr);
 
+    Vec3 force, point, torque;
+    calcDataAtTime(time, force, point, torque);
+
     if (_appliesForce) {
-        Vec3 force = getForceAtTime(time);
         force = _forceExpressedInBody->expressVectorInGround(state, force);
-        Vec3 point(0); // Default is body origin.
+        // The point is the body origin if it is not specified.
         if (_specifiesPoint) {
-            point = getPointAtTime(time);
             point = _pointExpressedInBody->
                 findStationLocationInAnotherFrame(state, point, *_appliedToBody);
         }
@@ -348,57 +363,88 @@ void ExternalForce::computeForce(const SimTK::State& state,
     }
 
     if (_appliesTorque) {
-        Vec3 torque = getTorqueAtTime(time);
         torque = _forceExpressedInBody->expressVectorInGround(state, torque);
         applyTorque(state, *_appliedToBody, torque, bodyForces);
     }
 }
 
+void ExternalForce::calcDataAtTime(double aTime, Vec3& force, Vec3& point,
+        Vec3& torque) const
+{
+    if (_dataSpline.getNumChannels() == 0) {
+        force = getForceAtTime(aTime);
+        point = getPointAtTime(aTime);
+        torque = getTorqueAtTime(aTime);
+        return;
+    }
+    double values[9];
+    _dataSpline.calcValues(aTime, values);
+    const auto getVec3 = [&values](int firstChannel) {
+        return firstChannel < 0 ? Vec3(0) : Vec3(values[firstChannel],
+                values[firstChannel + 1], values[firstChannel + 2]);
+    };
+    force = getVec3(_forceChannel);
+    point = getVec3(_pointChannel);
+    torque = getVec3(_torqueChannel);
+}
+
 /**
  * Convenience methods to access prescribed force functions
  */
 Vec3 ExternalForce::getForceAtTime(double aTime) const  
 {
-    SimTK::Vector timeAsVector(1, aTime);
+    if (_forceChannel >= 0) {
+        Vec3 force;
+        _dataSpline.calcValues(aTime, &force[0], _forceChannel, 3);
+        return force;
+    }
     const Function* forceX=NULL;
     const Function* forceY=NULL;
     const Function* forceZ=NULL;
     if (_forceFunctions.size()==3){
         forceX=_forceFunctions[0];  forceY=_forceFunctions[1];  forceZ=_forceFunctions[2];
     }
-    Vec3 force(forceX?forceX->calcValue(timeAsVector):0.0, 
-        forceY?forceY->calcValue(timeAsVector):0.0, 
-        forceZ?forceZ->calcValue(timeAsVector):0.0);
+    Vec3 force(forceX?forceX->calcValue(aTime):0.0, 
+        forceY?forceY->calcValue(aTime):0.0, 
+        forceZ?forceZ->calcValue(aTime):0.0);
     return force;
 }
 
 Vec3 ExternalForce::getPointAtTime(double aTime) const
 {
-    SimTK::Vector timeAsVector(1, aTime);
+    if (_pointChannel >= 0) {
+        Vec3 point;
+        _dataSpline.calcValues(aTime, &point[0], _pointChannel, 3);
+        return point;
+    }
     const Function* pointX=NULL;
     const Function* pointY=NULL;
     const Function* pointZ=NULL;
     if (_pointFunctions.size()==3){
         pointX=_pointFunctions[0];  pointY=_pointFunctions[1];  pointZ=_pointFunctions[2];
     }
-    Vec3 point(pointX?pointX->calcValue(timeAsVector):0.0, 
-        pointY?pointY->calcValue(timeAsVector):0.0, 
-        pointZ?pointZ->calcValue(timeAsVector):0.0);
+    Vec3 point(pointX?pointX->calcValue(aTime):0.0, 
+        pointY?pointY->calcValue(aTime):0.0, 
+        pointZ?pointZ->calcValue(aTime):0.0);
     return point;
 }
 
 Vec3 ExternalForce::getTorqueAtTime(double aTime) const
 {
-    SimTK::Vector timeAsVector(1, aTime);
+    if (_torqueChannel >= 0) {
+        Vec3 torque;
+        _dataSpline.calcValues(aTime, &torque[0], _torqueChannel, 3);
+        return torque;
+    }
     const Function* torqueX=NULL;
     const Function* torqueY=NULL;
     const Function* torqueZ=NULL;
     if (_torqueFunctions.size()==3){
         torqueX=_torqueFunctions[0];    torqueY=_torqueFunctions[1];    torqueZ=_torqueFunctions[2];
     }
-    Vec3 torque(torqueX?torqueX->calcValue(timeAsVector):0.0, 
-        torqueY?torqueY->calcValue(timeAsVector):0.0, 
-        torqueZ?torqueZ->calcValue(timeAsVector):0.0);
+    Vec3 torque(torqueX?torqueX->calcValue(aTime):0.0, 
+        torqueY?torqueY->calcValue(aTime):0.0, 
+        torqueZ?torqueZ->calcValue(aTime):0.0);
     return torque;
 }
 
@@ -24,6 +24,7 @@
  * -------------------------------------------------------------------------- */
 // INCLUDE
 #include "Force.h"
+#include <OpenSim/Common/MultiChannelGCVSpline.h>
 
 namespace OpenSim {
 
@@ -254,11 +255,25 @@ private:
     bool _specifiesPoint {false};
     bool _appliesTorque {false};
 
-    /** force data as a function of time used internally */
+    /** force data as a function of time used internally, if there are
+        fewer than 4 times in the data source */
     ArrayPtrs<Function> _forceFunctions;
     ArrayPtrs<Function> _torqueFunctions;
     ArrayPtrs<Function> _pointFunctions;
 
+    /** Otherwise, the force, point and torque data (those that are applied,
+        in that order) are interpolated together by one spline, whose
+        channels for each start at the given index (-1 if not applied). */
+    MultiChannelGCVSpline _dataSpline;
+    int _forceChannel {-1};
+    int _pointChannel {-1};
+    int _torqueChannel {-1};
+
+    /** The force, point and torque at the given time, from a single
+        evaluation of the spline. */
+    void calcDataAtTime(double aTime, SimTK::Vec3& force, SimTK::Vec3& point,
+            SimTK::Vec3& torque) const;
+
     friend class ExternalLoads;
 //==============================================================================
 };  // END of class ExternalForce
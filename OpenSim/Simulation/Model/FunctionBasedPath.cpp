@@ -0,0 +1,178 @@
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  FunctionBasedPath.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "FunctionBasedPath.h"
+#include "Model.h"
+#include <OpenSim/Common/Constant.h>
+#include <OpenSim/Simulation/SimbodyEngine/Coordinate.h>
+
+using namespace OpenSim;
+
+FunctionBasedPath::FunctionBasedPath() : GeometryPath() {
+    constructProperties();
+}
+
+FunctionBasedPath::FunctionBasedPath(const GeometryPath& path,
+        const std::vector<std::string>& coordinatePaths,
+        const Function& lengthFunction) : FunctionBasedPath() {
+    setName(path.getName());
+    updPathPointSet() = path.getPathPointSet();
+    updWrapSet() = path.getWrapSet();
+    upd_Appearance() = path.get_Appearance();
+    for (const auto& coordPath : coordinatePaths) {
+        append_coordinate_paths(coordPath);
+    }
+    set_length_function(lengthFunction);
+}
+
+void FunctionBasedPath::constructProperties() {
+    constructProperty_coordinate_paths();
+    constructProperty_length_function(Constant(0.0));
+}
+
+void FunctionBasedPath::extendFinalizeFromProperties() {
+    Super::extendFinalizeFromProperties();
+
+    OPENSIM_THROW_IF_FRMOBJ(getProperty_coordinate_paths().size() == 0,
+            InvalidPropertyValue, getProperty_coordinate_paths().getName(),
+            "Expected at least one coordinate.");
+    OPENSIM_THROW_IF_FRMOBJ(get_length_function().getArgumentSize() !=
+                    getProperty_coordinate_paths().size(),
+            InvalidPropertyValue, getProperty_length_function().getName(),
+            fmt::format("Expected the function to take {} arguments (one per "
+                        "coordinate), but it takes {}.",
+                    getProperty_coordinate_paths().size(),
+                    get_length_function().getArgumentSize()));
+    OPENSIM_THROW_IF_FRMOBJ(get_length_function().getMaxDerivativeOrder() < 1,
+            InvalidPropertyValue, getProperty_length_function().getName(),
+            "Expected the function to provide first-order derivatives.");
+}
+
+void FunctionBasedPath::extendConnectToModel(Model& model) {
+    Super::extendConnectToModel(model);
+
+    _coordinates.clear();
+    for (int i = 0; i < getProperty_coordinate_paths().size(); ++i) {
+        _coordinates.emplace_back(
+                &model.getComponent<Coordinate>(get_coordinate_paths(i)));
+    }
+}
+
+void FunctionBasedPath::extendAddToSystem(
+        SimTK::MultibodySystem& system) const {
+    Super::extendAddToSystem(system);
+
+    // The base class' length cache variable is updated whenever the
+    // geometric path is computed (e.g., for visualization), so we keep our
+    // own cache variables for the function-based quantities.
+    _functionLengthCV = addCacheVariable(
+            "function_length", 0.0, SimTK::Stage::Position);
+    _lengthPartialsCV = addCacheVariable("length_partials",
+            SimTK::Vector(getProperty_coordinate_paths().size(), 0.0),
+            SimTK::Stage::Position);
+    _functionSpeedCV = addCacheVariable(
+            "function_lengthening_speed", 0.0, SimTK::Stage::Velocity);
+}
+
+void FunctionBasedPath::computeLengthAndPartials(
+        const SimTK::State& s) const {
+    if (isCacheVariableValid(s, _functionLengthCV) &&
+            isCacheVariableValid(s, _lengthPartialsCV)) {
+        return;
+    }
+
+    const int numCoords = (int)_coordinates.size();
+    SimTK::Vector x(numCoords);
+    for (int i = 0; i < numCoords; ++i) {
+        x[i] = _coordinates[i]->getValue(s);
+    }
+
+    const Function& function = get_length_function();
+    setCacheVariableValue(s, _functionLengthCV, function.calcValue(x));
+
+    SimTK::Vector& partials = updCacheVariableValue(s, _lengthPartialsCV);
+    partials.resize(numCoords);
+    std::vector<int> derivComponents(1);
+    for (int i = 0; i < numCoords; ++i) {
+        derivComponents[0] = i;
+        partials[i] = function.calcDerivative(derivComponents, x);
+    }
+    markCacheVariableValid(s, _lengthPartialsCV);
+}
+
+const SimTK::Vector& FunctionBasedPath::getLengthPartials(
+        const SimTK::State& s) const {
+    computeLengthAndPartials(s);
+    return getCacheVariableValue(s, _lengthPartialsCV);
+}
+
+double FunctionBasedPath::getLength(const SimTK::State& s) const {
+    computeLengthAndPartials(s);
+    return getCacheVariableValue(s, _functionLengthCV);
+}
+
+double FunctionBasedPath::getLengtheningSpeed(const SimTK::State& s) const {
+    if (isCacheVariableValid(s, _functionSpeedCV)) {
+        return getCacheVariableValue(s, _functionSpeedCV);
+    }
+
+    const SimTK::Vector& partials = getLengthPartials(s);
+    double speed = 0;
+    for (int i = 0; i < (int)_coordinates.size(); ++i) {
+        speed += partials[i] * _coordinates[i]->getSpeedValue(s);
+    }
+    setCacheVariableValue(s, _functionSpeedCV, speed);
+    return speed;
+}
+
+double FunctionBasedPath::computeMomentArm(
+        const SimTK::State& s, const Coordinate& coord) const {
+    for (int i = 0; i < (int)_coordinates.size(); ++i) {
+        if (_coordinates[i].get() == &coord) {
+            return -getLengthPartials(s)[i];
+        }
+    }
+    return 0;
+}
+
+void FunctionBasedPath::addInEquivalentForces(const SimTK::State& s,
+        const double& tension, SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+        SimTK::Vector& mobilityForces) const {
+    // The generalized force is tension times the moment arm, -dl/dq. No
+    // forces are applied to bodies directly.
+    const SimTK::SimbodyMatterSubsystem& matter =
+            getModel().getMatterSubsystem();
+    const SimTK::Vector& partials = getLengthPartials(s);
+    for (int i = 0; i < (int)_coordinates.size(); ++i) {
+        const Coordinate& coord = *_coordinates[i];
+        matter.getMobilizedBody(coord.getBodyIndex())
+                .applyOneMobilityForce(s, coord.getMobilizerQIndex(),
+                        -tension * partials[i], mobilityForces);
+    }
+}
+
+void FunctionBasedPath::getPointForceDirections(const SimTK::State&,
+        OpenSim::Array<PointForceDirection*>*) const {
+    OPENSIM_THROW_FRMOBJ(Exception,
+            "getPointForceDirections() is not supported because the path "
+            "length is not defined by the path's geometry.");
+}
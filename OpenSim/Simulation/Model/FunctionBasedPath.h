@@ -0,0 +1,122 @@
+#ifndef OPENSIM_FUNCTION_BASED_PATH_H_
+#define OPENSIM_FUNCTION_BASED_PATH_H_
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  FunctionBasedPath.h                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "GeometryPath.h"
+
+#include <OpenSim/Common/Function.h>
+
+namespace OpenSim {
+
+class Coordinate;
+
+//=============================================================================
+//=============================================================================
+/**
+ * A GeometryPath whose length is a function of a few of the model's
+ * coordinates, l = f(q_1, ..., q_n), rather than the result of path point
+ * and wrapping geometry. The lengthening speed, moment arms, and the
+ * generalized forces that a tension along the path applies are all computed
+ * from the partial derivatives of the function:
+ *
+ *     dl/dt = sum_i df/dq_i * qdot_i
+ *     r_i   = -df/dq_i
+ *     tau_i = tension * r_i
+ *
+ * Evaluating a smooth function (e.g., a MultivariatePolynomialFunction) is
+ * much cheaper than evaluating wrapping geometry, so replacing the paths of a
+ * wrap-heavy model with function-based paths can speed up forward
+ * simulation, CMC, and Moco considerably. Use PolynomialPathFitter to
+ * create these functions from a model's existing paths.
+ *
+ * The path points and wrap objects inherited from GeometryPath are retained
+ * only so that the path can be visualized; they do not affect the length or
+ * the forces. Moment arms are computed with respect to the listed coordinates
+ * only (and are zero for all other coordinates); the coupling between
+ * coordinates due to kinematic constraints is not accounted for.
+ * getPointForceDirections() is not supported.
+ */
+class OSIMSIMULATION_API FunctionBasedPath : public GeometryPath {
+OpenSim_DECLARE_CONCRETE_OBJECT(FunctionBasedPath, GeometryPath);
+public:
+//=============================================================================
+// PROPERTIES
+//=============================================================================
+    OpenSim_DECLARE_LIST_PROPERTY(coordinate_paths, std::string,
+        "Paths to the coordinates on which the path length depends, in the "
+        "order of the arguments of the length function.");
+    OpenSim_DECLARE_PROPERTY(length_function, Function,
+        "The path length (m) as a function of the coordinate values. The "
+        "function must provide first-order derivatives.");
+
+//=============================================================================
+// METHODS
+//=============================================================================
+    FunctionBasedPath();
+
+    /** Create a function-based path with the path points, wrap objects, and
+    appearance of the provided path, so that it can replace that path. */
+    FunctionBasedPath(const GeometryPath& path,
+            const std::vector<std::string>& coordinatePaths,
+            const Function& lengthFunction);
+
+    /** Get the partial derivatives of the length with respect to each of
+    the coordinates in the coordinate_paths property. */
+    const SimTK::Vector& getLengthPartials(const SimTK::State& s) const;
+
+    // GeometryPath interface.
+    double getLength(const SimTK::State& s) const override;
+    double getLengtheningSpeed(const SimTK::State& s) const override;
+    double computeMomentArm(const SimTK::State& s,
+            const Coordinate& coord) const override;
+    void addInEquivalentForces(const SimTK::State& state,
+            const double& tension,
+            SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+            SimTK::Vector& mobilityForces) const override;
+    void getPointForceDirections(const SimTK::State& s,
+            OpenSim::Array<PointForceDirection*>* rPFDs) const override;
+
+protected:
+    void extendFinalizeFromProperties() override;
+    void extendConnectToModel(Model& model) override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
+
+private:
+    void constructProperties();
+    void computeLengthAndPartials(const SimTK::State& s) const;
+
+    // The coordinates listed in coordinate_paths.
+    std::vector<SimTK::ReferencePtr<const Coordinate>> _coordinates;
+
+    mutable CacheVariable<double> _functionLengthCV;
+    mutable CacheVariable<double> _functionSpeedCV;
+    mutable CacheVariable<SimTK::Vector> _lengthPartialsCV;
+
+//=============================================================================
+};  // END of class FunctionBasedPath
+//=============================================================================
+//=============================================================================
+
+} // end of namespace OpenSim
+
+#endif // OPENSIM_FUNCTION_BASED_PATH_H_
@@ -155,18 +155,18 @@ public:
     @see setDefaultColor() **/
     SimTK::Vec3 getColor(const SimTK::State& s) const;
 
-    double getLength( const SimTK::State& s) const;
+    virtual double getLength( const SimTK::State& s) const;
     void setLength( const SimTK::State& s, double length) const;
     double getPreScaleLength( const SimTK::State& s) const;
     void setPreScaleLength( const SimTK::State& s, double preScaleLength);
     const Array<AbstractPathPoint*>& getCurrentPath( const SimTK::State& s) const;
 
-    double getLengtheningSpeed(const SimTK::State& s) const;
+    virtual double getLengtheningSpeed(const SimTK::State& s) const;
     void setLengtheningSpeed( const SimTK::State& s, double speed ) const;
 
     /** get the path as PointForceDirections directions, which can be used
         to apply tension to bodies the points are connected to.*/
-    void getPointForceDirections(const SimTK::State& s, 
+    virtual void getPointForceDirections(const SimTK::State& s,
         OpenSim::Array<PointForceDirection*> *rPFDs) const;
 
     /** add in the equivalent body and generalized forces to be applied to the 
@@ -176,7 +176,7 @@ public:
     @param[in,out] bodyForces   Vector of SpatialVec's (torque, force) on bodies
     @param[in,out] mobilityForces  Vector of generalized forces, one per mobility   
     */
-    void addInEquivalentForces(const SimTK::State& state,
+    virtual void addInEquivalentForces(const SimTK::State& state,
                                const double& tension, 
                                SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
                                SimTK::Vector& mobilityForces) const;
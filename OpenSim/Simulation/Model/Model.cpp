@@ -40,6 +40,7 @@
 #include "MarkerSet.h"
 #include "ProbeSet.h"
 #include "SimTKcommon/internal/SystemGuts.h"
+#include <algorithm>
 #include <iostream>
 #include <string>
 
@@ -51,10 +52,14 @@
 #include <OpenSim/Common/XMLDocument.h>
 #include <OpenSim/Simulation/AssemblySolver.h>
 #include <OpenSim/Simulation/CoordinateReference.h>
+#include <OpenSim/Simulation/Model/FunctionBasedPath.h>
+#include <OpenSim/Simulation/Model/MovingPathPoint.h>
 #include <OpenSim/Simulation/SimbodyEngine/FreeJoint.h>
 #include <OpenSim/Simulation/SimbodyEngine/PointConstraint.h>
 #include <OpenSim/Simulation/SimbodyEngine/SimbodyEngine.h>
 #include <OpenSim/Simulation/SimbodyEngine/WeldConstraint.h>
+#include <OpenSim/Simulation/Wrap/PathWrap.h>
+#include <OpenSim/Simulation/Wrap/WrapObject.h>
 
 using namespace std;
 using namespace OpenSim;
@@ -590,6 +595,139 @@ void Model::createMultibodySystem()
                 direction, magnitude));
 
     addToSystem(*_system);
+
+    computeCoordinatesSpannedByPaths();
+}
+
+void Model::computeCoordinatesSpannedByPaths()
+{
+    _coordinatesSpannedByPath.clear();
+    const auto& matter = getMatterSubsystem();
+    auto isAncestorOrSelf = [&](SimTK::MobilizedBodyIndex ancestor,
+                                SimTK::MobilizedBodyIndex body) {
+        while (body != ancestor) {
+            if (body == SimTK::GroundIndex) return false;
+            body = matter.getMobilizedBody(body).getParentMobilizedBody()
+                    .getMobilizedBodyIndex();
+        }
+        return true;
+    };
+    const auto coordinates = getComponentList<Coordinate>();
+
+    for (const auto& path : getComponentList<GeometryPath>()) {
+        auto& spanned = _coordinatesSpannedByPath[&path];
+        if (const auto* fbPath = dynamic_cast<const FunctionBasedPath*>(&path)) {
+            // The length function determines the moment arms.
+            for (int i = 0; i < fbPath->getProperty_coordinate_paths().size();
+                    ++i) {
+                spanned.emplace_back(&getComponent<Coordinate>(
+                        fbPath->get_coordinate_paths(i)));
+            }
+            continue;
+        }
+
+        // The bodies on which the path applies forces, and the coordinates
+        // that move its path points.
+        std::vector<SimTK::MobilizedBodyIndex> bodies;
+        std::vector<const Coordinate*> pathCoordinates;
+        const PathPointSet& points = path.getPathPointSet();
+        for (int i = 0; i < points.getSize(); ++i) {
+            bodies.push_back(points[i].getParentFrame().findBaseFrame()
+                    .getMobilizedBodyIndex());
+            if (const auto* mpp =
+                    dynamic_cast<const MovingPathPoint*>(&points[i])) {
+                if (mpp->hasXCoordinate())
+                    pathCoordinates.push_back(&mpp->getXCoordinate());
+                if (mpp->hasYCoordinate())
+                    pathCoordinates.push_back(&mpp->getYCoordinate());
+                if (mpp->hasZCoordinate())
+                    pathCoordinates.push_back(&mpp->getZCoordinate());
+            }
+        }
+        const PathWrapSet& wraps = path.getWrapSet();
+        for (int i = 0; i < wraps.getSize(); ++i) {
+            if (const WrapObject* wrap = wraps[i].getWrapObject()) {
+                bodies.push_back(wrap->getFrame().findBaseFrame()
+                        .getMobilizedBodyIndex());
+            }
+        }
+
+        // The forces on the bodies are in equilibrium, so there is no
+        // generalized force at a joint unless the joint moves some, but not
+        // all, of the bodies.
+        for (const auto& coord : coordinates) {
+            int numMoved = 0;
+            for (const auto& body : bodies) {
+                if (isAncestorOrSelf(coord.getBodyIndex(), body)) ++numMoved;
+            }
+            if ((numMoved > 0 && numMoved < (int)bodies.size()) ||
+                    std::find(pathCoordinates.begin(), pathCoordinates.end(),
+                            &coord) != pathCoordinates.end()) {
+                spanned.emplace_back(&coord);
+            }
+        }
+    }
+}
+
+const std::vector<SimTK::ReferencePtr<const Coordinate>>&
+Model::getCoordinatesSpannedByPath(const GeometryPath& path) const
+{
+    OPENSIM_THROW_IF_FRMOBJ(!isValidSystem(), Exception,
+        "Cannot determine the spanned Coordinates without a valid "
+        "MultibodySystem.");
+    const auto it = _coordinatesSpannedByPath.find(&path);
+    OPENSIM_THROW_IF_FRMOBJ(it == _coordinatesSpannedByPath.end(), Exception,
+        "GeometryPath '{}' is not part of this Model.",
+        path.getAbsolutePathString());
+    return it->second;
+}
+
+bool Model::getPathSpansCoordinate(const GeometryPath& path,
+        const Coordinate& coordinate) const
+{
+    for (const auto& spanned : getCoordinatesSpannedByPath(path)) {
+        if (spanned.get() == &coordinate) return true;
+    }
+    return false;
+}
+
+std::vector<SimTK::ReferencePtr<const Coordinate>>
+Model::getCoordinatesCoupledByConstraints(const SimTK::State& s) const
+{
+    OPENSIM_THROW_IF_FRMOBJ(!isValidSystem(), Exception,
+        "Cannot determine the coupled Coordinates without a valid "
+        "MultibodySystem.");
+    const auto& matter = getMatterSubsystem();
+
+    // Mark the constrained bodies and all of the bodies above them.
+    std::vector<bool> coupled(matter.getNumBodies(), false);
+    auto markAncestors = [&](SimTK::MobilizedBodyIndex body) {
+        while (body != SimTK::GroundIndex && !coupled[body]) {
+            coupled[body] = true;
+            body = matter.getMobilizedBody(body).getParentMobilizedBody()
+                    .getMobilizedBodyIndex();
+        }
+    };
+    for (SimTK::ConstraintIndex c(0); c < matter.getNumConstraints(); ++c) {
+        const SimTK::Constraint& constraint = matter.getConstraint(c);
+        if (constraint.isDisabled(s)) continue;
+        for (SimTK::ConstrainedBodyIndex b(0);
+                b < constraint.getNumConstrainedBodies(); ++b) {
+            markAncestors(constraint.getMobilizedBodyFromConstrainedBody(b)
+                    .getMobilizedBodyIndex());
+        }
+        for (SimTK::ConstrainedMobilizerIndex m(0);
+                m < constraint.getNumConstrainedMobilizers(); ++m) {
+            markAncestors(constraint.getMobilizedBodyFromConstrainedMobilizer(m)
+                    .getMobilizedBodyIndex());
+        }
+    }
+
+    std::vector<SimTK::ReferencePtr<const Coordinate>> coordinates;
+    for (const auto& coord : getComponentList<Coordinate>()) {
+        if (coupled[coord.getBodyIndex()]) coordinates.emplace_back(&coord);
+    }
+    return coordinates;
 }
 
 
@@ -25,6 +25,7 @@
 
 // INCLUDES
 #include <string>
+#include <unordered_map>
 #include <OpenSim/Simulation/osimSimulationDLL.h>
 #include <OpenSim/Common/Units.h>
 #include <OpenSim/Common/ModelDisplayHints.h>
@@ -61,6 +62,7 @@ class Controller;
 class CoordinateSet;
 class Force;
 class Frame;
+class GeometryPath;
 class Muscle;
 class Storage;
 class ScaleSet;
@@ -872,6 +874,42 @@ public:
     std::vector<SimTK::ReferencePtr<const Coordinate>>
         getCoordinatesInMultibodyTreeOrder() const;
 
+    /** Obtain the Coordinates that a GeometryPath in this Model spans, that
+        is, the Coordinates about which the path can have a nonzero moment
+        arm. The path applies equal and opposite forces to the bodies to
+        which its path points (including MovingPathPoint and
+        ConditionalPathPoint) and wrap objects are attached, so it spans a
+        Coordinate if the Coordinate's joint lies between two of these bodies
+        in the multibody tree. The path also spans the Coordinates that move
+        its MovingPathPoints. A FunctionBasedPath spans the Coordinates of its
+        length function. Moment arms about all other Coordinates are
+        identically zero, unless a constraint couples the Coordinate to a
+        spanned one (see getCoordinatesCoupledByConstraints()).
+        This index is computed from the topology of the model when the
+        MultibodySystem is created (e.g., by initSystem()), so consumers of
+        moment arms can skip the many muscle-coordinate pairs whose moment
+        arms are zero.
+        Throws if the MultibodySystem is not valid or if the path is not part
+        of this Model. */
+    const std::vector<SimTK::ReferencePtr<const Coordinate>>&
+        getCoordinatesSpannedByPath(const GeometryPath& path) const;
+
+    /** Whether the GeometryPath spans the Coordinate (see
+        getCoordinatesSpannedByPath()). */
+    bool getPathSpansCoordinate(const GeometryPath& path,
+            const Coordinate& coordinate) const;
+
+    /** Obtain the Coordinates that the constraints enabled in the given state
+        may couple to other Coordinates. This includes the Coordinates of
+        constrained mobilizers and of the mobilizers above a constrained body
+        in the multibody tree. Because moment arms account for the coupling
+        between coordinates, a path may have a nonzero moment arm about these
+        Coordinates even if it does not span them (except for a
+        FunctionBasedPath, whose moment arms ignore constraints).
+        Throws if the MultibodySystem is not valid. */
+    std::vector<SimTK::ReferencePtr<const Coordinate>>
+        getCoordinatesCoupledByConstraints(const SimTK::State& s) const;
+
     /** Get a warning message if any Coordinates have a MotionType that is NOT
         consistent with its previous user-specified value that existed in 
         Model files prior to OpenSim 4.0 */
@@ -1091,6 +1129,9 @@ private:
 
     void createMultibodySystem();
 
+    // Compute the Coordinates spanned by each GeometryPath in the model.
+    void computeCoordinatesSpannedByPaths();
+
     void createAssemblySolver(const SimTK::State& s);
 
     // To provide access to private _modelComponents member.
@@ -1154,6 +1195,13 @@ private:
     // >5%.
     std::vector<std::reference_wrapper<const Controller>> _enabledControllers{};
 
+    // The Coordinates spanned by each GeometryPath in the model, computed
+    // when the MultibodySystem is created (see
+    // getCoordinatesSpannedByPath()).
+    SimTK::ResetOnCopy<std::unordered_map<const GeometryPath*,
+            std::vector<SimTK::ReferencePtr<const Coordinate>>>>
+        _coordinatesSpannedByPath;
+
     //--------------------------------------------------------------------------
     //                              RUN TIME 
     //--------------------------------------------------------------------------
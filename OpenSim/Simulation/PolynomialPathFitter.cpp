@@ -0,0 +1,293 @@
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  PolynomialPathFitter.cpp                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "PolynomialPathFitter.h"
+
+#include "SimulationUtilities.h"
+#include "Model/FunctionBasedPath.h"
+#include "Model/Model.h"
+#include "Model/PathActuator.h"
+#include "SimbodyEngine/CoordinateCouplerConstraint.h"
+#include <OpenSim/Common/Logger.h>
+#include <OpenSim/Common/MultivariatePolynomialFunction.h>
+
+#include <array>
+#include <map>
+#include <set>
+
+using namespace OpenSim;
+
+namespace {
+
+/// The exponents of each term of a MultivariatePolynomialFunction, in the
+/// order in which the function stores its coefficients.
+std::vector<std::array<int, 4>> createMonomialExponents(
+        int dimension, int order) {
+    std::vector<std::array<int, 4>> exponents;
+    std::array<int, 4> nq{{0, 0, 0, 0}};
+    for (nq[0] = 0; nq[0] < order + 1; ++nq[0]) {
+        const int nq1_s = dimension < 2 ? 0 : order - nq[0];
+        for (nq[1] = 0; nq[1] < nq1_s + 1; ++nq[1]) {
+            const int nq2_s = dimension < 3 ? 0 : order - nq[0] - nq[1];
+            for (nq[2] = 0; nq[2] < nq2_s + 1; ++nq[2]) {
+                const int nq3_s =
+                        dimension < 4 ? 0 : order - nq[0] - nq[1] - nq[2];
+                for (nq[3] = 0; nq[3] < nq3_s + 1; ++nq[3]) {
+                    exponents.push_back(nq);
+                }
+            }
+        }
+    }
+    return exponents;
+}
+
+/// Value of a monomial, or of its partial derivative with respect to
+/// argument `derivIndex` if `derivIndex` is not negative.
+double evalMonomial(const std::array<int, 4>& exponents, int dimension,
+        const double* x, int derivIndex) {
+    double value = 1;
+    for (int i = 0; i < dimension; ++i) {
+        if (i == derivIndex) {
+            if (exponents[i] == 0) return 0;
+            value *= exponents[i] * std::pow(x[i], exponents[i] - 1);
+        } else {
+            value *= std::pow(x[i], exponents[i]);
+        }
+    }
+    return value;
+}
+
+} // anonymous namespace
+
+void PolynomialPathFitter::setPolynomialOrder(int order) {
+    OPENSIM_THROW_IF(order < 0, Exception,
+            "Expected the polynomial order to be non-negative, but got {}.",
+            order);
+    m_order = order;
+}
+
+void PolynomialPathFitter::setNumSamplesPerCoordinate(int numSamples) {
+    OPENSIM_THROW_IF(numSamples < 2, Exception,
+            "Expected at least 2 samples per coordinate, but got {}.",
+            numSamples);
+    m_numSamplesPerCoordinate = numSamples;
+}
+
+std::vector<PolynomialPathFitter::PathFit> PolynomialPathFitter::fit(
+        Model& model) const {
+
+    // Coordinates that can be arguments of the polynomials.
+    // ------------------------------------------------------
+    std::set<std::string> dependentCoordNames;
+    for (const auto& coupler :
+            model.getComponentList<CoordinateCouplerConstraint>()) {
+        dependentCoordNames.insert(coupler.getDependentCoordinateName());
+    }
+    std::vector<std::string> coordPaths;
+    std::vector<double> coordMins;
+    std::vector<double> coordMaxs;
+    for (const auto& coord : model.getComponentList<Coordinate>()) {
+        if (coord.getDefaultLocked() ||
+                dependentCoordNames.count(coord.getName())) {
+            continue;
+        }
+        coordPaths.push_back(coord.getAbsolutePathString());
+        coordMins.push_back(coord.getRangeMin());
+        coordMaxs.push_back(coord.getRangeMax());
+    }
+
+    // Paths to fit. We hold on to the actuators so that we can replace their
+    // paths without traversing the component tree while it is modified.
+    // ------------------------------------------------------------------
+    std::vector<PathActuator*> actuators;
+    std::vector<std::string> pathPaths;
+    for (auto& actu : model.updComponentList<PathActuator>()) {
+        if (dynamic_cast<const FunctionBasedPath*>(&actu.getGeometryPath())) {
+            continue;
+        }
+        actuators.push_back(&actu);
+        pathPaths.push_back(actu.getGeometryPath().getAbsolutePathString());
+    }
+    std::vector<PathFit> fits(actuators.size());
+    for (int ip = 0; ip < (int)actuators.size(); ++ip) {
+        fits[ip].actuatorPath = actuators[ip]->getAbsolutePathString();
+    }
+    if (actuators.empty() || coordPaths.empty()) return fits;
+
+    // Determine the coordinates that each path spans.
+    // -----------------------------------------------
+    const int numCoords = (int)coordPaths.size();
+    const int numPoses = 7;
+    SimTK::Random::Uniform random(0, 1);
+    random.setSeed(0);
+    SimTK::Matrix poses(numPoses, numCoords);
+    for (int k = 0; k < numPoses; ++k) {
+        for (int ic = 0; ic < numCoords; ++ic) {
+            poses(k, ic) = coordMins[ic] +
+                           random.getValue() * (coordMaxs[ic] - coordMins[ic]);
+        }
+    }
+    const auto spanResults = computeGeometryPathsBatch(model, pathPaths,
+            coordPaths, poses, SimTK::Matrix(), true, m_numThreads);
+
+    // Group the paths by the set of coordinates they span, so that paths that
+    // cross the same joints share the samples.
+    std::map<std::vector<int>, std::vector<int>> groups;
+    for (int ip = 0; ip < (int)actuators.size(); ++ip) {
+        std::vector<int> spanned;
+        for (int ic = 0; ic < numCoords; ++ic) {
+            const auto& momentArms = spanResults.momentArms[ic];
+            for (int k = 0; k < numPoses; ++k) {
+                if (std::abs(momentArms(k, ip)) > m_momentArmThreshold) {
+                    spanned.push_back(ic);
+                    break;
+                }
+            }
+        }
+        for (int ic : spanned) fits[ip].coordinatePaths.push_back(
+                coordPaths[ic]);
+        if (spanned.empty()) {
+            log_warn("PolynomialPathFitter: path of '{}' does not span any "
+                     "coordinates; skipping.", fits[ip].actuatorPath);
+        } else if (spanned.size() > 4) {
+            log_warn("PolynomialPathFitter: path of '{}' spans {} "
+                     "coordinates, but at most 4 are supported; skipping.",
+                    fits[ip].actuatorPath, spanned.size());
+        } else {
+            groups[spanned].push_back(ip);
+        }
+    }
+
+    // Sample and fit each group.
+    // --------------------------
+    for (const auto& group : groups) {
+        const std::vector<int>& coordIndices = group.first;
+        const std::vector<int>& pathIndices = group.second;
+        const int dim = (int)coordIndices.size();
+
+        std::vector<std::string> groupCoordPaths;
+        for (int ic : coordIndices) groupCoordPaths.push_back(coordPaths[ic]);
+        std::vector<std::string> groupPathPaths;
+        for (int ip : pathIndices) groupPathPaths.push_back(pathPaths[ip]);
+
+        // A grid over the ranges of the coordinates.
+        const int s = m_numSamplesPerCoordinate;
+        int numSamples = 1;
+        for (int i = 0; i < dim; ++i) numSamples *= s;
+        SimTK::Matrix grid(numSamples, dim);
+        for (int k = 0; k < numSamples; ++k) {
+            int index = k;
+            for (int i = 0; i < dim; ++i) {
+                const int ic = coordIndices[i];
+                grid(k, i) = coordMins[ic] + (coordMaxs[ic] - coordMins[ic]) *
+                                                     (index % s) / (s - 1);
+                index /= s;
+            }
+        }
+        const auto results = computeGeometryPathsBatch(model, groupPathPaths,
+                groupCoordPaths, grid, SimTK::Matrix(), true, m_numThreads);
+
+        // Each sample provides one row for the length and one row for the
+        // derivative with respect to each coordinate. The matrix is the same
+        // for all paths in the group.
+        const auto exponents = createMonomialExponents(dim, m_order);
+        const int numCoeffs = (int)exponents.size();
+        const int rowsPerSample = 1 + dim;
+        SimTK::Matrix A(numSamples * rowsPerSample, numCoeffs);
+        for (int k = 0; k < numSamples; ++k) {
+            std::array<double, 4> x{{0, 0, 0, 0}};
+            for (int i = 0; i < dim; ++i) x[i] = grid(k, i);
+            for (int d = -1; d < dim; ++d) {
+                const int row = k * rowsPerSample + d + 1;
+                for (int c = 0; c < numCoeffs; ++c) {
+                    A(row, c) = evalMonomial(exponents[c], dim, x.data(), d);
+                }
+            }
+        }
+        SimTK::FactorQTZ qtz(A);
+
+        for (int j = 0; j < (int)pathIndices.size(); ++j) {
+            const int ip = pathIndices[j];
+            SimTK::Vector b(numSamples * rowsPerSample);
+            for (int k = 0; k < numSamples; ++k) {
+                b[k * rowsPerSample] = results.lengths(k, j);
+                for (int i = 0; i < dim; ++i) {
+                    b[k * rowsPerSample + 1 + i] =
+                            -results.momentArms[i](k, j);
+                }
+            }
+            SimTK::Vector coefficients;
+            qtz.solve(b, coefficients);
+
+            const SimTK::Vector residuals = A * coefficients - b;
+            double lengthSumSq = 0;
+            double lengthMax = 0;
+            double momentArmSumSq = 0;
+            double momentArmMax = 0;
+            for (int k = 0; k < numSamples; ++k) {
+                const double lengthErr = std::abs(residuals[k * rowsPerSample]);
+                lengthSumSq += lengthErr * lengthErr;
+                lengthMax = std::max(lengthMax, lengthErr);
+                for (int i = 0; i < dim; ++i) {
+                    const double maErr =
+                            std::abs(residuals[k * rowsPerSample + 1 + i]);
+                    momentArmSumSq += maErr * maErr;
+                    momentArmMax = std::max(momentArmMax, maErr);
+                }
+            }
+
+            PathFit& fit = fits[ip];
+            fit.numSamples = numSamples;
+            fit.lengthRMSError = std::sqrt(lengthSumSq / numSamples);
+            fit.lengthMaxError = lengthMax;
+            fit.momentArmRMSError =
+                    std::sqrt(momentArmSumSq / (numSamples * dim));
+            fit.momentArmMaxError = momentArmMax;
+
+            if (fit.lengthRMSError > m_maxLengthRMSError ||
+                    fit.momentArmRMSError > m_maxMomentArmRMSError) {
+                log_warn("PolynomialPathFitter: fit for the path of '{}' "
+                         "exceeds the error tolerances (length RMS error: {} "
+                         "m, moment arm RMS error: {} m); keeping the "
+                         "original path.",
+                        fit.actuatorPath, fit.lengthRMSError,
+                        fit.momentArmRMSError);
+                continue;
+            }
+
+            PathActuator& actu = *actuators[ip];
+            FunctionBasedPath path(actu.getGeometryPath(),
+                    fit.coordinatePaths,
+                    MultivariatePolynomialFunction(
+                            coefficients, dim, m_order));
+            actu.updProperty_GeometryPath().setValue(path);
+            fit.replaced = true;
+            log_info("PolynomialPathFitter: replaced the path of '{}' (length "
+                     "RMS error: {} m, moment arm RMS error: {} m).",
+                    fit.actuatorPath, fit.lengthRMSError,
+                    fit.momentArmRMSError);
+        }
+    }
+
+    model.finalizeFromProperties();
+    return fits;
+}
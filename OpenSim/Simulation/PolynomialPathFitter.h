@@ -0,0 +1,134 @@
+#ifndef OPENSIM_POLYNOMIAL_PATH_FITTER_H_
+#define OPENSIM_POLYNOMIAL_PATH_FITTER_H_
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  PolynomialPathFitter.h                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimSimulationDLL.h"
+
+#include <SimTKcommon.h>
+
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+class Model;
+
+/**
+ * Replace the GeometryPath%s of a model's PathActuator%s with
+ * FunctionBasedPath%s whose length is a MultivariatePolynomialFunction of the
+ * coordinates that the path spans.
+ *
+ * For each PathActuator, the fitter first determines the coordinates that the
+ * path spans by computing moment arms at a few poses spread across the
+ * coordinate ranges. It then samples the path length and moment arms on a
+ * grid over the ranges of the spanned coordinates, and solves a linear
+ * least-squares problem for the polynomial coefficients that fits both the
+ * lengths and the moment arms (r = -dl/dq). Paths whose fit errors exceed the
+ * provided tolerances, and paths that span more than 4 coordinates (the
+ * largest dimension that MultivariatePolynomialFunction supports), are left
+ * unchanged.
+ *
+ * Coordinates that are locked by default or that are the dependent coordinate
+ * of a CoordinateCouplerConstraint are not used as arguments to the
+ * polynomials; the effect of the coupling is folded into the moment arms with
+ * respect to the independent coordinates.
+ *
+ * @code
+ * Model model("subject.osim");
+ * model.initSystem();
+ * PolynomialPathFitter fitter;
+ * fitter.setPolynomialOrder(6);
+ * const auto results = fitter.fit(model);
+ * model.initSystem();
+ * @endcode
+ */
+class OSIMSIMULATION_API PolynomialPathFitter {
+public:
+    /** The outcome of fitting the path of a single PathActuator. Errors are
+    computed over the sampled grid. */
+    struct PathFit {
+        std::string actuatorPath;
+        std::vector<std::string> coordinatePaths;
+        int numSamples = 0;
+        double lengthRMSError = SimTK::NaN;
+        double lengthMaxError = SimTK::NaN;
+        double momentArmRMSError = SimTK::NaN;
+        double momentArmMaxError = SimTK::NaN;
+        /// Whether the path was replaced with a FunctionBasedPath.
+        bool replaced = false;
+    };
+
+    /** The largest sum of exponents in a single term of the polynomials
+    (default: 5). */
+    void setPolynomialOrder(int order);
+    int getPolynomialOrder() const { return m_order; }
+
+    /** The number of grid points along each coordinate's range (default: 10).
+    The total number of samples for a path is this number raised to the power
+    of the number of coordinates the path spans. */
+    void setNumSamplesPerCoordinate(int numSamples);
+    int getNumSamplesPerCoordinate() const { return m_numSamplesPerCoordinate; }
+
+    /** A path is replaced only if the root-mean-square error of the fitted
+    length is at most this value (default: 1e-3 m). */
+    void setMaxLengthRMSError(double error) { m_maxLengthRMSError = error; }
+    double getMaxLengthRMSError() const { return m_maxLengthRMSError; }
+
+    /** A path is replaced only if the root-mean-square error of the fitted
+    moment arms is at most this value (default: 1e-3 m). */
+    void setMaxMomentArmRMSError(double error) {
+        m_maxMomentArmRMSError = error;
+    }
+    double getMaxMomentArmRMSError() const { return m_maxMomentArmRMSError; }
+
+    /** A path spans a coordinate if the magnitude of its moment arm about the
+    coordinate exceeds this value at any of the tested poses (default: 1e-4
+    m). */
+    void setMomentArmThreshold(double threshold) {
+        m_momentArmThreshold = threshold;
+    }
+    double getMomentArmThreshold() const { return m_momentArmThreshold; }
+
+    /** The number of threads used to sample the paths (default: -1, which
+    means the number of hardware threads). */
+    void setNumThreads(int numThreads) { m_numThreads = numThreads; }
+    int getNumThreads() const { return m_numThreads; }
+
+    /** Fit and replace the paths of all PathActuator%s in the model that do
+    not already have a FunctionBasedPath. The model must be up to date with
+    its properties (e.g., call initSystem() first), and you must call
+    initSystem() again before using the model. */
+    std::vector<PathFit> fit(Model& model) const;
+
+private:
+    int m_order = 5;
+    int m_numSamplesPerCoordinate = 10;
+    double m_maxLengthRMSError = 1e-3;
+    double m_maxMomentArmRMSError = 1e-3;
+    double m_momentArmThreshold = 1e-4;
+    int m_numThreads = -1;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_POLYNOMIAL_PATH_FITTER_H_
@@ -36,18 +36,18 @@
 class CompoundFunction : public SimTK::Function {
 // returns f1(x[0]) - x[1];
 private:
-    std::unique_ptr<const SimTK::Function> f1;
+    // f1 is a function of one variable, so it is evaluated with
+    // OpenSim::Function's scalar methods, without creating a SimTK::Vector.
+    std::unique_ptr<const OpenSim::Function> f1;
     const double scale;
 
 public:
     
-    CompoundFunction(const SimTK::Function *cf, double scale) : f1(cf), scale(scale) {
+    CompoundFunction(const OpenSim::Function *cf, double scale) : f1(cf), scale(scale) {
     }
 
     double calcValue(const SimTK::Vector& x) const override {
-        SimTK::Vector xf(1);
-        xf[0] = x[0];
-        return scale*f1->calcValue(xf)-x[1];
+        return scale*f1->calcValue(x[0])-x[1];
     }
 
     double calcDerivative(const std::vector<int>& derivComponents, const SimTK::Vector& x) const {
@@ -56,20 +56,14 @@ public:
 
     double calcDerivative(const SimTK::Array_<int>& derivComponents, const SimTK::Vector& x) const override {
         if (derivComponents.size() == 1){
-            if (derivComponents[0]==0){
-                SimTK::Vector x1(1);
-                x1[0] = x[0];
-                return scale*f1->calcDerivative(derivComponents, x1);
-            }
+            if (derivComponents[0]==0)
+                return scale*f1->calcDerivative(x[0], 1);
             else if (derivComponents[0]==1)
                 return -1;
         }
         else if(derivComponents.size() == 2){
-            if (derivComponents[0]==0 && derivComponents[1] == 0){
-                SimTK::Vector x1(1);
-                x1[0] = x[0];
-                return scale*f1->calcDerivative(derivComponents, x1);
-            }
+            if (derivComponents[0]==0 && derivComponents[1] == 0)
+                return scale*f1->calcDerivative(x[0], 2);
         }
         return 0;
     }
@@ -81,7 +75,7 @@ public:
         return 2;
     }
 
-    void setFunction(const SimTK::Function *cf) {
+    void setFunction(const OpenSim::Function *cf) {
         f1.reset(cf);
     }
 };
@@ -224,7 +218,7 @@ void CoordinateCouplerConstraint::extendAddToSystem(SimTK::MultibodySystem& syst
 
     // Create and set the underlying coupler constraint function;
     const Function& f = get_coupled_coordinates_function();
-    SimTK::Function *simtkCouplerFunction = new CompoundFunction(f.createSimTKFunction(), get_scale_factor());
+    SimTK::Function *simtkCouplerFunction = new CompoundFunction(f.clone(), get_scale_factor());
 
 
     // Now create a Simbody Constraint::CoordinateCoupler
@@ -24,12 +24,16 @@
 #include "SimulationUtilities.h"
 
 #include "Manager/Manager.h"
+#include "Model/GeometryPath.h"
 #include "Model/Model.h"
 
 #include <simbody/internal/Visualizer_InputListener.h>
 
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/TableUtilities.h>
 
+#include <mutex>
+
 using namespace OpenSim;
 
 SimTK::State OpenSim::simulate(Model& model,
@@ -437,4 +441,133 @@ TimeSeriesTableVec3 OpenSim::createSyntheticIMUAccelerationSignals(
     accelTableIMU.setColumnLabels(framePaths);
 
     return accelTableIMU;
-}
\ No newline at end of file
+}
+
+GeometryPathBatchResults OpenSim::computeGeometryPathsBatch(
+        const Model& model, const std::vector<std::string>& pathPaths,
+        const std::vector<std::string>& coordinatePaths,
+        const SimTK::Matrix& coordinateValues,
+        const SimTK::Matrix& coordinateSpeeds, bool enforceConstraints,
+        int numThreads) {
+    const int numSamples = coordinateValues.nrow();
+    const int numPaths = (int)pathPaths.size();
+    const int numCoords = (int)coordinatePaths.size();
+    const bool computeSpeeds = coordinateSpeeds.nrow() > 0;
+
+    OPENSIM_THROW_IF(coordinateValues.ncol() != numCoords, Exception,
+            "Expected coordinateValues to have {} columns (one per "
+            "coordinate path), but it has {} columns.",
+            numCoords, coordinateValues.ncol());
+    OPENSIM_THROW_IF(computeSpeeds &&
+                    (coordinateSpeeds.nrow() != numSamples ||
+                            coordinateSpeeds.ncol() != numCoords),
+            Exception,
+            "Expected coordinateSpeeds to have the same shape as "
+            "coordinateValues ({} x {}), but it is {} x {}.",
+            numSamples, numCoords, coordinateSpeeds.nrow(),
+            coordinateSpeeds.ncol());
+    for (const auto& path : pathPaths) {
+        OPENSIM_THROW_IF(!model.hasComponent<GeometryPath>(path), Exception,
+                "Expected '{}' to be the path of a GeometryPath in the "
+                "model, but no such component was found.",
+                path);
+    }
+    for (const auto& path : coordinatePaths) {
+        OPENSIM_THROW_IF(!model.hasComponent<Coordinate>(path), Exception,
+                "Expected '{}' to be the path of a Coordinate in the "
+                "model, but no such component was found.",
+                path);
+    }
+
+    GeometryPathBatchResults results;
+    results.lengths.resize(numSamples, numPaths);
+    if (computeSpeeds) results.speeds.resize(numSamples, numPaths);
+    results.momentArms.assign(numCoords, SimTK::Matrix(numSamples, numPaths));
+
+    // Each thread writes to a disjoint set of rows of the results, so only
+    // copying the model requires synchronization.
+    std::mutex cloneMutex;
+    parallelForChunks(numSamples, numThreads,
+            [&](int /*threadIndex*/, int begin, int end) {
+                std::unique_ptr<Model> localModel;
+                {
+                    std::lock_guard<std::mutex> lock(cloneMutex);
+                    localModel.reset(model.clone());
+                }
+                SimTK::State state = localModel->initSystem();
+
+                std::vector<const GeometryPath*> paths;
+                for (const auto& path : pathPaths) {
+                    paths.push_back(
+                            &localModel->getComponent<GeometryPath>(path));
+                }
+                std::vector<const Coordinate*> coords;
+                for (const auto& path : coordinatePaths) {
+                    coords.push_back(
+                            &localModel->getComponent<Coordinate>(path));
+                }
+
+                // The moment arm of a path about a coordinate it does not
+                // span is zero unless a constraint couples the coordinate to
+                // others.
+                std::vector<bool> coupled(numCoords, false);
+                for (const auto& coupledCoord :
+                        localModel->getCoordinatesCoupledByConstraints(
+                                state)) {
+                    for (int icoord = 0; icoord < numCoords; ++icoord) {
+                        if (coords[icoord] == coupledCoord.get()) {
+                            coupled[icoord] = true;
+                        }
+                    }
+                }
+                std::vector<std::vector<bool>> computeMomentArm(numPaths,
+                        std::vector<bool>(numCoords, true));
+                for (int ipath = 0; ipath < numPaths; ++ipath) {
+                    for (int icoord = 0; icoord < numCoords; ++icoord) {
+                        computeMomentArm[ipath][icoord] = coupled[icoord] ||
+                                localModel->getPathSpansCoordinate(
+                                        *paths[ipath], *coords[icoord]);
+                    }
+                }
+
+                for (int isample = begin; isample < end; ++isample) {
+                    for (int icoord = 0; icoord < numCoords; ++icoord) {
+                        // Only enforce constraints once all coordinates of
+                        // the sample have been set.
+                        coords[icoord]->setValue(state,
+                                coordinateValues(isample, icoord),
+                                enforceConstraints &&
+                                        icoord == numCoords - 1);
+                        if (computeSpeeds) {
+                            coords[icoord]->setSpeedValue(state,
+                                    coordinateSpeeds(isample, icoord));
+                        }
+                    }
+
+                    if (computeSpeeds) {
+                        localModel->realizeVelocity(state);
+                    } else {
+                        localModel->realizePosition(state);
+                    }
+
+                    for (int ipath = 0; ipath < numPaths; ++ipath) {
+                        const auto& path = *paths[ipath];
+                        results.lengths(isample, ipath) =
+                                path.getLength(state);
+                        if (computeSpeeds) {
+                            results.speeds(isample, ipath) =
+                                    path.getLengtheningSpeed(state);
+                        }
+                        for (int icoord = 0; icoord < numCoords; ++icoord) {
+                            results.momentArms[icoord](isample, ipath) =
+                                    computeMomentArm[ipath][icoord]
+                                            ? path.computeMomentArm(
+                                                      state, *coords[icoord])
+                                            : 0.0;
+                        }
+                    }
+                }
+            });
+
+    return results;
+}
@@ -314,6 +314,55 @@ OSIMSIMULATION_API TimeSeriesTableVec3 createSyntheticIMUAccelerationSignals(
         const TimeSeriesTable& statesTable, const TimeSeriesTable& controlsTable,
         const std::vector<std::string>& framePaths);
 
+#ifndef SWIG
+/// The lengths, lengthening speeds, and moment arms computed by
+/// computeGeometryPathsBatch(). Row i of each matrix corresponds to row i of
+/// the provided coordinate values, and column j corresponds to the j-th path.
+/// @ingroup simulationutil
+struct GeometryPathBatchResults {
+    /// Path lengths (numSamples x numPaths).
+    SimTK::Matrix lengths;
+    /// Path lengthening speeds (numSamples x numPaths). This is empty if no
+    /// coordinate speeds were provided.
+    SimTK::Matrix speeds;
+    /// Moment arms (numSamples x numPaths), one matrix for each of the
+    /// provided coordinates, in the same order as the coordinate paths.
+    std::vector<SimTK::Matrix> momentArms;
+};
+
+/// Compute the lengths, lengthening speeds, and moment arms of many
+/// GeometryPath%s for many values of the model's coordinates in a single call.
+/// This is intended for building muscle-tendon length and moment arm lookup
+/// tables or fitting path surrogates, which require evaluating paths for a
+/// very large number of poses.
+///
+/// Each row of `coordinateValues` is one sample, and its columns contain the
+/// values of the coordinates listed in `coordinatePaths`; coordinates not
+/// listed keep their default values. If `coordinateSpeeds` is non-empty, it
+/// must have the same shape as `coordinateValues`, and lengthening speeds are
+/// computed as well. Moment arms are computed about every coordinate in
+/// `coordinatePaths`, except that moment arms about coordinates that a path
+/// does not span (see Model::getPathSpansCoordinate()) are set to zero without
+/// being computed. If `enforceConstraints` is true, the model is assembled
+/// after setting the coordinate values of each sample so that, e.g., coupled
+/// coordinates take on the correct values.
+///
+/// The samples are divided among `numThreads` threads (all hardware threads
+/// if `numThreads` is less than 1). Each thread uses its own copy of the
+/// model and a single SimTK::State that is reused across its samples, so the
+/// provided model is not modified.
+///
+/// @throws Exception if a path does not refer to a GeometryPath or a
+///     Coordinate in the model, or if the matrices have inconsistent sizes.
+/// @ingroup simulationutil
+OSIMSIMULATION_API GeometryPathBatchResults computeGeometryPathsBatch(
+        const Model& model, const std::vector<std::string>& pathPaths,
+        const std::vector<std::string>& coordinatePaths,
+        const SimTK::Matrix& coordinateValues,
+        const SimTK::Matrix& coordinateSpeeds = SimTK::Matrix(),
+        bool enforceConstraints = false, int numThreads = -1);
+#endif
+
 } // end of namespace OpenSim
 
 #endif // OPENSIM_SIMULATION_UTILITIES_H_
@@ -41,6 +41,7 @@
 //==============================================================================
 #include "SimTKcommon/internal/Xml.h"
 #include <ctime> // clock(), clock_t, CLOCKS_PER_SEC
+#include <thread>
 
 #include <OpenSim/Analyses/osimAnalyses.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
@@ -70,6 +71,7 @@ void testCoordinateLimitForce();
 void testCoordinateLimitForceRotational();
 void testExpressionBasedPointToPointForce();
 void testExpressionBasedCoordinateForce();
+void testExpressionEvaluator();
 void testSerializeDeserialize();
 void testTranslationalDampingEffect(Model& osimModel, Coordinate& sliderCoord,
         double start_h, Component& componentWithDamping);
@@ -161,6 +163,12 @@ int main() {
         failures.push_back("testExpressionBasedCoordinateForce");
     }
 
+    try { testExpressionEvaluator(); }
+    catch (const std::exception& e){
+        cout << e.what() <<endl;
+        failures.push_back("testExpressionEvaluator");
+    }
+
     try { testSerializeDeserialize(); }
     catch (const std::exception& e){
         cout << e.what() <<endl;
@@ -287,6 +295,64 @@ void testExpressionBasedCoordinateForce() {
     osimModel.disownAllComponents();
 }
 
+void testExpressionEvaluator() {
+    // Variables may be declared without being used, in any order.
+    ExpressionEvaluator expression("-10*q-5*qdot", {"t", "qdot", "q"});
+    ASSERT_EQUAL(-10.0 * 0.3 - 5.0 * 2.0,
+            expression.evaluate({1.0, 2.0, 0.3}), 1e-15);
+    ASSERT_EQUAL(0.0, ExpressionEvaluator().evaluate(nullptr), 0.0);
+
+    // A copy refers to its own expression and outlives the original.
+    std::unique_ptr<ExpressionEvaluator> original(
+            new ExpressionEvaluator("d^2+ddot", {"d", "ddot"}));
+    ExpressionEvaluator copy(*original);
+    ExpressionEvaluator assigned;
+    assigned = *original;
+    ASSERT_EQUAL(5.0, original->evaluate({2.0, 1.0}), 1e-15);
+    original.reset();
+    ASSERT_EQUAL(10.0, copy.evaluate({3.0, 1.0}), 1e-15);
+    ASSERT_EQUAL(17.0, assigned.evaluate({4.0, 1.0}), 1e-15);
+
+    ASSERT_THROW(OpenSim::Exception,
+            ExpressionEvaluator("q+x", {"q", "qdot"}));
+
+    // The same evaluator may be used from multiple threads at once.
+    const ExpressionEvaluator shared("q*qdot+sin(q)", {"q", "qdot"});
+    std::vector<int> numWrong(4, 0);
+    std::vector<std::thread> threads;
+    for (int ithread = 0; ithread < (int)numWrong.size(); ++ithread) {
+        threads.emplace_back([&shared, &numWrong, ithread]() {
+            for (int i = 0; i < 10000; ++i) {
+                const double q = ithread + 1e-4 * i;
+                if (shared.evaluate({q, 2.0}) != q * 2.0 + std::sin(q)) {
+                    ++numWrong[ithread];
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    for (const int wrong : numWrong) ASSERT(wrong == 0);
+
+#ifndef _WIN32
+    // Native code (if a C compiler is available) must match the interpreter.
+    const std::string complex = "q^2*sin(qdot)+step(q)*max(q,qdot)/(1+q^2)";
+    setenv("OPENSIM_EXPRESSION_JIT_CACHE", "testForces_expression_cache", 1);
+    ExpressionEvaluator native(complex, {"q", "qdot"});
+    unsetenv("OPENSIM_EXPRESSION_JIT_CACHE");
+    ExpressionEvaluator interpreted(complex, {"q", "qdot"});
+    ASSERT(!interpreted.isNative());
+    cout << "ExpressionEvaluator native code: " << native.isNative() << endl;
+    ExpressionEvaluator nativeCopy(native);
+    ASSERT(nativeCopy.isNative() == native.isNative());
+    for (double q : {-1.5, 0.0, 0.25, 2.0}) {
+        for (double qdot : {-0.5, 0.0, 3.0}) {
+            ASSERT_EQUAL(interpreted.evaluate({q, qdot}),
+                    nativeCopy.evaluate({q, qdot}), 1e-12);
+        }
+    }
+#endif
+}
+
 void testExpressionBasedPointToPointForce() {
     using namespace SimTK;
 
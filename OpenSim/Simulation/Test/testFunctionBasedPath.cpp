@@ -0,0 +1,237 @@
+/* -------------------------------------------------------------------------- *
+ *                   OpenSim:  testFunctionBasedPath.cpp                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+#include <OpenSim/Common/LoadOpenSimLibrary.h>
+#include <OpenSim/Common/MultivariatePolynomialFunction.h>
+#include <OpenSim/Simulation/Model/FunctionBasedPath.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Model/PathActuator.h>
+#include <OpenSim/Simulation/PolynomialPathFitter.h>
+
+#include <algorithm>
+
+using namespace OpenSim;
+using namespace std;
+
+void testFunctionBasedPathDerivatives();
+void testPolynomialPathFitter();
+
+int main() {
+    LoadOpenSimLibrary("osimActuators");
+
+    SimTK_START_TEST("testFunctionBasedPath");
+        SimTK_SUBTEST(testFunctionBasedPathDerivatives);
+        SimTK_SUBTEST(testPolynomialPathFitter);
+    SimTK_END_TEST();
+}
+
+// The length, lengthening speed, moment arms, and generalized forces follow
+// from the function and its partial derivatives.
+void testFunctionBasedPathDerivatives() {
+    Model model("arm26.osim");
+    auto& actu = model.updComponent<PathActuator>("/forceset/BIClong");
+    const std::string shoulder = "/jointset/r_shoulder/r_shoulder_elev";
+    const std::string elbow = "/jointset/r_elbow/r_elbow_flex";
+
+    // l = 0.3 + 0.01 q0 + 0.02 q1 + 0.03 q0 q1. The coefficients of a
+    // dimension 2, order 2 polynomial are ordered
+    // [1, q1, q1^2, q0, q0 q1, q0^2].
+    SimTK::Vector coefficients(6, 0.0);
+    coefficients[0] = 0.3;  // 1
+    coefficients[1] = 0.02; // q1
+    coefficients[3] = 0.01; // q0
+    coefficients[4] = 0.03; // q0 q1
+    FunctionBasedPath path(actu.getGeometryPath(), {shoulder, elbow},
+            MultivariatePolynomialFunction(coefficients, 2, 2));
+    actu.updProperty_GeometryPath().setValue(path);
+
+    SimTK::State state = model.initSystem();
+    const auto& q0 = model.getComponent<Coordinate>(shoulder);
+    const auto& q1 = model.getComponent<Coordinate>(elbow);
+    q0.setValue(state, 0.4, false);
+    q1.setValue(state, 1.1, false);
+    q0.setSpeedValue(state, -0.5);
+    q1.setSpeedValue(state, 2.0);
+    model.realizeVelocity(state);
+
+    const auto& fbp = dynamic_cast<const FunctionBasedPath&>(
+            model.getComponent<PathActuator>("/forceset/BIClong")
+                    .getGeometryPath());
+    const double dldq0 = 0.01 + 0.03 * 1.1;
+    const double dldq1 = 0.02 + 0.03 * 0.4;
+    ASSERT_EQUAL(0.3 + 0.01 * 0.4 + 0.02 * 1.1 + 0.03 * 0.4 * 1.1,
+            fbp.getLength(state), 1e-12);
+    ASSERT_EQUAL(dldq0 * -0.5 + dldq1 * 2.0, fbp.getLengtheningSpeed(state),
+            1e-12);
+    ASSERT_EQUAL(-dldq0, fbp.computeMomentArm(state, q0), 1e-12);
+    ASSERT_EQUAL(-dldq1, fbp.computeMomentArm(state, q1), 1e-12);
+
+    // A coordinate that the path does not depend on.
+    Model other("arm26.osim");
+    other.initSystem();
+    ASSERT_EQUAL(0.0, fbp.computeMomentArm(state,
+            other.getComponent<Coordinate>(shoulder)), 0.0);
+
+    const auto& matter = model.getMatterSubsystem();
+    SimTK::Vector_<SimTK::SpatialVec> bodyForces(matter.getNumBodies());
+    bodyForces.setToZero();
+    SimTK::Vector mobilityForces(state.getNU(), 0.0);
+    const double tension = 10.0;
+    fbp.addInEquivalentForces(state, tension, bodyForces, mobilityForces);
+    ASSERT_EQUAL(-tension * dldq0,
+            mobilityForces[q0.getMobilizerQIndex() +
+                    matter.getMobilizedBody(q0.getBodyIndex())
+                            .getFirstUIndex(state)],
+            1e-12);
+    ASSERT_EQUAL(-tension * dldq1,
+            mobilityForces[q1.getMobilizerQIndex() +
+                    matter.getMobilizedBody(q1.getBodyIndex())
+                            .getFirstUIndex(state)],
+            1e-12);
+
+    // Serialization.
+    model.print("testFunctionBasedPath_arm26.osim");
+    Model deserialized("testFunctionBasedPath_arm26.osim");
+    SimTK::State state2 = deserialized.initSystem();
+    deserialized.getComponent<Coordinate>(shoulder).setValue(state2, 0.4, false);
+    deserialized.getComponent<Coordinate>(elbow).setValue(state2, 1.1, false);
+    deserialized.realizePosition(state2);
+    ASSERT_EQUAL(fbp.getLength(state),
+            deserialized.getComponent<PathActuator>("/forceset/BIClong")
+                    .getGeometryPath().getLength(state2),
+            1e-12);
+
+    // The number of coordinates must match the function's arguments.
+    Model invalid("arm26.osim");
+    auto& invalidActu = invalid.updComponent<PathActuator>("/forceset/BRA");
+    invalidActu.updProperty_GeometryPath().setValue(
+            FunctionBasedPath(invalidActu.getGeometryPath(), {elbow},
+                    MultivariatePolynomialFunction(coefficients, 2, 2)));
+    SimTK_TEST_MUST_THROW_EXC(invalid.initSystem(), InvalidPropertyValue);
+}
+
+// The fitted paths reproduce the lengths, moment arms, and generalized forces
+// of the original paths.
+void testPolynomialPathFitter() {
+    Model original("arm26.osim");
+    SimTK::State origState = original.initSystem();
+
+    Model fitted("arm26.osim");
+    fitted.initSystem();
+    PolynomialPathFitter fitter;
+    fitter.setPolynomialOrder(6);
+    fitter.setNumSamplesPerCoordinate(15);
+    fitter.setMaxLengthRMSError(2e-3);
+    fitter.setMaxMomentArmRMSError(2e-3);
+    fitter.setNumThreads(2);
+    const auto fits = fitter.fit(fitted);
+    SimTK::State fitState = fitted.initSystem();
+
+    int numActu = 0;
+    for (const auto& actu : original.getComponentList<PathActuator>()) {
+        (void)actu;
+        ++numActu;
+    }
+    SimTK_TEST((int)fits.size() == numActu);
+    for (const auto& fit : fits) {
+        SimTK_TEST(fit.replaced);
+        SimTK_TEST(!fit.coordinatePaths.empty());
+        SimTK_TEST(fit.lengthRMSError < 2e-3);
+        SimTK_TEST(fit.momentArmRMSError < 2e-3);
+        SimTK_TEST(dynamic_cast<const FunctionBasedPath*>(
+                &fitted.getComponent<PathActuator>(fit.actuatorPath)
+                         .getGeometryPath()) != nullptr);
+    }
+    // Every arm26 muscle crosses the elbow; the biarticular ones also cross
+    // the shoulder.
+    const auto& tri = *std::find_if(fits.begin(), fits.end(),
+            [](const PolynomialPathFitter::PathFit& fit) {
+                return fit.actuatorPath == "/forceset/TRIlong";
+            });
+    SimTK_TEST(tri.coordinatePaths.size() == 2);
+
+    // Fitting again does not touch paths that are already function-based.
+    SimTK_TEST(fitter.fit(fitted).empty());
+
+    const auto& matter = original.getMatterSubsystem();
+    const std::vector<SimTK::Vec2> poses = {
+            {0.1, 0.3}, {0.8, 1.5}, {1.5, 0.7}, {-0.5, 2.0}};
+    for (const auto& pose : poses) {
+        for (auto* s : {&origState, &fitState}) {
+            Model& m = (s == &origState) ? original : fitted;
+            m.getComponent<Coordinate>("/jointset/r_shoulder/r_shoulder_elev")
+                    .setValue(*s, pose[0], false);
+            m.getComponent<Coordinate>("/jointset/r_elbow/r_elbow_flex")
+                    .setValue(*s, pose[1], false);
+            m.getComponent<Coordinate>("/jointset/r_shoulder/r_shoulder_elev")
+                    .setSpeedValue(*s, 1.0);
+            m.getComponent<Coordinate>("/jointset/r_elbow/r_elbow_flex")
+                    .setSpeedValue(*s, -1.0);
+            m.realizeVelocity(*s);
+        }
+
+        for (const auto& actu : original.getComponentList<PathActuator>()) {
+            const auto& origPath = actu.getGeometryPath();
+            const auto& fitPath =
+                    fitted.getComponent<PathActuator>(
+                                  actu.getAbsolutePathString())
+                            .getGeometryPath();
+            ASSERT_EQUAL(origPath.getLength(origState),
+                    fitPath.getLength(fitState), 1e-2);
+            ASSERT_EQUAL(origPath.getLengtheningSpeed(origState),
+                    fitPath.getLengtheningSpeed(fitState), 1e-2);
+            for (const auto& coord : original.getComponentList<Coordinate>()) {
+                const auto& fitCoord = fitted.getComponent<Coordinate>(
+                        coord.getAbsolutePathString());
+                ASSERT_EQUAL(origPath.computeMomentArm(origState, coord),
+                        fitPath.computeMomentArm(fitState, fitCoord), 1e-2);
+            }
+
+            // Equivalent generalized forces.
+            const double tension = 100.0;
+            SimTK::Vector origGenForces;
+            {
+                SimTK::Vector_<SimTK::SpatialVec> bodyForces(
+                        matter.getNumBodies(), SimTK::SpatialVec(0));
+                SimTK::Vector mobilityForces(origState.getNU(), 0.0);
+                origPath.addInEquivalentForces(
+                        origState, tension, bodyForces, mobilityForces);
+                matter.multiplyBySystemJacobianTranspose(
+                        origState, bodyForces, origGenForces);
+                origGenForces += mobilityForces;
+            }
+            SimTK::Vector fitGenForces;
+            {
+                SimTK::Vector_<SimTK::SpatialVec> bodyForces(
+                        matter.getNumBodies(), SimTK::SpatialVec(0));
+                SimTK::Vector mobilityForces(fitState.getNU(), 0.0);
+                fitPath.addInEquivalentForces(
+                        fitState, tension, bodyForces, mobilityForces);
+                fitted.getMatterSubsystem().multiplyBySystemJacobianTranspose(
+                        fitState, bodyForces, fitGenForces);
+                fitGenForces += mobilityForces;
+            }
+            SimTK_TEST_EQ_TOL(origGenForces, fitGenForces, tension * 1e-2);
+        }
+    }
+}
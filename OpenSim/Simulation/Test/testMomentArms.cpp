@@ -36,11 +36,14 @@
 //=============================================================================
 #include <OpenSim/Simulation/osimSimulation.h>
 #include <OpenSim/Actuators/Thelen2003Muscle.h>
+#include <OpenSim/Analyses/MuscleAnalysis.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include <OpenSim/Common/LoadOpenSimLibrary.h>
 
 #include "SimulationComponentsForTesting.h"
 
+#include <algorithm>
+
 using namespace OpenSim;
 using namespace std;
 
@@ -55,6 +58,8 @@ void testMomentArmDefinitionForModel(const string &filename,
                                      double mass = -1.0, string errorMessage = "");
 
 void testMomentArmsAcrossCompoundJoint();
+void testMuscleAnalysisMomentArms(const string& filename);
+void testCoordinatesSpannedByPath();
 
 int main()
 {
@@ -67,6 +72,14 @@ int main()
         testMomentArmsAcrossCompoundJoint();
         cout << "Joint composed of more than one mobilized body: PASSED\n" << endl;
 
+        testMuscleAnalysisMomentArms("gait2354_simbody.osim");
+        testMuscleAnalysisMomentArms("testMomentArmsConstraintB.osim");
+        testMuscleAnalysisMomentArms("WrapPathCustomJointMomentArmTest.osim");
+        cout << "MuscleAnalysis with threads and unspanned coordinates skipped: PASSED\n" << endl;
+
+        testCoordinatesSpannedByPath();
+        cout << "Coordinates spanned by paths: PASSED\n" << endl;
+
         testMomentArmDefinitionForModel("BothLegs22.osim", "r_knee_angle", "VASINT", 
             SimTK::Vec2(-2*SimTK::Pi/3, SimTK::Pi/18), 0.0, 
             "VASINT of BothLegs with no mass: FAILED");
@@ -442,3 +455,109 @@ void testMomentArmDefinitionForModel(const string &filename, const string &coord
     // dL/dTheta definition or is at least dynamically consistent, in which dL/dTheta is not
     ASSERT(passesDefinition || passesDynamicConsistency, __FILE__, __LINE__, errorMessage);
 }
+
+// Moment arms from a MuscleAnalysis that uses multiple threads and skips
+// coordinates that muscles do not span must match the moment arms computed
+// for every muscle and coordinate on one thread.
+void testMuscleAnalysisMomentArms(const string& filename)
+{
+    auto recordMomentArms = [&](int numThreads, bool skip) {
+        Model model(filename);
+        auto* analysis = new MuscleAnalysis(&model);
+        analysis->setNumThreads(numThreads);
+        analysis->setSkipUnspannedCoordinates(skip);
+        model.addAnalysis(analysis);
+        SimTK::State& s = model.initSystem();
+        // A pose other than the default pose.
+        const auto& coordinates = model.getCoordinateSet();
+        for (int i = 0; i < coordinates.getSize(); ++i) {
+            if (coordinates[i].isConstrained(s) || coordinates[i].getLocked(s))
+                continue;
+            const double lower = std::max(coordinates[i].getRangeMin(), -1.0);
+            const double upper = std::min(coordinates[i].getRangeMax(), 1.0);
+            coordinates[i].setValue(s, lower + 0.37 * (upper - lower), false);
+        }
+        model.assemble(s);
+        analysis->begin(s);
+        std::vector<SimTK::Vector> momentArms;
+        const auto& pairs = analysis->getMomentArmStorageArray();
+        for (int i = 0; i < pairs.getSize(); ++i) {
+            SimTK::Vector row;
+            pairs[i]->momentArmStore->getDataAtTime(s.getTime(),
+                    pairs[i]->momentArmStore->getColumnLabels().getSize() - 1,
+                    row);
+            momentArms.push_back(row);
+        }
+        return momentArms;
+    };
+
+    const auto expected = recordMomentArms(1, false);
+    const auto actual = recordMomentArms(4, true);
+    ASSERT(expected.size() == actual.size(), __FILE__, __LINE__,
+            "Number of coordinates differs.");
+    int numZero = 0;
+    for (size_t i = 0; i < expected.size(); ++i) {
+        for (int j = 0; j < expected[i].size(); ++j) {
+            ASSERT_EQUAL(expected[i][j], actual[i][j], 1e-10, __FILE__,
+                    __LINE__, "Moment arms from " + filename + " differ.");
+            if (actual[i][j] == 0) ++numZero;
+        }
+    }
+    cout << filename << ": " << numZero << " zero moment arm(s)." << endl;
+}
+
+// Paths must have zero moment arms about the coordinates that the Model
+// reports they do not span.
+void testCoordinatesSpannedByPath()
+{
+    Model model("gait2354_simbody.osim");
+    SimTK::State& s = model.initSystem();
+    ASSERT(model.getCoordinatesCoupledByConstraints(s).empty(), __FILE__,
+            __LINE__, "Expected no coordinates coupled by constraints.");
+
+    const auto& soleus = model.getComponent<GeometryPath>(
+            "/forceset/soleus_r/geometrypath");
+    const auto& rectFem = model.getComponent<GeometryPath>(
+            "/forceset/rect_fem_r/geometrypath");
+    const auto& coordinates = model.getCoordinateSet();
+    ASSERT(model.getPathSpansCoordinate(soleus, coordinates.get("ankle_angle_r")));
+    ASSERT(!model.getPathSpansCoordinate(soleus, coordinates.get("knee_angle_r")));
+    ASSERT(!model.getPathSpansCoordinate(soleus, coordinates.get("pelvis_tx")));
+    ASSERT(!model.getPathSpansCoordinate(soleus, coordinates.get("ankle_angle_l")));
+    ASSERT(model.getPathSpansCoordinate(rectFem, coordinates.get("hip_flexion_r")));
+    ASSERT(model.getPathSpansCoordinate(rectFem, coordinates.get("knee_angle_r")));
+    ASSERT(model.getCoordinatesSpannedByPath(rectFem).size() == 4);
+
+    for (const double value : {-0.3, 0.4}) {
+        for (int i = 0; i < coordinates.getSize(); ++i) {
+            if (!coordinates[i].getLocked(s))
+                coordinates[i].setValue(s, value, false);
+        }
+        model.realizePosition(s);
+        for (const auto& path : model.getComponentList<GeometryPath>()) {
+            const auto& spanned = model.getCoordinatesSpannedByPath(path);
+            for (int i = 0; i < coordinates.getSize(); ++i) {
+                const bool spans =
+                        model.getPathSpansCoordinate(path, coordinates[i]);
+                ASSERT(spans == (std::find_if(spanned.begin(), spanned.end(),
+                        [&](const SimTK::ReferencePtr<const Coordinate>& c) {
+                            return c.get() == &coordinates[i];
+                        }) != spanned.end()));
+                if (!spans) {
+                    ASSERT_EQUAL(0.0, path.computeMomentArm(s, coordinates[i]),
+                            1e-10, __FILE__, __LINE__,
+                            path.getAbsolutePathString() +
+                                    " has a moment arm about " +
+                                    coordinates[i].getName() +
+                                    ", which it does not span.");
+                }
+            }
+        }
+    }
+
+    // The index is built when the system is created.
+    Model unbuilt("gait2354_simbody.osim");
+    ASSERT_THROW(Exception, unbuilt.getCoordinatesSpannedByPath(
+            unbuilt.getComponent<GeometryPath>(
+                    "/forceset/soleus_r/geometrypath")));
+}
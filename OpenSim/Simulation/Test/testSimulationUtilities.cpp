@@ -23,6 +23,7 @@
 
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Model/PathActuator.h>
 #include <OpenSim/Simulation/SimbodyEngine/FreeJoint.h>
 #include <OpenSim/Simulation/SimulationUtilities.h>
 #include <OpenSim/Common/LoadOpenSimLibrary.h>
@@ -31,12 +32,14 @@ using namespace OpenSim;
 using namespace std;
 
 void testUpdatePre40KinematicsFor40MotionType();
+void testComputeGeometryPathsBatch();
 
 int main() {
     LoadOpenSimLibrary("osimActuators");
 
     SimTK_START_TEST("testSimulationUtilities");
         SimTK_SUBTEST(testUpdatePre40KinematicsFor40MotionType);
+        SimTK_SUBTEST(testComputeGeometryPathsBatch);
     SimTK_END_TEST();
 }
 
@@ -174,22 +177,72 @@ void testUpdatePre40KinematicsFor40MotionType() {
     }
 }
 
+// The batched path computation should match computing each sample one at a
+// time, independent of the number of threads.
+void testComputeGeometryPathsBatch() {
+    Model model("arm26.osim");
+    model.initSystem();
+
+    std::vector<std::string> pathPaths;
+    for (const auto& name : {"TRIlong", "BIClong", "BRA"}) {
+        pathPaths.push_back(model.getComponent<PathActuator>(
+                "/forceset/" + std::string(name)).getGeometryPath()
+                        .getAbsolutePathString());
+    }
+    const std::vector<std::string> coordPaths = {
+            "/jointset/r_shoulder/r_shoulder_elev",
+            "/jointset/r_elbow/r_elbow_flex"};
+
+    const int numSamples = 17;
+    SimTK::Matrix values(numSamples, 2);
+    SimTK::Matrix speeds(numSamples, 2);
+    for (int i = 0; i < numSamples; ++i) {
+        values(i, 0) = -0.5 + 1.5 * i / (numSamples - 1);
+        values(i, 1) = 2.0 * i / (numSamples - 1);
+        speeds(i, 0) = 0.3;
+        speeds(i, 1) = -1.1;
+    }
 
+    const auto serial = computeGeometryPathsBatch(
+            model, pathPaths, coordPaths, values, speeds, false, 1);
+    const auto parallel = computeGeometryPathsBatch(
+            model, pathPaths, coordPaths, values, speeds, false, 4);
+    SimTK_TEST_EQ(serial.lengths, parallel.lengths);
+    SimTK_TEST_EQ(serial.speeds, parallel.speeds);
+    SimTK_TEST(parallel.momentArms.size() == coordPaths.size());
+
+    SimTK::State state = model.initSystem();
+    for (int i = 0; i < numSamples; ++i) {
+        for (int icoord = 0; icoord < 2; ++icoord) {
+            const auto& coord = model.getComponent<Coordinate>(
+                    coordPaths[icoord]);
+            coord.setValue(state, values(i, icoord), false);
+            coord.setSpeedValue(state, speeds(i, icoord));
+        }
+        model.realizeVelocity(state);
+        for (int ipath = 0; ipath < (int)pathPaths.size(); ++ipath) {
+            const auto& path =
+                    model.getComponent<GeometryPath>(pathPaths[ipath]);
+            SimTK_TEST_EQ(parallel.lengths(i, ipath), path.getLength(state));
+            SimTK_TEST_EQ(parallel.speeds(i, ipath),
+                    path.getLengtheningSpeed(state));
+            for (int icoord = 0; icoord < 2; ++icoord) {
+                SimTK_TEST_EQ(parallel.momentArms[icoord](i, ipath),
+                        path.computeMomentArm(state,
+                                model.getComponent<Coordinate>(
+                                        coordPaths[icoord])));
+            }
+        }
+    }
 
+    // Speeds are optional.
+    const auto noSpeeds = computeGeometryPathsBatch(
+            model, pathPaths, coordPaths, values);
+    SimTK_TEST(noSpeeds.speeds.nrow() == 0);
+    SimTK_TEST_EQ(noSpeeds.lengths, serial.lengths);
 
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
+    SimTK_TEST_MUST_THROW_EXC(computeGeometryPathsBatch(model,
+            {"/forceset/TRIlong"}, coordPaths, values), Exception);
+    SimTK_TEST_MUST_THROW_EXC(computeGeometryPathsBatch(model, pathPaths,
+            {"/jointset/r_elbow/r_elbow_flex"}, values), Exception);
+}
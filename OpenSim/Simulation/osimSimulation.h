@@ -53,8 +53,10 @@
 #include "Model/ConditionalPathPoint.h"
 #include "Model/MovingPathPoint.h"
 #include "Model/GeometryPath.h"
+#include "Model/FunctionBasedPath.h"
 #include "Model/PrescribedForce.h"
 #include "Model/PointToPointSpring.h"
+#include "Model/ExpressionEvaluator.h"
 #include "Model/ExpressionBasedPointToPointForce.h"
 #include "Model/ExpressionBasedCoordinateForce.h"
 #include "Model/PathSpring.h"
@@ -128,6 +130,7 @@
 #include "OpenSense/OpenSenseUtilities.h"
 #include "OpenSense/IMU.h"
 #include "SimulationUtilities.h"
+#include "PolynomialPathFitter.h"
 
 #include "RegisterTypes_osimSimulation.h"   // to expose RegisterTypes_osimSimulation
 
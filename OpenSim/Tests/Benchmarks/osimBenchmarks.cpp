@@ -0,0 +1,584 @@
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  osimBenchmarks.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* Performance benchmarks for OpenSim. This executable is not a test; it times
+ * commonly-used (and commonly slow) operations so that performance can be
+ * tracked across releases. Run it from the directory containing the benchmark
+ * data files (the build directory of this CMake project):
+ *
+ *     osimBenchmarks [--filter <substring>] [--min-time <seconds>]
+ *                    [--json <file>] [--list]
+ *
+ * Each benchmark is run repeatedly until at least --min-time seconds have
+ * elapsed (and at least once). The results are printed to the console and,
+ * if --json is provided, written to a JSON file whose layout resembles that
+ * of Google Benchmark, so that existing tooling can compare runs. Some
+ * benchmarks also report counters, such as the number of solver iterations,
+ * which are printed after the time and written as fields of the benchmark in
+ * the JSON file. */
+
+#include <OpenSim/Actuators/ModelFactory.h>
+#include <OpenSim/Common/Stopwatch.h>
+#include <OpenSim/Moco/osimMoco.h>
+#include <OpenSim/OpenSim.h>
+
+#include <algorithm>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace OpenSim;
+
+namespace {
+
+/// Timing statistics for a single benchmark, in seconds, and the counters
+/// the benchmark set (see setCounter()) in its last run.
+struct BenchmarkResult {
+    std::string name;
+    std::vector<double> times;
+    std::map<std::string, double> counters;
+    double min() const { return *std::min_element(times.begin(), times.end()); }
+    double max() const { return *std::max_element(times.begin(), times.end()); }
+    double mean() const {
+        return std::accumulate(times.begin(), times.end(), 0.0) /
+               (double)times.size();
+    }
+    double median() const {
+        std::vector<double> sorted(times);
+        std::sort(sorted.begin(), sorted.end());
+        const auto n = sorted.size();
+        return n % 2 ? sorted[n / 2] : 0.5 * (sorted[n / 2 - 1] + sorted[n / 2]);
+    }
+};
+
+/// A benchmark consists of an untimed setup function that returns the
+/// function to time. This allows expensive preparation (loading a model,
+/// initializing the system) to be excluded from the measurement.
+struct Benchmark {
+    std::string name;
+    std::function<std::function<void()>()> setup;
+};
+
+std::vector<Benchmark>& getRegistry() {
+    static std::vector<Benchmark> registry;
+    return registry;
+}
+
+void addBenchmark(std::string name,
+        std::function<std::function<void()>()> setup) {
+    getRegistry().push_back({std::move(name), std::move(setup)});
+}
+
+std::map<std::string, double>& getCounters() {
+    static std::map<std::string, double> counters;
+    return counters;
+}
+
+/// Report a quantity other than time (e.g., a number of solver iterations)
+/// from the function being timed.
+void setCounter(const std::string& name, double value) {
+    getCounters()[name] = value;
+}
+
+BenchmarkResult runBenchmark(const Benchmark& benchmark, double minTime) {
+    BenchmarkResult result;
+    result.name = benchmark.name;
+    const auto func = benchmark.setup();
+    getCounters().clear();
+    Stopwatch total;
+    do {
+        Stopwatch watch;
+        func();
+        result.times.push_back(SimTK::nsToSec(watch.getElapsedTimeInNs()));
+    } while (total.getElapsedTime() < minTime);
+    result.counters = getCounters();
+    return result;
+}
+
+std::string escapeJSON(const std::string& in) {
+    std::string out;
+    for (const char c : in) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+void writeJSON(const std::string& fileName,
+        const std::vector<BenchmarkResult>& results) {
+    std::ofstream stream(fileName);
+    OPENSIM_THROW_IF(!stream.good(), Exception,
+            "Could not open file '{}' for writing.", fileName);
+
+    char date[64];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S",
+            std::localtime(&now));
+
+    stream << std::setprecision(17);
+    stream << "{\n";
+    stream << "  \"context\": {\n";
+    stream << "    \"date\": \"" << date << "\",\n";
+    stream << "    \"opensim_version\": \"" << escapeJSON(GetVersionAndDate())
+           << "\",\n";
+    stream << "    \"num_cpus\": " << std::thread::hardware_concurrency()
+           << "\n";
+    stream << "  },\n";
+    stream << "  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        stream << "    {\n";
+        stream << "      \"name\": \"" << escapeJSON(r.name) << "\",\n";
+        stream << "      \"iterations\": " << r.times.size() << ",\n";
+        stream << "      \"real_time\": " << r.mean() << ",\n";
+        stream << "      \"real_time_min\": " << r.min() << ",\n";
+        stream << "      \"real_time_median\": " << r.median() << ",\n";
+        stream << "      \"real_time_max\": " << r.max() << ",\n";
+        for (const auto& counter : r.counters) {
+            stream << "      \"" << escapeJSON(counter.first)
+                   << "\": " << counter.second << ",\n";
+        }
+        stream << "      \"time_unit\": \"s\"\n";
+        stream << "    }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    stream << "  ]\n";
+    stream << "}\n";
+}
+
+// Benchmarks.
+// -----------
+// Models used by the benchmarks, from smallest to largest.
+const std::vector<std::string> modelFiles = {"arm26.osim",
+        "gait10dof18musc_subject01.osim", "gait2392_pelvisFixed.osim",
+        "model_Rajagopal2015_posed.osim"};
+
+void registerModelBenchmarks() {
+    for (const auto& modelFile : modelFiles) {
+        addBenchmark("Model deserialization/" + modelFile, [modelFile]() {
+            return [modelFile]() { Model model(modelFile); };
+        });
+
+        addBenchmark("Model::initSystem/" + modelFile, [modelFile]() {
+            auto model = std::make_shared<Model>(modelFile);
+            return [model]() { model->initSystem(); };
+        });
+
+        addBenchmark("realizeDynamics/" + modelFile, [modelFile]() {
+            auto model = std::make_shared<Model>(modelFile);
+            auto state = std::make_shared<SimTK::State>(model->initSystem());
+            model->equilibrateMuscles(*state);
+            return [model, state]() {
+                for (int i = 0; i < 100; ++i) {
+                    state->invalidateAllCacheAtOrAbove(SimTK::Stage::Time);
+                    model->realizeDynamics(*state);
+                }
+            };
+        });
+
+        addBenchmark("GeometryPath::computePath/" + modelFile, [modelFile]() {
+            auto model = std::make_shared<Model>(modelFile);
+            auto state = std::make_shared<SimTK::State>(model->initSystem());
+            return [model, state]() {
+                // Sweep every coordinate through its range so that wrapping
+                // is active for at least some of the samples.
+                const int numSamples = 10;
+                for (const auto& coord :
+                        model->getComponentList<Coordinate>()) {
+                    if (coord.isConstrained(*state)) continue;
+                    const double defaultValue = coord.getValue(*state);
+                    const double lower = std::max(coord.getRangeMin(), -1.5);
+                    const double upper = std::min(coord.getRangeMax(), 1.5);
+                    for (int i = 0; i < numSamples; ++i) {
+                        coord.setValue(*state,
+                                lower + (upper - lower) * i / (numSamples - 1),
+                                false);
+                        model->realizePosition(*state);
+                        for (const auto& path :
+                                model->getComponentList<GeometryPath>()) {
+                            path.getLength(*state);
+                        }
+                    }
+                    coord.setValue(*state, defaultValue, false);
+                }
+            };
+        });
+    }
+
+    addBenchmark("computeGeometryPathsBatch/arm26.osim", []() {
+        auto model = std::make_shared<Model>("arm26.osim");
+        model->initSystem();
+        std::vector<std::string> pathPaths;
+        for (const auto& path : model->getComponentList<GeometryPath>()) {
+            pathPaths.push_back(path.getAbsolutePathString());
+        }
+        const std::vector<std::string> coordPaths = {
+                "/jointset/r_shoulder/r_shoulder_elev",
+                "/jointset/r_elbow/r_elbow_flex"};
+        const int numSamples = 2000;
+        auto values = std::make_shared<SimTK::Matrix>(numSamples, 2);
+        for (int i = 0; i < numSamples; ++i) {
+            (*values)(i, 0) = -0.5 + 1.5 * (i % 40) / 39.0;
+            (*values)(i, 1) = 2.0 * (i / 40) / 49.0;
+        }
+        return [model, pathPaths, coordPaths, values]() {
+            computeGeometryPathsBatch(*model, pathPaths, coordPaths, *values);
+        };
+    });
+
+    const std::vector<std::pair<std::string, Manager::IntegratorMethod>>
+            integrators = {
+                    {"ExplicitEuler", Manager::IntegratorMethod::ExplicitEuler},
+                    {"RungeKutta2", Manager::IntegratorMethod::RungeKutta2},
+                    {"RungeKutta3", Manager::IntegratorMethod::RungeKutta3},
+                    {"RungeKuttaFeldberg",
+                            Manager::IntegratorMethod::RungeKuttaFeldberg},
+                    {"RungeKuttaMerson",
+                            Manager::IntegratorMethod::RungeKuttaMerson},
+                    {"SemiExplicitEuler2",
+                            Manager::IntegratorMethod::SemiExplicitEuler2},
+                    {"Verlet", Manager::IntegratorMethod::Verlet}};
+    for (const auto& integrator : integrators) {
+        const auto method = integrator.second;
+        addBenchmark("Manager::integrate/" + integrator.first + "/arm26.osim",
+                [method]() {
+                    auto model = std::make_shared<Model>("arm26.osim");
+                    model->initSystem();
+                    return [model, method]() {
+                        SimTK::State state = model->initializeState();
+                        model->equilibrateMuscles(state);
+                        Manager manager(*model);
+                        manager.setIntegratorMethod(method);
+                        manager.setIntegratorAccuracy(1e-4);
+                        manager.setIntegratorMinimumStepSize(1e-8);
+                        manager.setWriteToStorage(false);
+                        manager.initialize(state);
+                        manager.integrate(0.25);
+                    };
+                });
+    }
+}
+
+void registerMuscleCurveBenchmarks() {
+    for (const double tolerance : {0.0, 1e-8}) {
+        const std::string suffix =
+                tolerance == 0 ? "/exact" : "/tabulated";
+        addBenchmark("ActiveForceLengthCurve" + suffix, [tolerance]() {
+            auto curve = std::make_shared<ActiveForceLengthCurve>();
+            if (tolerance > 0) {
+                curve->set_tabulation_tolerance(tolerance);
+                curve->ensureCurveUpToDate();
+            }
+            return [curve]() {
+                double sum = 0;
+                for (int i = 0; i < 100000; ++i) {
+                    const double x = 0.4 + 1.4 * i / 100000.0;
+                    sum += curve->calcValue(x) + curve->calcDerivative(x, 1);
+                }
+                if (SimTK::isNaN(sum)) std::cout << "NaN" << std::endl;
+            };
+        });
+    }
+}
+
+void registerToolBenchmarks() {
+    addBenchmark("InverseKinematicsTool/subject01", []() {
+        return []() {
+            InverseKinematicsTool ik("subject01_Setup_InverseKinematics.xml");
+            ik.setResultsDir("benchmark_results");
+            ik.run();
+        };
+    });
+
+    addBenchmark("InverseKinematicsTool/subject01/4threads", []() {
+        return []() {
+            InverseKinematicsTool ik("subject01_Setup_InverseKinematics.xml");
+            ik.setResultsDir("benchmark_results");
+            ik.setNumThreads(4);
+            ik.run();
+        };
+    });
+
+    addBenchmark("InverseDynamicsTool/subject01", []() {
+        return []() {
+            InverseDynamicsTool id("subject01_Setup_InverseDynamics.xml");
+            id.setResultsDir("benchmark_results");
+            id.run();
+        };
+    });
+
+    // Replay harness for streaming IMU inverse kinematics: one second of
+    // synthetic orientations at 400 Hz for 20 IMUs (every body of the
+    // full-body model except the patellae). The setup replays the data in
+    // real time, and the latency percentiles (in seconds) of that replay are
+    // reported as counters; the stream is kept up with if no frame exceeds
+    // the 2.5 ms sampling period (late_frames is 0). The timed function
+    // replays the data as fast as possible, so it must take less than 1 s.
+    addBenchmark("StreamingIMUInverseKinematics/Rajagopal2015/20IMUs/400Hz",
+            []() {
+        Model model("model_Rajagopal2015_posed.osim");
+        SimTK::State state = model.initSystem();
+        std::vector<const Body*> bodies;
+        for (const auto& body : model.getComponentList<Body>()) {
+            if (body.getName().find("patella") == std::string::npos) {
+                bodies.push_back(&body);
+            }
+        }
+        std::vector<std::string> labels;
+        for (const auto* body : bodies) labels.push_back(body->getName());
+
+        // Swing each rotational coordinate about its default value.
+        const double rate = 400;
+        const int numFrames = 400;
+        auto orientations =
+                std::make_shared<TimeSeriesTable_<SimTK::Rotation>>();
+        orientations->setColumnLabels(labels);
+        auto& coordSet = model.updCoordinateSet();
+        SimTK::RowVector_<SimTK::Rotation> row((int)bodies.size());
+        for (int i = 0; i < numFrames; ++i) {
+            const double time = i / rate;
+            for (int j = 0; j < coordSet.getSize(); ++j) {
+                auto& coord = coordSet[j];
+                if (coord.getMotionType() != Coordinate::Rotational ||
+                        coord.isConstrained(state)) {
+                    continue;
+                }
+                coord.setValue(state, coord.getDefaultValue() +
+                        0.2 * std::sin(2 * SimTK::Pi * time + j), false);
+            }
+            model.realizePosition(state);
+            for (int j = 0; j < (int)bodies.size(); ++j) {
+                row[j] = bodies[j]->getTransformInGround(state).R();
+            }
+            orientations->appendRow(time, row);
+        }
+
+        auto streamingIK = std::make_shared<StreamingIMUInverseKinematics>(
+                Model("model_Rajagopal2015_posed.osim"));
+        streamingIK->setLatencyBudget(1 / rate);
+        TableOrientationsSource realTime(*orientations, true);
+        TableCoordinatesSink sink;
+        const auto stats = streamingIK->run(realTime, sink);
+
+        return [streamingIK, orientations, stats]() {
+            TableOrientationsSource source(*orientations);
+            TableCoordinatesSink sink;
+            streamingIK->run(source, sink);
+            setCounter("latency_median", stats.medianLatency);
+            setCounter("latency_p90", stats.p90Latency);
+            setCounter("latency_p99", stats.p99Latency);
+            setCounter("latency_max", stats.maxLatency);
+            setCounter("late_frames", stats.numLateFrames);
+        };
+    });
+}
+
+void registerFileBenchmarks() {
+    // A table the size of a few minutes of high-rate sensor data.
+    const std::string stoFile = "benchmark_20000x50.sto";
+    auto writeTable = [stoFile]() {
+        std::vector<std::string> labels;
+        for (int i = 0; i < 50; ++i) {
+            labels.push_back("col" + std::to_string(i));
+        }
+        std::vector<double> times(20000);
+        for (int i = 0; i < (int)times.size(); ++i) times[i] = 0.001 * i;
+        TimeSeriesTable table(times,
+                SimTK::Test::randMatrix((int)times.size(), 50), labels);
+        STOFileAdapter::write(table, stoFile);
+    };
+
+    addBenchmark("STOFileAdapter::read/20000x50", [stoFile, writeTable]() {
+        writeTable();
+        return [stoFile]() { TimeSeriesTable table(stoFile); };
+    });
+
+    for (bool mapped : {false, true}) {
+        addBenchmark(std::string("DelimFileStreamReader/") +
+                             (mapped ? "mapped/" : "buffered/") + "20000x50",
+                [stoFile, writeTable, mapped]() {
+                    writeTable();
+                    return [stoFile, mapped]() {
+                        DelimFileStreamReader reader(stoFile, 1024, mapped);
+                        double sum = 0;
+                        reader.forEachBlock(
+                                [&sum](const DelimFileStreamReader::Block& b) {
+                                    sum += b.values(0, 0);
+                                });
+                        if (SimTK::isNaN(sum)) std::cout << sum;
+                    };
+                });
+    }
+
+    const std::string stbFile = "benchmark_20000x50.stb";
+    addBenchmark("STBFileAdapter::write/20000x50", [stoFile, writeTable]() {
+        writeTable();
+        auto table = std::make_shared<TimeSeriesTable>(stoFile);
+        return [table]() {
+            STBFileAdapter::write(*table, "benchmark_20000x50_write.stb");
+        };
+    });
+    addBenchmark("STBFileAdapter::read/20000x50",
+            [stoFile, stbFile, writeTable]() {
+                writeTable();
+                STBFileAdapter::write(TimeSeriesTable(stoFile), stbFile);
+                return [stbFile]() { TimeSeriesTable table(stbFile); };
+            });
+    addBenchmark("STBFileView/20000x50", [stoFile, stbFile, writeTable]() {
+        writeTable();
+        STBFileAdapter::write(TimeSeriesTable(stoFile), stbFile);
+        return [stbFile]() {
+            STBFileView view(stbFile);
+            const double sum = view.getDependentColumn("col0").sum();
+            if (SimTK::isNaN(sum)) std::cout << sum;
+        };
+    });
+}
+
+void registerMocoBenchmarks() {
+    if (!MocoCasADiSolver::isAvailable()) return;
+
+    // Create a reference trajectory for the pendulum to track.
+    auto reference = std::make_shared<TimeSeriesTable>();
+    reference->setColumnLabels({"/jointset/j0/q0/value",
+            "/jointset/j1/q1/value"});
+    const int numRows = 21;
+    for (int i = 0; i < numRows; ++i) {
+        const double time = 1.0 * i / (numRows - 1);
+        SimTK::RowVector row(2);
+        row[0] = 0.5 * std::sin(SimTK::Pi * time);
+        row[1] = -0.5 * std::sin(SimTK::Pi * time);
+        reference->appendRow(time, row);
+    }
+    const auto createStudy = [reference]() {
+        MocoTrack track;
+        track.setName("benchmark_double_pendulum");
+        track.setModel(ModelProcessor(ModelFactory::createDoublePendulum()));
+        track.setStatesReference(TableProcessor(*reference));
+        track.set_allow_unused_references(true);
+        track.set_initial_time(0);
+        track.set_final_time(1);
+        track.set_mesh_interval(0.05);
+        MocoStudy study = track.initialize();
+        auto& solver = study.updSolver<MocoCasADiSolver>();
+        solver.set_verbosity(0);
+        solver.set_optim_ipopt_print_level(0);
+        return study;
+    };
+
+    addBenchmark("MocoTrack/double_pendulum", [createStudy]() {
+        return [createStudy]() { createStudy().solve(); };
+    });
+
+    // The exact Hessian (from differencing the colored Jacobian) takes fewer
+    // iterations than the quasi-Newton approximation, but each iteration is
+    // more expensive.
+    for (const std::string hessian : {"exact", "limited-memory"}) {
+        addBenchmark("MocoTrack/double_pendulum/hessian_" + hessian,
+                [createStudy, hessian]() {
+                    return [createStudy, hessian]() {
+                        MocoStudy study = createStudy();
+                        auto& solver = study.updSolver<MocoCasADiSolver>();
+                        solver.set_optim_sparsity_detection("random");
+                        solver.set_optim_hessian_approximation(hessian);
+                        const MocoSolution solution = study.solve();
+                        setCounter("solver_iterations",
+                                solution.getNumIterations());
+                        setCounter("solver_duration",
+                                solution.getSolverDuration());
+                    };
+                });
+    }
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    std::string filter;
+    std::string jsonFile;
+    double minTime = 1.0;
+    bool list = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--filter" && hasValue) {
+            filter = argv[++i];
+        } else if (arg == "--json" && hasValue) {
+            jsonFile = argv[++i];
+        } else if (arg == "--min-time" && hasValue) {
+            minTime = std::stod(argv[++i]);
+        } else if (arg == "--list") {
+            list = true;
+        } else {
+            std::cout << "Usage: osimBenchmarks [--filter <substring>] "
+                         "[--min-time <seconds>] [--json <file>] [--list]"
+                      << std::endl;
+            return arg == "--help" || arg == "-h" ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    // Only show warnings and errors, so that the console output is mostly the
+    // benchmark results.
+    Logger::setLevel(Logger::Level::Warn);
+
+    registerModelBenchmarks();
+    registerMuscleCurveBenchmarks();
+    registerToolBenchmarks();
+    registerFileBenchmarks();
+    registerMocoBenchmarks();
+
+    std::vector<BenchmarkResult> results;
+    for (const auto& benchmark : getRegistry()) {
+        if (benchmark.name.find(filter) == std::string::npos) continue;
+        if (list) {
+            std::cout << benchmark.name << std::endl;
+            continue;
+        }
+        try {
+            results.push_back(runBenchmark(benchmark, minTime));
+            const auto& r = results.back();
+            std::cout << std::left << std::setw(64) << r.name << std::right
+                      << std::setw(8) << r.times.size() << " iter(s)"
+                      << std::setw(14) << Stopwatch::formatNs(
+                                 (long long)(1e9 * r.median()))
+                      << " (median)";
+            for (const auto& counter : r.counters) {
+                std::cout << "  " << counter.first << "=" << counter.second;
+            }
+            std::cout << std::endl;
+        } catch (const std::exception& e) {
+            std::cerr << benchmark.name << " failed: " << e.what()
+                      << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (!jsonFile.empty()) writeJSON(jsonFile, results);
+
+    return EXIT_SUCCESS;
+}
@@ -30,6 +30,7 @@
 #include "IKTaskSet.h"
 
 #include <OpenSim/Analyses/Kinematics.h>
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/Constant.h>
 #include <OpenSim/Common/FunctionSet.h>
 #include <OpenSim/Common/GCVSplineSet.h>
@@ -40,10 +41,84 @@
 #include <OpenSim/Simulation/InverseKinematicsSolver.h>
 #include <OpenSim/Simulation/Model/Model.h>
 
+#include <algorithm>
+#include <mutex>
+#include <thread>
+
 using namespace OpenSim;
 using namespace std;
 using namespace SimTK;
 
+namespace {
+// The solution for each frame, when frames are solved in parallel.
+struct IKFrameSolutions {
+    std::vector<SimTK::Vector> q;
+    std::vector<SimTK::Array_<double>> squaredMarkerErrors;
+    std::vector<SimTK::Array_<Vec3>> markerLocations;
+};
+
+// Split the frames [startIndex, startIndex + numFrames) into contiguous chunks
+// and solve each chunk on its own thread, with its own copy of the model,
+// references, and solver. Each chunk starts with a full assembly at its
+// first frame and then tracks the remaining frames of the chunk, as the
+// sequential solver does for the whole time range.
+IKFrameSolutions solveFramesInParallel(const Model& model,
+        const MarkersReference& markersReference,
+        const SimTK::Array_<CoordinateReference>& coordinateReferences,
+        double constraintWeight, double accuracy,
+        const std::vector<double>& times, int startIndex, int numFrames,
+        int numThreads, bool reportErrors, bool reportMarkerLocations) {
+    IKFrameSolutions solutions;
+    solutions.q.resize(numFrames);
+    if (reportErrors) solutions.squaredMarkerErrors.resize(numFrames);
+    if (reportMarkerLocations) solutions.markerLocations.resize(numFrames);
+
+    // Copying the model and references reads shared objects, so copies are
+    // made one at a time. Each thread writes only its own frames.
+    std::mutex copyMutex;
+    parallelForChunks(numFrames, numThreads,
+            [&](int /*threadIndex*/, int begin, int end) {
+                std::unique_ptr<Model> localModel;
+                std::shared_ptr<MarkersReference> localMarkersReference;
+                SimTK::Array_<CoordinateReference> localCoordinateReferences;
+                {
+                    std::lock_guard<std::mutex> lock(copyMutex);
+                    localModel.reset(model.clone());
+                    localMarkersReference =
+                            std::make_shared<MarkersReference>(
+                                    markersReference);
+                    localCoordinateReferences = coordinateReferences;
+                }
+                // The copy's analyses (including the tool's reporter) are
+                // stepped by the calling thread, not by the chunk solvers.
+                localModel->updAnalysisSet().clearAndDestroy();
+                SimTK::State& s = localModel->initSystem();
+
+                InverseKinematicsSolver ikSolver(*localModel,
+                        localMarkersReference, localCoordinateReferences,
+                        constraintWeight);
+                ikSolver.setAccuracy(accuracy);
+                s.updTime() = times[startIndex + begin];
+                ikSolver.assemble(s);
+
+                for (int k = begin; k < end; ++k) {
+                    s.updTime() = times[startIndex + k];
+                    ikSolver.track(s);
+                    solutions.q[k] = s.getQ();
+                    if (reportErrors) {
+                        ikSolver.computeCurrentSquaredMarkerErrors(
+                                solutions.squaredMarkerErrors[k]);
+                    }
+                    if (reportMarkerLocations) {
+                        ikSolver.computeCurrentMarkerLocations(
+                                solutions.markerLocations[k]);
+                    }
+                }
+            });
+    return solutions;
+}
+} // anonymous namespace
+
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
 //=============================================================================
@@ -86,6 +161,7 @@ void InverseKinematicsTool::constructProperties()
     constructProperty_marker_file("");
     constructProperty_coordinate_file("");
     constructProperty_report_marker_locations(false);
+    constructProperty_num_threads(1);
 }
 
 //=============================================================================
@@ -190,19 +266,45 @@ bool InverseKinematicsTool::run()
 
         Stopwatch watch;
 
+        // With multiple threads, all frames are solved up front and the
+        // solutions are reported below in order, as if solved sequentially.
+        const int numThreads = get_num_threads() < 1
+                ? (int)std::thread::hardware_concurrency()
+                : get_num_threads();
+        const bool solveInParallel = numThreads > 1 && Nframes > 1;
+        IKFrameSolutions solutions;
+        if (solveInParallel) {
+            log_info("Solving {} frames in parallel with {} threads.",
+                    Nframes, std::min(numThreads, Nframes));
+            solutions = solveFramesInParallel(*_model, markersReference,
+                    coordinateReferences, get_constraint_weight(),
+                    get_accuracy(), times, start_ix, Nframes, numThreads,
+                    get_report_errors(), get_report_marker_locations());
+        }
+
         for (int i = start_ix; i <= final_ix; ++i) {
             s.updTime() = times[i];
-            ikSolver.track(s);
-            // show progress line every 1000 frames so users see progress
-            if (std::remainder(i - start_ix, 1000) == 0 && i != start_ix)
-                log_info("Solved {} frame(s)...", i - start_ix);
+            if (solveInParallel) {
+                s.updQ() = solutions.q[i - start_ix];
+                _model->realizePosition(s);
+            } else {
+                ikSolver.track(s);
+                // show progress line every 1000 frames so users see progress
+                if (std::remainder(i - start_ix, 1000) == 0 && i != start_ix)
+                    log_info("Solved {} frame(s)...", i - start_ix);
+            }
             if(get_report_errors()){
                 Array<double> markerErrors(0.0, 3);
                 double totalSquaredMarkerError = 0.0;
                 double maxSquaredMarkerError = 0.0;
                 int worst = -1;
 
-                ikSolver.computeCurrentSquaredMarkerErrors(squaredMarkerErrors);
+                if (solveInParallel)
+                    squaredMarkerErrors =
+                            solutions.squaredMarkerErrors[i - start_ix];
+                else
+                    ikSolver.computeCurrentSquaredMarkerErrors(
+                            squaredMarkerErrors);
                 for(int j=0; j<nm; ++j){
                     totalSquaredMarkerError += squaredMarkerErrors[j];
                     if(squaredMarkerErrors[j] > maxSquaredMarkerError){
@@ -225,7 +327,10 @@ bool InverseKinematicsTool::run()
             }
 
             if(get_report_marker_locations()){
-                ikSolver.computeCurrentMarkerLocations(markerLocations);
+                if (solveInParallel)
+                    markerLocations = solutions.markerLocations[i - start_ix];
+                else
+                    ikSolver.computeCurrentMarkerLocations(markerLocations);
                 Array<double> locations(0.0, 3*nm);
                 for(int j=0; j<nm; ++j){
                     for(int k=0; k<3; ++k)
@@ -71,6 +71,14 @@ public:
             "Flag indicating whether or not to report model marker locations. "
             "Note, model marker locations are expressed in Ground.");
 
+    OpenSim_DECLARE_PROPERTY(num_threads, int,
+            "The number of threads used to solve the frames. With more than one "
+            "thread, the time range is split into contiguous chunks that are "
+            "solved independently, each with its own copy of the model and "
+            "starting with a full assembly at its first frame. A value less "
+            "than 1 uses all available hardware threads. Default is 1, which "
+            "solves the frames in sequence.");
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -102,6 +110,11 @@ public:
 
     IKTaskSet& getIKTaskSet() { return upd_IKTaskSet(); }
 
+    /** %Set the number of threads used to solve the frames (see the
+    num_threads property).                                                   */
+    void setNumThreads(int numThreads) { upd_num_threads() = numThreads; }
+    int getNumThreads() const { return get_num_threads(); }
+
     //--------------------------------------------------------------------------
     // INTERFACE
     //--------------------------------------------------------------------------
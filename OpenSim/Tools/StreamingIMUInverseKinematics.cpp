@@ -0,0 +1,196 @@
+/* -------------------------------------------------------------------------- *
+ *                OpenSim:  StreamingIMUInverseKinematics.cpp                 *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "StreamingIMUInverseKinematics.h"
+
+#include <OpenSim/Simulation/BufferedOrientationsReference.h>
+#include <OpenSim/Simulation/InverseKinematicsSolver.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <thread>
+
+using namespace OpenSim;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+double toSeconds(Clock::duration duration) {
+    return std::chrono::duration<double>(duration).count();
+}
+
+/// The value below which the given fraction of the sorted values fall.
+double percentile(const std::vector<double>& sorted, double fraction) {
+    const size_t index = (size_t)std::ceil(fraction * sorted.size());
+    return sorted[std::min(std::max(index, (size_t)1), sorted.size()) - 1];
+}
+} // anonymous namespace
+
+TableOrientationsSource::TableOrientationsSource(
+        TimeSeriesTable_<SimTK::Rotation> table, bool realTime, double speed)
+        : m_table(std::move(table)), m_realTime(realTime), m_speed(speed) {
+    OPENSIM_THROW_IF(speed <= 0, Exception,
+            "Expected speed to be positive, but it is {}.", speed);
+}
+
+bool TableOrientationsSource::getNextSample(double& time,
+        SimTK::RowVector_<SimTK::Rotation>& orientations,
+        Clock::time_point& arrivalTime) {
+    if (m_nextRow >= m_table.getNumRows()) return false;
+    const auto& times = m_table.getIndependentColumn();
+    if (m_nextRow == 0) m_start = Clock::now();
+    time = times[m_nextRow];
+    orientations = m_table.getRowAtIndex(m_nextRow);
+    ++m_nextRow;
+    if (!m_realTime) {
+        arrivalTime = Clock::now();
+        return true;
+    }
+    // If the consumer is behind, the sample arrived in the past, and the
+    // time it spent waiting counts toward the consumer's latency.
+    arrivalTime = m_start + std::chrono::duration_cast<Clock::duration>(
+                                    std::chrono::duration<double>(
+                                            (time - times.front()) / m_speed));
+    std::this_thread::sleep_until(arrivalTime);
+    return true;
+}
+
+StreamingIMUInverseKinematics::StreamingIMUInverseKinematics(
+        const Model& model)
+        : m_model(model) {
+    m_model.finalizeFromProperties();
+    // As in IMUInverseKinematicsTool, orientations cannot determine
+    // translations.
+    for (auto& coord : m_model.updComponentList<Coordinate>()) {
+        if (coord.getMotionType() == Coordinate::Translational) {
+            coord.setDefaultLocked(true);
+        }
+    }
+}
+
+void StreamingIMUInverseKinematics::setSensorToOpenSimRotations(
+        const SimTK::Vec3& rotations) {
+    m_sensorToOpenSim = SimTK::Rotation(
+            SimTK::BodyOrSpaceType::SpaceRotationSequence,
+            rotations[0], SimTK::XAxis, rotations[1], SimTK::YAxis,
+            rotations[2], SimTK::ZAxis);
+}
+
+StreamingIMUInverseKinematics::Statistics StreamingIMUInverseKinematics::run(
+        OrientationsSource& source, CoordinatesSink& sink, int maxFrames) {
+    m_stopRequested = false;
+    Statistics stats;
+
+    double time;
+    SimTK::RowVector_<SimTK::Rotation> orientations;
+    Clock::time_point arrivalTime;
+    if (maxFrames == 0 ||
+            !source.getNextSample(time, orientations, arrivalTime)) {
+        return stats;
+    }
+    const std::vector<std::string> frameNames = source.getFrameNames();
+    OPENSIM_THROW_IF(orientations.size() != (int)frameNames.size(), Exception,
+            "Expected samples with {} orientations, but got {}.",
+            frameNames.size(), orientations.size());
+    const auto toOpenSim = [this](SimTK::RowVector_<SimTK::Rotation>& row) {
+        for (int i = 0; i < row.size(); ++i) {
+            row[i] = m_sensorToOpenSim * row[i];
+        }
+    };
+    toOpenSim(orientations);
+
+    // The reference starts with the first sample, from which the solver is
+    // assembled; subsequent samples are queued and consumed by track().
+    TimeSeriesTable_<SimTK::Rotation> firstSample;
+    firstSample.setColumnLabels(frameNames);
+    firstSample.appendRow(time, orientations);
+    auto oRefs = std::make_shared<BufferedOrientationsReference>(
+            firstSample, m_weights.getSize() ? &m_weights : nullptr);
+
+    SimTK::State& state = m_model.initSystem();
+    SimTK::Array_<CoordinateReference> coordinateReferences;
+    InverseKinematicsSolver ikSolver(
+            m_model, nullptr, oRefs, coordinateReferences);
+    ikSolver.setAccuracy(m_accuracy);
+    state.updTime() = time;
+
+    const auto& coordSet = m_model.getCoordinateSet();
+    std::vector<std::string> coordinateNames;
+    for (int i = 0; i < coordSet.getSize(); ++i) {
+        coordinateNames.push_back(coordSet[i].getName());
+    }
+    sink.initialize(coordinateNames);
+    SimTK::RowVector values(coordSet.getSize());
+
+    std::vector<double> latencies;
+    double totalSolveTime = 0;
+    bool first = true;
+    do {
+        const auto solveStart = Clock::now();
+        if (first) {
+            ikSolver.assemble(state);
+            // From now on, track() takes the time and orientations of each
+            // frame from the queue.
+            ikSolver.setAdvanceTimeFromReference(true);
+            first = false;
+        } else {
+            toOpenSim(orientations);
+            oRefs->putValues(time, orientations);
+            ikSolver.track(state);
+        }
+        totalSolveTime += toSeconds(Clock::now() - solveStart);
+
+        for (int i = 0; i < coordSet.getSize(); ++i) {
+            values[i] = coordSet[i].getValue(state);
+        }
+        sink.publish(state.getTime(), values);
+        latencies.push_back(toSeconds(Clock::now() - arrivalTime));
+
+        if (m_stopRequested ||
+                (maxFrames >= 0 && (int)latencies.size() >= maxFrames)) {
+            break;
+        }
+    } while (source.getNextSample(time, orientations, arrivalTime));
+    oRefs->setFinished(true);
+
+    stats.numFrames = (int)latencies.size();
+    stats.numLateFrames = (int)std::count_if(latencies.begin(),
+            latencies.end(),
+            [this](double latency) { return latency > m_latencyBudget; });
+    stats.meanLatency =
+            std::accumulate(latencies.begin(), latencies.end(), 0.0) /
+            stats.numFrames;
+    stats.meanSolveTime = totalSolveTime / stats.numFrames;
+    std::sort(latencies.begin(), latencies.end());
+    stats.medianLatency = percentile(latencies, 0.5);
+    stats.p90Latency = percentile(latencies, 0.9);
+    stats.p99Latency = percentile(latencies, 0.99);
+    stats.maxLatency = latencies.back();
+    log_info("StreamingIMUInverseKinematics: {} frames, latency median {} "
+             "ms, 99th percentile {} ms, max {} ms; {} frames exceeded the "
+             "budget.",
+            stats.numFrames, 1e3 * stats.medianLatency,
+            1e3 * stats.p99Latency, 1e3 * stats.maxLatency,
+            stats.numLateFrames);
+    return stats;
+}
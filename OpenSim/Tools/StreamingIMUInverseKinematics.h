@@ -0,0 +1,198 @@
+#ifndef OPENSIM_STREAMING_IMU_INVERSE_KINEMATICS_H_
+#define OPENSIM_STREAMING_IMU_INVERSE_KINEMATICS_H_
+/* -------------------------------------------------------------------------- *
+ *                 OpenSim:  StreamingIMUInverseKinematics.h                  *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimToolsDLL.h"
+#include <OpenSim/Common/TimeSeriesTable.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Tools/IMUInverseKinematicsTool.h>
+
+#include <atomic>
+#include <chrono>
+
+namespace OpenSim {
+
+/** A stream of orientation samples for StreamingIMUInverseKinematics (e.g.,
+from a network socket or a replayed file). Each sample contains the
+orientation, in ground, of each of the frames given by getFrameNames().     */
+class OSIMTOOLS_API OrientationsSource {
+public:
+    virtual ~OrientationsSource() = default;
+
+    /** The names of the model frames (e.g., "pelvis_imu") whose orientations
+    are provided, in the order of the orientations in each sample. */
+    virtual std::vector<std::string> getFrameNames() const = 0;
+
+    /** Wait for the next sample. Returns false if the stream has ended.
+    @param[out] time The time of the sample.
+    @param[out] orientations The orientation of each frame.
+    @param[out] arrivalTime When the sample became available; the latency of
+        a frame is measured from this time. */
+    virtual bool getNextSample(double& time,
+            SimTK::RowVector_<SimTK::Rotation>& orientations,
+            std::chrono::steady_clock::time_point& arrivalTime) = 0;
+};
+
+/** Replays a table of orientations as an OrientationsSource. In real time,
+each row becomes available at its time in the table (relative to the first
+call to getNextSample()), so a consumer that is too slow sees its latency
+grow, as it would with a live stream; otherwise, rows are available
+immediately. */
+class OSIMTOOLS_API TableOrientationsSource : public OrientationsSource {
+public:
+    /** @param table Orientations of the frames named by the column labels.
+    @param realTime Whether to make rows available at the rate of the data.
+    @param speed How much faster than real time to replay the data (only used
+        if realTime is true). */
+    TableOrientationsSource(TimeSeriesTable_<SimTK::Rotation> table,
+            bool realTime = false, double speed = 1.0);
+
+    std::vector<std::string> getFrameNames() const override {
+        return m_table.getColumnLabels();
+    }
+    bool getNextSample(double& time,
+            SimTK::RowVector_<SimTK::Rotation>& orientations,
+            std::chrono::steady_clock::time_point& arrivalTime) override;
+
+private:
+    TimeSeriesTable_<SimTK::Rotation> m_table;
+    bool m_realTime;
+    double m_speed;
+    size_t m_nextRow = 0;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+/** Receives the coordinate values solved by StreamingIMUInverseKinematics,
+one frame at a time. */
+class OSIMTOOLS_API CoordinatesSink {
+public:
+    virtual ~CoordinatesSink() = default;
+
+    /** Called before the first frame with the names of the coordinates, in
+    the order of the values passed to publish(). */
+    virtual void initialize(const std::vector<std::string>& coordinateNames) {}
+
+    /** Receive the coordinate values (in radians or meters) for a frame. */
+    virtual void publish(double time, const SimTK::RowVector& values) = 0;
+};
+
+/** A CoordinatesSink that records the coordinate values in a table. */
+class OSIMTOOLS_API TableCoordinatesSink : public CoordinatesSink {
+public:
+    void initialize(const std::vector<std::string>& coordinateNames) override {
+        m_table = TimeSeriesTable();
+        m_table.setColumnLabels(coordinateNames);
+    }
+    void publish(double time, const SimTK::RowVector& values) override {
+        m_table.appendRow(time, values);
+    }
+    const TimeSeriesTable& getTable() const { return m_table; }
+
+private:
+    TimeSeriesTable m_table;
+};
+
+/** Inverse kinematics from a live stream of IMU orientations. Whereas
+IMUInverseKinematicsTool reads the orientations from a file and writes the
+solution to a file, this reads each sample from an OrientationsSource as it
+arrives, solves for the model's pose with InverseKinematicsSolver::track()
+(starting from the solution of the previous frame), and publishes the
+coordinate values to a CoordinatesSink before reading the next sample. The
+samples are passed to the solver through a BufferedOrientationsReference.
+
+As in IMUInverseKinematicsTool, the orientations are rotated by the
+sensor-to-OpenSim rotation, and the model's translational coordinates are
+locked.
+
+run() returns the latency of the frames: the time from the arrival of a
+sample to the publication of its solution. To keep up with a stream, the
+latency must stay below the sampling period; frames whose latency exceeds the
+latency budget are counted as late.
+\code
+StreamingIMUInverseKinematics ik(model);
+ik.setSensorToOpenSimRotations(SimTK::Vec3(-SimTK::Pi / 2, 0, 0));
+ik.setLatencyBudget(1.0 / 400.0);
+TableOrientationsSource source(orientations, true);
+TableCoordinatesSink sink;
+auto stats = ik.run(source, sink);
+\endcode                                                                      */
+class OSIMTOOLS_API StreamingIMUInverseKinematics {
+public:
+    /// Latency statistics of the frames processed by run(), in seconds.
+    struct Statistics {
+        int numFrames = 0;
+        /// Frames whose latency exceeded the latency budget.
+        int numLateFrames = 0;
+        double meanLatency = 0;
+        double medianLatency = 0;
+        double p90Latency = 0;
+        double p99Latency = 0;
+        double maxLatency = 0;
+        /// Mean time spent in InverseKinematicsSolver::track().
+        double meanSolveTime = 0;
+    };
+
+    /** The model is copied. */
+    explicit StreamingIMUInverseKinematics(const Model& model);
+
+    /** Accuracy of the solver (default: 1e-4). */
+    void setAccuracy(double accuracy) { m_accuracy = accuracy; }
+    double getAccuracy() const { return m_accuracy; }
+
+    /** Space-fixed Euler angles (XYZ order) from the sensor space to OpenSim
+    (default: 0). */
+    void setSensorToOpenSimRotations(const SimTK::Vec3& rotations);
+
+    /** Weights of the orientations, by frame name. If not provided, all
+    orientations are tracked with weight 1. */
+    void setOrientationWeights(const OrientationWeightSet& weights) {
+        m_weights = weights;
+    }
+
+    /** Frames with a greater latency are counted as late (default:
+    infinity). */
+    void setLatencyBudget(double seconds) { m_latencyBudget = seconds; }
+    double getLatencyBudget() const { return m_latencyBudget; }
+
+    /** Process samples from the source until the stream ends, stop() is
+    called, or maxFrames frames have been processed (if maxFrames is not
+    -1). The solver is assembled from the first sample. */
+    Statistics run(OrientationsSource& source, CoordinatesSink& sink,
+            int maxFrames = -1);
+
+    /** Make run() return after the current frame. This may be called from
+    another thread. */
+    void stop() { m_stopRequested = true; }
+
+private:
+    Model m_model;
+    double m_accuracy = 1e-4;
+    SimTK::Rotation m_sensorToOpenSim;
+    OrientationWeightSet m_weights;
+    double m_latencyBudget = SimTK::Infinity;
+    std::atomic<bool> m_stopRequested{false};
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_STREAMING_IMU_INVERSE_KINEMATICS_H_
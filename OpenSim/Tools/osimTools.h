@@ -31,6 +31,7 @@
 
 #include "InverseKinematicsTool.h"
 #include "InverseDynamicsTool.h"
+#include "StreamingIMUInverseKinematics.h"
 #include "GenericModelMaker.h"
 #include "TrackingTask.h"
 #include "MuscleStateTrackingTask.h"